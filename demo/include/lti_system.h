@@ -46,6 +46,7 @@ public:
 	mat get_observation_matrix();               // H
 	mat get_observation_noise_variance();       // R
 	double get_sampling_period();               // dt
+	bool is_stable();                           // spectral_radius(F) < 1
 
 	void set_system(const mat& m1, const mat& m2, const mat& m3,
 			const mat& m4, const mat& m5, double sampling_period);
@@ -89,8 +89,20 @@ void kalman::update( lti_system &sys, const vec& input, const vec& measurement )
 
 	// ========== MEASUREMENT UPDATE =======
 
-	// Kalman gain calculation K = (P*H')*inv(H*P*H' + R)
-	K = P*transpose(H)*inv(H * P * transpose(H) + R);
+	// Kalman gain calculation K = (P*H')*inv(S) with S = H*P*H' + R.
+	// S and P are symmetric, so K' = inv(S)*(H*P) is computed by one
+	// linear solve instead of an explicit inverse. S is a covariance,
+	// so the Cholesky solver is used; LU is the fallback in case
+	// rounding errors have made S indefinite.
+	mat S = H * P * transpose(H) + R, L;
+	if ( chol(S, L) )
+	{
+		K = transpose(chol_solve(L, H * P));
+	}
+	else
+	{
+		K = transpose(solve(S, H * P));
+	}
 
 	// Calculate the filter estimate x(k|k) based on innovation
 	x_hat = x_hat + K*(z - H * x_hat);
@@ -58,6 +58,10 @@ mat lti_system::get_observation_noise_variance() { return R; }
 
 double lti_system::get_sampling_period() { return dt; }
 
+// The discrete system is asymptotically stable if every eigenvalue
+// of F lies inside the unit circle.
+bool lti_system::is_stable() { return spectral_radius(F) < 1; }
+
 
 // The order of how you set your lti system is very important.
 // If you're not sure, write down the equations describing your
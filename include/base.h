@@ -30,6 +30,15 @@
 
 
 #include "mat.h"
+#include "smat.h"
+#include "lu.h"
+#include "chol.h"
+#include "qr.h"
+#include "svd.h"
+#include "eig.h"
+#include "mapped_mat.h"
+#include "serialize.h"
+#include "text_io.h"
 #include "../tests/speed_tests.h"
 
 #endif /* BASE_H_ */
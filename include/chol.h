@@ -0,0 +1,226 @@
+/*============================================================================
+ * Name         : chol.h implements the Cholesky factorization of symmetric
+ *                (Hermitian) positive definite matrices, the SPD solver
+ *                chol_solve(), the rank-1 update/downdate of a Cholesky
+ *                factor and the square-root free LDL^T factorization.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* Covariance matrices are symmetric positive definite (SPD). For them the
+ * Cholesky factor A = L*L' costs half the flops of an LU factorization,
+ * needs no pivoting and reads only the lower triangle of A:
+ *
+ *     mat L = chol(P);                  // P = L*L'
+ *     vec x = chol_solve(L, b);         // P*x = b
+ *     chol_update(L, v);                // L*L' = P + v*v'
+ *     chol_downdate(L, v);              // L*L' = P - v*v'
+ *
+ *     mat L1; vec d;
+ *     ldl(A, L1, d);                    // A = L1*diag(d)*L1', no square roots
+ *
+ * The test "is this matrix SPD?" is the factorization itself: use
+ * chol(A, L), which returns false instead of logging a warning.
+ */
+
+#ifndef CHOL_H_
+#define CHOL_H_
+
+#include "mat.h"
+#include "kernels/chol.h"
+
+namespace algebra {
+
+// It checks that the matrix a can be factorized.
+template <class T>
+inline void chol_check_square(const Mat<T>& a, const char* function)
+{
+	if ( a.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": Not defined for NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	else if ( !is_square(a) )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": NON-SQUARE MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+}
+
+// It computes the lower triangular Cholesky factor l of a (a = l*l').
+// It returns false, without logging anything, if a is not positive
+// definite.
+template <class T>
+inline bool chol(const Mat<T>& a, Mat<T>& l)
+{
+	chol_check_square(a, "chol(const mat& a, mat& l)");
+	l = a;
+	return chol_factor(l.rows(), l.data(), l.ld());
+}
+
+// It returns the lower triangular Cholesky factor of a (a = l*l').
+template <class T>
+inline Mat<T> chol(const Mat<T>& a)
+{
+	Mat<T> l;
+	if ( !chol(a, l) )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in chol(const mat& a): NOT A POSITIVE DEFINITE MATRIX.");
+		return abs(a)*NaN(T);
+	}
+	return l;
+}
+
+// It returns the Cholesky factor of the matrix expression e.
+template <class E>
+inline Mat<typename E::value_type> chol(const MatExpr<E>& e)
+{
+	return chol(eval(e));
+}
+
+// It checks that the factor l and the right-hand side (rows) match.
+template <class T>
+inline void chol_check_solvable(const Mat<T>& l, size_t rows)
+{
+	chol_check_square(l, "chol_solve(const mat& l, ...)");
+	if ( l.rows() != rows )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in chol_solve(const mat& l, ...): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+}
+
+// It solves a*x = b, where l = chol(a).
+template <class T>
+inline Vec<T> chol_solve(const Mat<T>& l, const Vec<T>& b)
+{
+	chol_check_solvable(l, b.size());
+	Vec<T> x = b;
+	chol_solve_factored(l.rows(), 1, l.data(), l.ld(), x.data(), 1);
+	return x;
+}
+
+// It solves a*X = b for every column of b, where l = chol(a).
+template <class T>
+inline Mat<T> chol_solve(const Mat<T>& l, const Mat<T>& b)
+{
+	chol_check_solvable(l, b.rows());
+	Mat<T> x = b;
+	chol_solve_factored(l.rows(), x.cols(), l.data(), l.ld(), x.data(), x.ld());
+	return x;
+}
+
+// It solves e*X = f for the matrix expressions e (the factor) and f.
+template <class E, class F>
+inline Mat<typename E::value_type> chol_solve(const MatExpr<E>& e, const MatExpr<F>& f)
+{
+	return chol_solve(eval(e), eval(f));
+}
+
+// It turns the Cholesky factor l of a into the factor of a + x*x'.
+template <class T>
+inline void chol_update(Mat<T>& l, const Vec<T>& x)
+{
+	chol_check_solvable(l, x.size());
+	Vec<T> work = x;
+	chol_rank1(l.rows(), l.data(), l.ld(), work.data(), +1);
+}
+
+// It turns the Cholesky factor l of a into the factor of a - x*x'. If
+// a - x*x' is not positive definite, l is left unchanged, a warning is
+// logged and false is returned.
+template <class T>
+inline bool chol_downdate(Mat<T>& l, const Vec<T>& x)
+{
+	chol_check_solvable(l, x.size());
+	Vec<T> work = x;
+	Mat<T> l_new = l;
+	if ( !chol_rank1(l_new.rows(), l_new.data(), l_new.ld(), work.data(), -1) )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in chol_downdate(mat& l, const vec& x): THE DOWNDATED MATRIX IS NOT POSITIVE DEFINITE.");
+		return false;
+	}
+	l = std::move(l_new);
+	return true;
+}
+
+// It computes the unit lower triangular l and the diagonal d with
+// a = l*diag(d)*l'. Unlike chol() it also handles symmetric indefinite
+// matrices, as long as no leading minor is singular; in that case a
+// warning is logged and l, d are filled with NaN.
+template <class T>
+inline void ldl(const Mat<T>& a, Mat<T>& l, Vec<T>& d)
+{
+	chol_check_square(a, "ldl(const mat& a, mat& l, vec& d)");
+	l = a;
+	d = Vec<T>(a.rows());
+	if ( !ldl_factor(l.rows(), l.data(), l.ld(), d.data()) )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in ldl(const mat& a, mat& l, vec& d): SINGULAR LEADING MINOR.");
+		l = abs(a)*NaN(T);
+		d = abs(d)*NaN(T);
+	}
+}
+
+// It solves a*x = b, where a = l*diag(d)*l' as computed by ldl().
+template <class T>
+inline Vec<T> ldl_solve(const Mat<T>& l, const Vec<T>& d, const Vec<T>& b)
+{
+	chol_check_solvable(l, b.size());
+	if ( d.size() != l.rows() )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in ldl_solve(const mat& l, const vec& d, const vec& b): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	size_t n = l.rows(), i, p;
+	const T* pl = l.data();
+	Vec<T> x = b;
+	T* px = x.data();
+	for (i = 0; i < n; i++)
+	{
+		for (p = 0; p < i; p++)
+		{
+			px[i] -= pl[i*n + p]*px[p];
+		}
+	}
+	for (i = 0; i < n; i++)
+	{
+		px[i] /= d.data()[i];
+	}
+	for (i = n; i--;)
+	{
+		for (p = i + 1; p < n; p++)
+		{
+			px[i] -= scalar_conj(pl[p*n + i])*px[p];
+		}
+	}
+	return x;
+}
+
+} /* namespace algebra */
+
+#endif /* CHOL_H_ */
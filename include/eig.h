@@ -0,0 +1,281 @@
+/*============================================================================
+ * Name         : eig.h implements the eigendecomposition of symmetric
+ *                (Hermitian) matrices, eig_sym(), and of general real
+ *                matrices, eig(): the eigenvalues and, optionally, the
+ *                eigenvectors with A*X = X*diag(lambda).
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* The eigenvalues of a symmetric matrix are real; they are returned in
+ * ascending order, and the eigenvectors are orthonormal columns:
+ *
+ *     vec lambda = eig_sym(P);          // eigenvalues only, O(4/3 n^3)
+ *     mat X;
+ *     eig_sym(P, lambda, X);            // P = X*diag(lambda)*X'
+ *
+ * Only the lower triangle of the input is read. The matrix is reduced to
+ * tridiagonal form by blocked Householder reflections, the tridiagonal
+ * problem is solved by implicit QL, and the eigenvectors are mapped back
+ * by the compact WY kernel of the QR factorization.
+ *
+ * A general real matrix has complex conjugate pairs of eigenvalues:
+ *
+ *     cvec lambda = eig(F);             // eigenvalues only
+ *     cmat X;
+ *     eig(F, lambda, X);                // F*X = X*diag(lambda), unit columns
+ *     double rho = spectral_radius(F);  // max |lambda|, e.g. rho < 1: stable
+ *
+ * The matrix is balanced, reduced to Hessenberg form and then iterated
+ * by the Francis double-shift QR method. The eigenvalues only variant
+ * transforms the active window only and skips the back substitution.
+ */
+
+#ifndef EIG_H_
+#define EIG_H_
+
+#include "mat.h"
+#include "kernels/eig.h"
+
+namespace algebra {
+
+// It checks the input of eig_sym() and returns the full Hermitian matrix
+// built from the lower triangle of a.
+template <class T>
+inline Mat<T> eig_sym_prepare(const Mat<T>& a, const char* function)
+{
+	if ( a.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": Not defined for NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	else if ( !is_square(a) )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": NON-SQUARE MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	size_t n = a.rows(), i, j;
+	Mat<T> h = a;
+	T* p = h.data();
+	for (i = 0; i < n; i++)
+	{
+		for (j = i + 1; j < n; j++)
+		{
+			p[i*n + j] = scalar_conj(p[j*n + i]);
+		}
+	}
+	return h;
+}
+
+// It computes the eigenvalues (ascending) and the orthonormal eigenvectors
+// (columns of x) of the symmetric (Hermitian) matrix a.
+template <class T>
+inline void eig_sym(const Mat<T>& a, vec& lambda, Mat<T>& x)
+{
+	Mat<T> h = eig_sym_prepare(a, "eig_sym(const mat& a, vec& lambda, mat& x)");
+	size_t n = h.rows(), i, j;
+	std::vector<double> e(n), zt(n*n);
+	std::vector<T> tau(n);
+	lambda = vec(n);
+	eig_tridiagonalize(n, h.data(), h.ld(), lambda.data(), e.data(), tau.data());
+	for (i = 0; i < n; i++)
+	{
+		zt[i*n + i] = 1;
+	}
+	if ( !eig_tridiagonal_ql(n, lambda.data(), e.data(), zt.data()) )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in eig_sym(const mat& a, vec& lambda, mat& x): QL ITERATION DID NOT CONVERGE.");
+	}
+
+	// x = Q*Z, Z = zt'
+	x = Mat<T>(n, n);
+	T* px = x.data();
+	for (i = 0; i < n; i++)
+	{
+		for (j = 0; j < n; j++)
+		{
+			px[i*n + j] = T(zt[j*n + i]);
+		}
+	}
+	if ( n > 1 )
+	{
+		qr_apply_q(n - 1, n - 1, h.data() + n, n, tau.data(), false, px + n, n, n);
+	}
+}
+
+// It returns the eigenvalues of the symmetric (Hermitian) matrix a in
+// ascending order.
+template <class T>
+inline vec eig_sym(const Mat<T>& a)
+{
+	Mat<T> h = eig_sym_prepare(a, "eig_sym(const mat& a)");
+	size_t n = h.rows();
+	std::vector<double> e(n);
+	std::vector<T> tau(n);
+	vec lambda(n);
+	eig_tridiagonalize(n, h.data(), h.ld(), lambda.data(), e.data(), tau.data());
+	if ( !eig_tridiagonal_ql(n, lambda.data(), e.data(), (double*) nullptr) )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in eig_sym(const mat& a): QL ITERATION DID NOT CONVERGE.");
+	}
+	return lambda;
+}
+
+// It returns the eigenvalues of the symmetric matrix expression e.
+template <class E>
+inline vec eig_sym(const MatExpr<E>& e)
+{
+	return eig_sym(eval(e));
+}
+
+// ##################################################################################################
+// ################################# GENERAL (NON-SYMMETRIC) MATRICES ###############################
+
+// It checks the input of eig().
+inline void eig_check(const mat& a, const char* function)
+{
+	if ( a.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": Not defined for NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	else if ( !is_square(a) )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": NON-SQUARE MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+}
+
+// It computes the eigenvalues and the eigenvectors (columns of x, unit
+// 2-norm) of the real square matrix a, in no particular order.
+inline void eig(const mat& a, cvec& lambda, cmat& x)
+{
+	eig_check(a, "eig(const mat& a, cvec& lambda, cmat& x)");
+	size_t n = a.rows(), i, j;
+	mat h = a, v(n, n);
+	std::vector<double> scale(n), wr(n), wi(n);
+	eig_balance(n, h.data(), n, scale.data());
+	eig_hessenberg(n, h.data(), n, v.data(), n);
+	lambda = cvec(n);
+	x = cmat(n, n);
+	if ( !eig_hessenberg_qr(n, h.data(), n, wr.data(), wi.data(), v.data(), n) )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in eig(const mat& a, cvec& lambda, cmat& x): QR ITERATION DID NOT CONVERGE.");
+		lambda = abs(lambda)*NaN(std::complex<double>);
+		x = abs(x)*NaN(std::complex<double>);
+		return;
+	}
+
+	// Undo the balancing (A = D*B*inv(D)), assemble the complex pairs and
+	// normalize every column.
+	const double* pv = v.data();
+	std::complex<double>* px = x.data();
+	for (j = 0; j < n; j++)
+	{
+		lambda.data()[j] = std::complex<double>(wr[j], wi[j]);
+		if ( wi[j] == 0 )
+		{
+			for (i = 0; i < n; i++)
+			{
+				px[i*n + j] = scale[i]*pv[i*n + j];
+			}
+		}
+		else if ( wi[j] > 0 && j + 1 < n )
+		{
+			for (i = 0; i < n; i++)
+			{
+				const std::complex<double> z(scale[i]*pv[i*n + j], scale[i]*pv[i*n + j + 1]);
+				px[i*n + j] = z;
+				px[i*n + j + 1] = std::conj(z);
+			}
+		}
+	}
+	for (j = 0; j < n; j++)
+	{
+		double norm2 = 0;
+		for (i = 0; i < n; i++)
+		{
+			norm2 += std::norm(px[i*n + j]);
+		}
+		if ( norm2 > 0 )
+		{
+			const double inv_norm = 1/std::sqrt(norm2);
+			for (i = 0; i < n; i++)
+			{
+				px[i*n + j] *= inv_norm;
+			}
+		}
+	}
+}
+
+// It returns the eigenvalues of the real square matrix a.
+inline cvec eig(const mat& a)
+{
+	eig_check(a, "eig(const mat& a)");
+	size_t n = a.rows(), i;
+	mat h = a;
+	std::vector<double> scale(n), wr(n), wi(n);
+	eig_balance(n, h.data(), n, scale.data());
+	eig_hessenberg(n, h.data(), n, (double*) nullptr, n);
+	cvec lambda(n);
+	if ( !eig_hessenberg_qr(n, h.data(), n, wr.data(), wi.data(), (double*) nullptr, n) )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in eig(const mat& a): QR ITERATION DID NOT CONVERGE.");
+		return abs(lambda)*NaN(std::complex<double>);
+	}
+	for (i = 0; i < n; i++)
+	{
+		lambda.data()[i] = std::complex<double>(wr[i], wi[i]);
+	}
+	return lambda;
+}
+
+// It returns the eigenvalues of the matrix expression e.
+template <class E>
+inline cvec eig(const MatExpr<E>& e)
+{
+	return eig(mat(e));
+}
+
+// It returns the spectral radius max|lambda| of the real square matrix a.
+// A discrete-time system x[k+1] = F*x[k] is asymptotically stable if and
+// only if spectral_radius(F) < 1.
+inline double spectral_radius(const mat& a)
+{
+	cvec lambda = eig(a);
+	double rho = 0;
+	size_t i;
+	for (i = 0; i < lambda.size(); i++)
+	{
+		rho = std::max(rho, std::abs(lambda.data()[i]));
+	}
+	return rho;
+}
+
+} /* namespace algebra */
+
+#endif /* EIG_H_ */
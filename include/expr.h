@@ -0,0 +1,341 @@
+/*============================================================================
+ * Name         : expr.h implements the expression templates behind the
+ *                arithmetic operators of Vec and Mat. Element-wise chains
+ *                such as a + b - c*0.5 are not evaluated operator by
+ *                operator; they build a lightweight expression object
+ *                which is evaluated in a single loop when it is assigned
+ *                to a Vec or a Mat.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* ATTENTION: an expression only keeps references to the Vec and Mat objects
+ * it was built from. Assign it to a Vec or a Mat before these go out of scope,
+ * i.e. do not store it with 'auto':
+ *
+ *     mat c = a + b;        // fine: evaluated here
+ *     auto e = f(x) + b;    // dangling: the result of f(x) dies at the ';'
+ */
+
+#ifndef EXPR_H_
+#define EXPR_H_
+
+#include <stddef.h>     // size_t
+
+#include "kernels/simd.h"
+#include "kernels/thread_pool.h"
+#include "kernels/transpose.h"
+
+namespace algebra {
+
+// Declaration of Vec
+template<class T> class Vec;
+// Declaration of Mat
+template<class T> class Mat;
+
+// ##################################################################################################
+// ##################################### ELEMENT-WISE OPERATIONS ####################################
+
+struct add_op { template <class T> static T apply(const T& a, const T& b) { return a + b; } };
+struct sub_op { template <class T> static T apply(const T& a, const T& b) { return a - b; } };
+struct mul_op { template <class T> static T apply(const T& a, const T& b) { return a * b; } };
+struct div_op { template <class T> static T apply(const T& a, const T& b) { return a / b; } };
+
+
+// ##################################################################################################
+// ####################################### EXPRESSION BASES #########################################
+
+// Every vector expression (including Vec itself) derives from VecExpr
+// and provides: value_type, size(), coeff(i) and
+//  - aliases(p):    evaluating coeff(i) may read the buffer p at a
+//                   position other than i, e.g. through a strided view.
+template <class E>
+class VecExpr {
+public:
+	const E& derived() const { return static_cast<const E&>(*this); }
+};
+
+// Every matrix expression (including Mat itself) derives from MatExpr
+// and provides: value_type, rows(), cols(), size(), coeff(i,j) and
+//  - aliases(p):    evaluating coeff(i,j) may read the buffer p at a
+//                   position other than (i,j), e.g. through a transpose.
+//  - depends_on(p): the buffer p is read at all.
+template <class E>
+class MatExpr {
+public:
+	const E& derived() const { return static_cast<const E&>(*this); }
+};
+
+// Containers are stored by reference inside an expression,
+// intermediate expressions by value (they are tiny).
+template <class E> struct expr_ref { typedef const E type; };
+template <class T> struct expr_ref< Vec<T> > { typedef const Vec<T>& type; };
+template <class T> struct expr_ref< Mat<T> > { typedef const Mat<T>& type; };
+
+
+// ##################################################################################################
+// ####################################### VECTOR EXPRESSIONS #######################################
+
+// Element-wise l(i) op r(i)
+template <class L, class R, class Op>
+class VecBinaryExpr : public VecExpr< VecBinaryExpr<L, R, Op> > {
+public:
+	typedef typename L::value_type value_type;
+
+	VecBinaryExpr(const L& l, const R& r) : l_(l), r_(r) {}
+
+	size_t size() const noexcept { return l_.size(); }
+	value_type coeff(size_t i) const { return Op::apply(l_.coeff(i), r_.coeff(i)); }
+
+	bool aliases(const value_type* p) const { return l_.aliases(p) || r_.aliases(p); }
+
+	const L& lhs() const noexcept { return l_; }
+	const R& rhs() const noexcept { return r_; }
+
+private:
+	typename expr_ref<L>::type l_;
+	typename expr_ref<R>::type r_;
+};
+
+// Element-wise e(i) op t
+template <class E, class Op>
+class VecScalarExpr : public VecExpr< VecScalarExpr<E, Op> > {
+public:
+	typedef typename E::value_type value_type;
+
+	VecScalarExpr(const E& e, const value_type& t) : e_(e), t_(t) {}
+
+	size_t size() const noexcept { return e_.size(); }
+	value_type coeff(size_t i) const { return Op::apply(e_.coeff(i), t_); }
+
+	bool aliases(const value_type* p) const { return e_.aliases(p); }
+
+	const E& nested() const noexcept { return e_; }
+	const value_type& scalar() const noexcept { return t_; }
+
+private:
+	typename expr_ref<E>::type e_;
+	value_type t_;
+};
+
+
+// ##################################################################################################
+// ####################################### MATRIX EXPRESSIONS #######################################
+
+// Element-wise l(i,j) op r(i,j)
+template <class L, class R, class Op>
+class MatBinaryExpr : public MatExpr< MatBinaryExpr<L, R, Op> > {
+public:
+	typedef typename L::value_type value_type;
+
+	MatBinaryExpr(const L& l, const R& r) : l_(l), r_(r) {}
+
+	size_t rows() const noexcept { return l_.rows(); }
+	size_t cols() const noexcept { return l_.cols(); }
+	size_t size() const noexcept { return l_.size(); }
+	value_type coeff(size_t i, size_t j) const { return Op::apply(l_.coeff(i, j), r_.coeff(i, j)); }
+
+	bool aliases(const value_type* p) const { return l_.aliases(p) || r_.aliases(p); }
+	bool depends_on(const value_type* p) const { return l_.depends_on(p) || r_.depends_on(p); }
+
+	const L& lhs() const noexcept { return l_; }
+	const R& rhs() const noexcept { return r_; }
+
+private:
+	typename expr_ref<L>::type l_;
+	typename expr_ref<R>::type r_;
+};
+
+// Element-wise e(i,j) op t
+template <class E, class Op>
+class MatScalarExpr : public MatExpr< MatScalarExpr<E, Op> > {
+public:
+	typedef typename E::value_type value_type;
+
+	MatScalarExpr(const E& e, const value_type& t) : e_(e), t_(t) {}
+
+	size_t rows() const noexcept { return e_.rows(); }
+	size_t cols() const noexcept { return e_.cols(); }
+	size_t size() const noexcept { return e_.size(); }
+	value_type coeff(size_t i, size_t j) const { return Op::apply(e_.coeff(i, j), t_); }
+
+	bool aliases(const value_type* p) const { return e_.aliases(p); }
+	bool depends_on(const value_type* p) const { return e_.depends_on(p); }
+
+	const E& nested() const noexcept { return e_; }
+	const value_type& scalar() const noexcept { return t_; }
+
+private:
+	typename expr_ref<E>::type e_;
+	value_type t_;
+};
+
+// Transposed view e(j,i). It is never materialized on its own: it is either
+// evaluated element-wise inside a larger expression, or handed to the product
+// kernel as a matrix with swapped strides.
+template <class E>
+class MatTransposeExpr : public MatExpr< MatTransposeExpr<E> > {
+public:
+	typedef typename E::value_type value_type;
+
+	explicit MatTransposeExpr(const E& e) : e_(e) {}
+
+	size_t rows() const noexcept { return e_.cols(); }
+	size_t cols() const noexcept { return e_.rows(); }
+	size_t size() const noexcept { return e_.size(); }
+	value_type coeff(size_t i, size_t j) const { return e_.coeff(j, i); }
+
+	// Element (i,j) reads element (j,i) of its operand.
+	bool aliases(const value_type* p) const { return e_.depends_on(p); }
+	bool depends_on(const value_type* p) const { return e_.depends_on(p); }
+
+	const E& nested() const noexcept { return e_; }
+
+private:
+	typename expr_ref<E>::type e_;
+};
+
+
+// ##################################################################################################
+// ########################################### EVALUATION ###########################################
+// eval_into(dst, e) writes the coefficients of e to the buffer dst (row-major
+// for matrices). The most common forms, a +/- b and a*t on containers, are
+// handed to the vectorized kernels of kernels/simd.h; everything else is
+// evaluated coefficient by coefficient. Large expressions are split into
+// chunks which are evaluated on the thread pool.
+
+template <class E>
+inline void eval_into(typename E::value_type* dst, const VecExpr<E>& e)
+{
+	const E& expr = e.derived();
+	parallel_for(0, expr.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		size_t i;
+		for (i = lo; i < hi; i++)
+		{
+			dst[i] = expr.coeff(i);
+		}
+	});
+}
+
+template <class T>
+inline void eval_into(T* dst, const VecBinaryExpr<Vec<T>, Vec<T>, add_op>& e)
+{
+	const T* a = e.lhs().data();
+	const T* b = e.rhs().data();
+	parallel_for(0, e.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		simd_add(hi - lo, a + lo, b + lo, dst + lo);
+	});
+}
+
+template <class T>
+inline void eval_into(T* dst, const VecBinaryExpr<Vec<T>, Vec<T>, sub_op>& e)
+{
+	const T* a = e.lhs().data();
+	const T* b = e.rhs().data();
+	parallel_for(0, e.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		simd_sub(hi - lo, a + lo, b + lo, dst + lo);
+	});
+}
+
+template <class T>
+inline void eval_into(T* dst, const VecScalarExpr<Vec<T>, mul_op>& e)
+{
+	const T* a = e.nested().data();
+	const T t = e.scalar();
+	parallel_for(0, e.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		simd_scale(hi - lo, a + lo, t, dst + lo);
+	});
+}
+
+template <class E>
+inline void eval_into(typename E::value_type* dst, const MatExpr<E>& e)
+{
+	const E& expr = e.derived();
+	size_t cols = expr.cols();
+	if (cols == 0)
+	{
+		return;
+	}
+	parallel_for(0, expr.rows(), PARALLEL_GRAIN/cols, [&](size_t lo, size_t hi)
+	{
+		size_t i, j;
+		for (i = lo; i < hi; i++)
+		{
+			typename E::value_type* row = dst + i*cols;
+			for (j = 0; j < cols; j++)
+			{
+				row[j] = expr.coeff(i, j);
+			}
+		}
+	});
+}
+
+template <class T>
+inline void eval_into(T* dst, const MatBinaryExpr<Mat<T>, Mat<T>, add_op>& e)
+{
+	const T* a = e.lhs().data();
+	const T* b = e.rhs().data();
+	parallel_for(0, e.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		simd_add(hi - lo, a + lo, b + lo, dst + lo);
+	});
+}
+
+template <class T>
+inline void eval_into(T* dst, const MatBinaryExpr<Mat<T>, Mat<T>, sub_op>& e)
+{
+	const T* a = e.lhs().data();
+	const T* b = e.rhs().data();
+	parallel_for(0, e.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		simd_sub(hi - lo, a + lo, b + lo, dst + lo);
+	});
+}
+
+template <class T>
+inline void eval_into(T* dst, const MatScalarExpr<Mat<T>, mul_op>& e)
+{
+	const T* a = e.nested().data();
+	const T t = e.scalar();
+	parallel_for(0, e.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		simd_scale(hi - lo, a + lo, t, dst + lo);
+	});
+}
+
+// The transpose of a matrix is written tile by tile, see kernels/transpose.h;
+// read element by element it would miss the cache at every element.
+template <class T>
+inline void eval_into(T* dst, const MatTransposeExpr< Mat<T> >& e)
+{
+	const Mat<T>& m = e.nested();
+	transpose_kernel(m.rows(), m.cols(), m.data(), m.ld(), dst, m.rows());
+}
+
+} /* namespace algebra */
+
+#endif /* EXPR_H_ */
@@ -0,0 +1,312 @@
+/*============================================================================
+ * Name         : chol.h implements the Cholesky factorization A = L*L^H, the
+ *                LDL^H factorization and the rank-1 update/downdate of a
+ *                Cholesky factor, on raw row-major buffers. They are the
+ *                kernels behind chol(), chol_solve(), chol_update(),
+ *                chol_downdate() and ldl().
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* Only the lower triangle of the input is read: the factorizations assume
+ * a symmetric (Hermitian for complex values) matrix and never look at its
+ * upper triangle. For complex values L^H is the conjugate transpose.
+ */
+
+#ifndef CHOL_KERNEL_H_
+#define CHOL_KERNEL_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <complex>
+#include <cmath>        // std::sqrt
+#include <algorithm>    // std::min, std::fill
+
+#include "../utilities/workspace.h"
+#include "gemm.h"
+#include "scalar.h"
+#include "thread_pool.h"
+
+// Number of columns factorized per diagonal block.
+#define CHOL_BLOCK_SIZE 64
+
+namespace algebra {
+
+// It factorizes the nb x nb diagonal block at a (left-looking). It returns
+// false as soon as a pivot is not positive.
+template <class T>
+inline bool chol_diagonal_block(size_t nb, T* a, size_t lda)
+{
+	size_t i, j, p;
+	for (j = 0; j < nb; j++)
+	{
+		T* row_j = a + j*lda;
+		double d = scalar_real(row_j[j]);
+		for (p = 0; p < j; p++)
+		{
+			d -= scalar_abs2(row_j[p]);
+		}
+		if (!(d > 0))
+		{
+			return false;
+		}
+		const double l_jj = std::sqrt(d);
+		row_j[j] = T(l_jj);
+		for (i = j + 1; i < nb; i++)
+		{
+			T* row_i = a + i*lda;
+			T s = row_i[j];
+			for (p = 0; p < j; p++)
+			{
+				s -= row_i[p]*scalar_conj(row_j[p]);
+			}
+			row_i[j] = s/T(l_jj);
+		}
+	}
+	return true;
+}
+
+// It computes the lower triangular L with A = L*L^H, in place, for the
+// n x n row-major matrix a. The strict upper triangle is set to zero.
+// It returns false if A is not positive definite; a is then left partly
+// overwritten.
+//
+// The matrix is processed in diagonal blocks of CHOL_BLOCK_SIZE columns:
+//
+//   [ A11  .  ]    1. A11 = L11*L11^H            (unblocked)
+//   [ A21 A22 ]    2. L21 = A21*inv(L11^H)       (triangular solve)
+//                  3. A22 = A22 - L21*L21^H      (gemm, lower half only)
+//
+// Only the blocks on and below the diagonal of A22 are updated, which
+// halves the work of step 3 compared with an LU factorization.
+template <class T>
+inline bool chol_factor(size_t n, T* a, size_t lda)
+{
+	const size_t NB = CHOL_BLOCK_SIZE;
+	std::vector<T, workspace_allocator<T> > w;
+	size_t i, k, p;
+	for (k = 0; k < n; k += NB)
+	{
+		const size_t nb = std::min(NB, n - k);
+		T* a11 = a + k*lda + k;
+		if (!chol_diagonal_block(nb, a11, lda))
+		{
+			return false;
+		}
+
+		const size_t rest = n - k - nb;
+		if (rest == 0)
+		{
+			break;
+		}
+
+		// Every row of L21 is solved independently.
+		T* a21 = a + (k + nb)*lda + k;
+		parallel_for(0, rest, PARALLEL_GRAIN/(nb*nb) + 1, [&](size_t lo, size_t hi)
+		{
+			size_t r, j, q;
+			for (r = lo; r < hi; r++)
+			{
+				T* row = a21 + r*lda;
+				for (j = 0; j < nb; j++)
+				{
+					const T* l_j = a11 + j*lda;
+					T s = row[j];
+					for (q = 0; q < j; q++)
+					{
+						s -= row[q]*scalar_conj(l_j[q]);
+					}
+					row[j] = s/l_j[j];
+				}
+			}
+		});
+
+		// w holds -L21^H, read by gemm with swapped strides.
+		w.resize(rest*nb);
+		for (i = 0; i < rest; i++)
+		{
+			const T* row = a21 + i*lda;
+			for (p = 0; p < nb; p++)
+			{
+				w[i*nb + p] = -scalar_conj(row[p]);
+			}
+		}
+		T* a22 = a + (k + nb)*lda + k + nb;
+		const size_t rows = NB;
+		const size_t blocks = (rest + rows - 1)/rows;
+		parallel_for(0, blocks, 1, [&](size_t lo, size_t hi)
+		{
+			size_t b;
+			for (b = lo; b < hi; b++)
+			{
+				size_t r0 = b*rows, r1 = std::min(r0 + rows, rest);
+				gemm(r1 - r0, r1, nb,
+						a21 + r0*lda, lda, (size_t) 1,
+						w.data(), (size_t) 1, nb,
+						a22 + r0*lda, lda);
+			}
+		});
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		std::fill(a + i*lda + i + 1, a + i*lda + n, T(0));
+	}
+	return true;
+}
+
+// It solves L*L^H*X = B in place, where L is the n x n lower triangular
+// factor l and B is n x nrhs (leading dimension ldb). The columns of B
+// are independent, so they are solved in bands on the thread pool.
+template <class T>
+inline void chol_solve_factored(size_t n, size_t nrhs, const T* l, size_t lda, T* b, size_t ldb)
+{
+	parallel_for(0, nrhs, PARALLEL_GRAIN/(n*n + 1) + 1, [&](size_t lo, size_t hi)
+	{
+		size_t i, p, c;
+
+		// L*Y = B
+		for (i = 0; i < n; i++)
+		{
+			T* b_i = b + i*ldb;
+			const T* l_i = l + i*lda;
+			for (p = 0; p < i; p++)
+			{
+				const T l_ip = l_i[p];
+				const T* b_p = b + p*ldb;
+				for (c = lo; c < hi; c++)
+				{
+					b_i[c] -= l_ip*b_p[c];
+				}
+			}
+			for (c = lo; c < hi; c++)
+			{
+				b_i[c] /= l_i[i];
+			}
+		}
+
+		// L^H*X = Y
+		for (i = n; i--;)
+		{
+			T* b_i = b + i*ldb;
+			for (p = i + 1; p < n; p++)
+			{
+				const T l_pi = scalar_conj(l[p*lda + i]);
+				const T* b_p = b + p*ldb;
+				for (c = lo; c < hi; c++)
+				{
+					b_i[c] -= l_pi*b_p[c];
+				}
+			}
+			const T l_ii = l[i*lda + i];
+			for (c = lo; c < hi; c++)
+			{
+				b_i[c] /= l_ii;
+			}
+		}
+	});
+}
+
+// It turns the Cholesky factor l of A into the factor of A + sign*x*x^H
+// (sign = +1 update, -1 downdate) by a sequence of rotations. x is used
+// as workspace. It returns false if a downdate would make the matrix
+// indefinite; l is then left partly overwritten.
+template <class T>
+inline bool chol_rank1(size_t n, T* l, size_t lda, T* x, int sign)
+{
+	size_t i, k;
+	for (k = 0; k < n; k++)
+	{
+		const double l_kk = scalar_real(l[k*lda + k]);
+		const double r2 = l_kk*l_kk + sign*scalar_abs2(x[k]);
+		if (!(r2 > 0))
+		{
+			return false;
+		}
+		const double r = std::sqrt(r2);
+		const T c = T(r/l_kk);
+		const T s = x[k]/T(l_kk);
+		l[k*lda + k] = T(r);
+		for (i = k + 1; i < n; i++)
+		{
+			T& l_ik = l[i*lda + k];
+			l_ik = (l_ik + T(sign)*scalar_conj(s)*x[i])/c;
+			x[i] = c*x[i] - s*l_ik;
+		}
+	}
+	return true;
+}
+
+// It computes the unit lower triangular L and the diagonal d with
+// A = L*diag(d)*L^H, in place, without square roots: on return a holds L
+// (with its unit diagonal) and zeros above it. It returns false if a pivot
+// d(j) is zero.
+template <class T>
+inline bool ldl_factor(size_t n, T* a, size_t lda, T* d)
+{
+	std::vector<T> v(n);
+	size_t i, j, p;
+	for (j = 0; j < n; j++)
+	{
+		T* row_j = a + j*lda;
+		// v(p) = L(j,p)*d(p)
+		T d_j = row_j[j];
+		for (p = 0; p < j; p++)
+		{
+			v[p] = row_j[p]*d[p];
+			d_j -= v[p]*scalar_conj(row_j[p]);
+		}
+		d_j = T(scalar_real(d_j));
+		if (d_j == T(0))
+		{
+			return false;
+		}
+		d[j] = d_j;
+		row_j[j] = T(1);
+
+		// The rows below j are updated independently.
+		parallel_for(j + 1, n, PARALLEL_GRAIN/(j + 1), [&](size_t lo, size_t hi)
+		{
+			size_t r, q;
+			for (r = lo; r < hi; r++)
+			{
+				T* row_r = a + r*lda;
+				T s = row_r[j];
+				for (q = 0; q < j; q++)
+				{
+					s -= row_r[q]*scalar_conj(v[q]);
+				}
+				row_r[j] = s/d_j;
+			}
+		});
+	}
+	for (i = 0; i < n; i++)
+	{
+		std::fill(a + i*lda + i + 1, a + i*lda + n, T(0));
+	}
+	return true;
+}
+
+} /* namespace algebra */
+
+#endif /* CHOL_KERNEL_H_ */
@@ -0,0 +1,971 @@
+/*============================================================================
+ * Name         : eig.h implements the reduction of a Hermitian matrix to
+ *                real symmetric tridiagonal form and the implicit QL
+ *                iteration on the tridiagonal matrix, and the Hessenberg
+ *                reduction and Francis QR iteration of general matrices,
+ *                on raw row-major buffers. They are the kernels behind
+ *                eig_sym() and eig().
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* A = Q*T*Q^H, with Q = H(0)*H(1)*...*H(n-2) and H(j) the reflector that
+ * zeroes A(j+2:n, j). The reflectors are stored below the subdiagonal, so
+ * that A(1:n, 0:n-1) has the layout of a QR factorization and Q is applied
+ * by qr_apply_q(). Since the reflectors make the subdiagonal real, T is
+ * real even for a complex Hermitian A.
+ *
+ * The reduction is blocked as in LAPACK (sytrd/latrd): the reflectors of
+ * a panel of EIG_BLOCK_SIZE columns are accumulated in V and W, and the
+ * trailing matrix is updated once per panel, A = A - V*W^H - W*V^H, by a
+ * gemm call. Half of the flops are then spent in gemm; the other half are
+ * the matrix-vector products that build W.
+ */
+
+#ifndef EIG_KERNEL_H_
+#define EIG_KERNEL_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <complex>
+#include <cmath>        // std::sqrt, std::abs, std::hypot
+#include <algorithm>    // std::min, std::max
+#include <limits>
+
+#include "../utilities/workspace.h"
+#include "gemm.h"
+#include "qr.h"
+#include "scalar.h"
+#include "thread_pool.h"
+
+// Number of columns reduced per panel.
+#define EIG_BLOCK_SIZE 32
+// Upper bound of the QL iterations per eigenvalue.
+#define EIG_MAX_ITERATIONS 60
+
+namespace algebra {
+
+// It reduces the n x n Hermitian matrix a (both triangles stored) to the
+// tridiagonal matrix with diagonal d and subdiagonal e (n - 1 elements).
+// The reflectors are left below the subdiagonal of a and their scalar
+// factors in tau (n - 1 elements).
+template <class T>
+inline void eig_tridiagonalize(size_t n, T* a, size_t lda, double* d, double* e, T* tau)
+{
+	const size_t NB = EIG_BLOCK_SIZE;
+	std::vector<T, workspace_allocator<T> > v, w, left, right;
+	std::vector<T> x, y, z1, z2;
+	size_t j0, c, p, row;
+	for (j0 = 0; j0 + 1 < n; j0 += NB)
+	{
+		const size_t nb = std::min(NB, n - 1 - j0);
+		const size_t r = n - j0;
+		v.assign(r*nb, T(0));
+		w.assign(r*nb, T(0));
+		for (c = 0; c < nb; c++)
+		{
+			const size_t i = j0 + c;
+
+			// a(i:n, i) -= V*W(i,:)^H + W*V(i,:)^H, the pending updates.
+			for (row = i; row < n; row++)
+			{
+				const T* v_row = v.data() + (row - j0)*nb;
+				const T* w_row = w.data() + (row - j0)*nb;
+				const T* v_i = v.data() + (i - j0)*nb;
+				const T* w_i = w.data() + (i - j0)*nb;
+				T s = T(0);
+				for (p = 0; p < c; p++)
+				{
+					s += v_row[p]*scalar_conj(w_i[p]) + w_row[p]*scalar_conj(v_i[p]);
+				}
+				a[row*lda + i] -= s;
+			}
+			d[i] = scalar_real(a[i*lda + i]);
+
+			// H(i) zeroes a(i+2:n, i); beta is real.
+			T& alpha = a[(i + 1)*lda + i];
+			const T tau_i = qr_householder(n - i - 2, alpha, &a[(i + 2)*lda + i], lda);
+			tau[i] = tau_i;
+			e[i] = scalar_real(alpha);
+			v[(i + 1 - j0)*nb + c] = T(1);
+			for (row = i + 2; row < n; row++)
+			{
+				v[(row - j0)*nb + c] = a[row*lda + i];
+			}
+
+			// y = (A - V*W^H - W*V^H)*v over rows i+1:n; x is v contiguous.
+			const size_t m = n - i - 1;
+			y.assign(m, T(0));
+			x.resize(m);
+			for (row = 0; row < m; row++)
+			{
+				x[row] = v[(i + 1 + row - j0)*nb + c];
+			}
+			parallel_for(0, m, PARALLEL_GRAIN/(m + 1) + 1, [&](size_t lo, size_t hi)
+			{
+				size_t k, q;
+				for (k = lo; k < hi; k++)
+				{
+					const T* a_row = a + (i + 1 + k)*lda + i + 1;
+					T s = T(0);
+					for (q = 0; q < m; q++)
+					{
+						s += a_row[q]*x[q];
+					}
+					y[k] = s;
+				}
+			});
+			// z1 = W^H*v, z2 = V^H*v
+			z1.assign(c, T(0));
+			z2.assign(c, T(0));
+			for (row = i + 1; row < n; row++)
+			{
+				const T v_r = v[(row - j0)*nb + c];
+				for (p = 0; p < c; p++)
+				{
+					z1[p] += scalar_conj(w[(row - j0)*nb + p])*v_r;
+					z2[p] += scalar_conj(v[(row - j0)*nb + p])*v_r;
+				}
+			}
+			T dot = T(0);
+			for (row = i + 1; row < n; row++)
+			{
+				const T* v_row = v.data() + (row - j0)*nb;
+				const T* w_row = w.data() + (row - j0)*nb;
+				T s = y[row - i - 1];
+				for (p = 0; p < c; p++)
+				{
+					s -= v_row[p]*z1[p] + w_row[p]*z2[p];
+				}
+				// w = tau*y, then w += -tau/2*(w^H*v)*v
+				s *= tau_i;
+				w[(row - j0)*nb + c] = s;
+				dot += scalar_conj(s)*v_row[c];
+			}
+			const T shift = T(-0.5)*tau_i*dot;
+			for (row = i + 1; row < n; row++)
+			{
+				w[(row - j0)*nb + c] += shift*v[(row - j0)*nb + c];
+			}
+		}
+
+		// A22 = A22 - [V W]*[W V]^H, both triangles.
+		const size_t k0 = j0 + nb;
+		const size_t r2 = n - k0;
+		left.resize(r2*2*nb);
+		right.resize(r2*2*nb);
+		for (row = 0; row < r2; row++)
+		{
+			const T* v_row = v.data() + (row + nb)*nb;
+			const T* w_row = w.data() + (row + nb)*nb;
+			for (p = 0; p < nb; p++)
+			{
+				left[row*2*nb + p] = v_row[p];
+				left[row*2*nb + nb + p] = w_row[p];
+				right[row*2*nb + p] = -scalar_conj(w_row[p]);
+				right[row*2*nb + nb + p] = -scalar_conj(v_row[p]);
+			}
+		}
+		gemm(r2, r2, 2*nb, left.data(), 2*nb, (size_t) 1,
+				right.data(), (size_t) 1, 2*nb, a + k0*lda + k0, lda);
+	}
+	d[n - 1] = scalar_real(a[(n - 1)*lda + n - 1]);
+}
+
+// It computes the eigenvalues d of the symmetric tridiagonal matrix with
+// diagonal d and subdiagonal e (both overwritten; e has n elements, the
+// last one ignored) by the implicit QL method, in ascending order. When zt
+// is not null, the rotations are applied to the rows of the n x n matrix
+// zt, so that its row j ends up holding the eigenvector of d(j) if zt
+// starts as the identity. It returns false if an eigenvalue did not
+// converge within EIG_MAX_ITERATIONS.
+inline bool eig_tridiagonal_ql(size_t n, double* d, double* e, double* zt)
+{
+	const double eps = std::numeric_limits<double>::epsilon();
+	std::vector<double> rot_c(n), rot_s(n);
+	double f = 0, tst1 = 0;
+	bool converged = true;
+	size_t l, m, i, k, iter;
+	if (n == 0)
+	{
+		return true;
+	}
+	e[n - 1] = 0;
+	for (l = 0; l < n; l++)
+	{
+		// Find a small subdiagonal element.
+		tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+		m = l;
+		while (m < n - 1 && std::abs(e[m]) > eps*tst1)
+		{
+			m++;
+		}
+
+		for (iter = 0; m > l && std::abs(e[l]) > eps*tst1; iter++)
+		{
+			if (iter == EIG_MAX_ITERATIONS)
+			{
+				converged = false;
+				break;
+			}
+			// Implicit shift.
+			double g = d[l];
+			double p = (d[l + 1] - g)/(2*e[l]);
+			double r = std::hypot(p, 1.0);
+			if (p < 0)
+			{
+				r = -r;
+			}
+			d[l] = e[l]/(p + r);
+			d[l + 1] = e[l]*(p + r);
+			const double dl1 = d[l + 1];
+			double h = g - d[l];
+			for (i = l + 2; i < n; i++)
+			{
+				d[i] -= h;
+			}
+			f += h;
+
+			// Implicit QL transformation.
+			p = d[m];
+			double c = 1, c2 = 1, c3 = 1, s = 0, s2 = 0;
+			const double el1 = e[l + 1];
+			for (i = m; i-- > l;)
+			{
+				c3 = c2;
+				c2 = c;
+				s2 = s;
+				g = c*e[i];
+				h = c*p;
+				r = std::hypot(p, e[i]);
+				e[i + 1] = s*r;
+				s = e[i]/r;
+				c = p/r;
+				p = c*d[i] - s*g;
+				d[i + 1] = h + s*(c*g + s*d[i]);
+				rot_c[i] = c;
+				rot_s[i] = s;
+			}
+			p = -s*s2*c3*el1*e[l]/dl1;
+			e[l] = s*p;
+			d[l] = c*p;
+
+			// The rotations of the sweep are applied to columns lo..hi of
+			// zt in parallel.
+			if (zt)
+			{
+				parallel_for(0, n, PARALLEL_GRAIN/(m - l + 1) + 1, [&](size_t lo, size_t hi)
+				{
+					size_t q, t;
+					for (q = m; q-- > l;)
+					{
+						double* z_i = zt + q*n;
+						double* z_i1 = zt + (q + 1)*n;
+						const double cq = rot_c[q], sq = rot_s[q];
+						for (t = lo; t < hi; t++)
+						{
+							const double z = z_i1[t];
+							z_i1[t] = sq*z_i[t] + cq*z;
+							z_i[t] = cq*z_i[t] - sq*z;
+						}
+					}
+				});
+			}
+		}
+		d[l] += f;
+		e[l] = 0;
+	}
+
+	// Selection sort, ascending: at most n - 1 row swaps of zt.
+	for (i = 0; i + 1 < n; i++)
+	{
+		k = i;
+		for (m = i + 1; m < n; m++)
+		{
+			if (d[m] < d[k])
+			{
+				k = m;
+			}
+		}
+		if (k != i)
+		{
+			std::swap(d[i], d[k]);
+			if (zt)
+			{
+				std::swap_ranges(zt + i*n, zt + (i + 1)*n, zt + k*n);
+			}
+		}
+	}
+	return converged;
+}
+
+// ##################################################################################################
+// ################################# GENERAL (NON-SYMMETRIC) MATRICES ###############################
+
+// It balances the n x n matrix a in place by a diagonal similarity
+// D^-1*A*D, with powers of 2 in scale (n elements), so that the rows and
+// columns have comparable norms (EISPACK balanc, scaling only).
+inline void eig_balance(size_t n, double* a, size_t lda, double* scale)
+{
+	size_t i, j;
+	bool done = false;
+	std::fill(scale, scale + n, 1.0);
+	while (!done)
+	{
+		done = true;
+		for (i = 0; i < n; i++)
+		{
+			double c = 0, r = 0;
+			for (j = 0; j < n; j++)
+			{
+				if (j != i)
+				{
+					c += std::abs(a[j*lda + i]);
+					r += std::abs(a[i*lda + j]);
+				}
+			}
+			if (c == 0 || r == 0)
+			{
+				continue;
+			}
+			const double s = c + r;
+			double f = 1, g = r/2;
+			while (c < g)
+			{
+				f *= 2;
+				c *= 4;
+			}
+			g = r*2;
+			while (c > g)
+			{
+				f /= 2;
+				c /= 4;
+			}
+			if ((c + r)/f < 0.95*s)
+			{
+				done = false;
+				scale[i] *= f;
+				for (j = 0; j < n; j++)
+				{
+					a[i*lda + j] /= f;
+					a[j*lda + i] *= f;
+				}
+			}
+		}
+	}
+}
+
+// It reduces the n x n matrix h to upper Hessenberg form by Householder
+// similarity transformations (EISPACK orthes) and, when v is not null,
+// accumulates them in v: A = V*H*V'. The elements below the subdiagonal
+// are set to zero.
+inline void eig_hessenberg(size_t n, double* h, size_t ldh, double* v, size_t ldv)
+{
+	std::vector<double> ort(n), f(n);
+	size_t m, i, j;
+	for (m = 1; m + 1 < n; m++)
+	{
+		double scale = 0;
+		for (i = m; i < n; i++)
+		{
+			scale += std::abs(h[i*ldh + m - 1]);
+		}
+		if (scale == 0)
+		{
+			continue;
+		}
+		double norm2 = 0;
+		for (i = m; i < n; i++)
+		{
+			ort[i] = h[i*ldh + m - 1]/scale;
+			norm2 += ort[i]*ort[i];
+		}
+		double g = std::sqrt(norm2);
+		if (ort[m] > 0)
+		{
+			g = -g;
+		}
+		norm2 -= ort[m]*g;
+		ort[m] -= g;
+
+		// H = (I - u*u'/norm2)*H, on columns m:n, row by row.
+		std::fill(f.begin() + m, f.end(), 0.0);
+		for (i = m; i < n; i++)
+		{
+			const double* row = h + i*ldh;
+			for (j = m; j < n; j++)
+			{
+				f[j] += ort[i]*row[j];
+			}
+		}
+		for (i = m; i < n; i++)
+		{
+			double* row = h + i*ldh;
+			const double o = ort[i]/norm2;
+			for (j = m; j < n; j++)
+			{
+				row[j] -= f[j]*o;
+			}
+		}
+		// H = H*(I - u*u'/norm2), every row independently.
+		parallel_for(0, n, PARALLEL_GRAIN/(n - m + 1) + 1, [&](size_t lo, size_t hi)
+		{
+			size_t r, c;
+			for (r = lo; r < hi; r++)
+			{
+				double* row = h + r*ldh;
+				double s = 0;
+				for (c = m; c < n; c++)
+				{
+					s += ort[c]*row[c];
+				}
+				s /= norm2;
+				for (c = m; c < n; c++)
+				{
+					row[c] -= s*ort[c];
+				}
+			}
+		});
+		// The tail of u stays in column m - 1 for the accumulation.
+		ort[m] *= scale;
+		h[m*ldh + m - 1] = scale*g;
+	}
+
+	if (v)
+	{
+		for (i = 0; i < n; i++)
+		{
+			std::fill(v + i*ldv, v + i*ldv + n, 0.0);
+			v[i*ldv + i] = 1;
+		}
+		for (m = n - 1; m-- > 1;)
+		{
+			const double h_m = h[m*ldh + m - 1];
+			if (h_m == 0)
+			{
+				continue;
+			}
+			for (i = m + 1; i < n; i++)
+			{
+				ort[i] = h[i*ldh + m - 1];
+			}
+			std::fill(f.begin() + m, f.end(), 0.0);
+			for (i = m; i < n; i++)
+			{
+				const double* row = v + i*ldv;
+				for (j = m; j < n; j++)
+				{
+					f[j] += ort[i]*row[j];
+				}
+			}
+			for (j = m; j < n; j++)
+			{
+				// Double division avoids possible underflow.
+				f[j] = (f[j]/ort[m])/h_m;
+			}
+			for (i = m; i < n; i++)
+			{
+				double* row = v + i*ldv;
+				for (j = m; j < n; j++)
+				{
+					row[j] += f[j]*ort[i];
+				}
+			}
+		}
+	}
+	for (i = 2; i < n; i++)
+	{
+		std::fill(h + i*ldh, h + i*ldh + i - 1, 0.0);
+	}
+}
+
+// It computes x + i*y = (xr + i*xi)/(yr + i*yi) without overflow.
+inline void eig_cdiv(double xr, double xi, double yr, double yi, double& x, double& y)
+{
+	double r, d;
+	if (std::abs(yr) > std::abs(yi))
+	{
+		r = yi/yr;
+		d = yr + r*yi;
+		x = (xr + r*xi)/d;
+		y = (xi - r*xr)/d;
+	}
+	else
+	{
+		r = yr/yi;
+		d = yi + r*yr;
+		x = (r*xr + xi)/d;
+		y = (r*xi - xr)/d;
+	}
+}
+
+// It computes the eigenvalues wr + i*wi of the n x n upper Hessenberg
+// matrix h by the Francis double-shift QR iteration (EISPACK hqr2). When
+// v is not null it must hold the transformation of eig_hessenberg(); the
+// Schur form is then completed and v is overwritten with the (real)
+// eigenvectors: for a complex pair wi(j) > 0, wi(j+1) < 0, the vectors
+// are v(:,j) +- i*v(:,j+1). Without v only the active window is updated,
+// which roughly halves the work. It returns false if an eigenvalue did
+// not converge within EIG_MAX_ITERATIONS.
+inline bool eig_hessenberg_qr(size_t n_size, double* h, size_t ldh, double* wr, double* wi,
+		double* v, size_t ldv)
+{
+	const double eps = std::numeric_limits<double>::epsilon();
+	const bool vectors = (v != nullptr);
+	const long nn = (long) n_size;
+	long n = nn - 1, l, m, i, j, k;
+	double exshift = 0, p = 0, q = 0, r = 0, s = 0, z = 0, t, w, x, y;
+	double norm = 0;
+	size_t iter = 0;
+#define H_(a, b) h[(a)*ldh + (b)]
+#define V_(a, b) v[(a)*ldv + (b)]
+	for (i = 0; i < nn; i++)
+	{
+		for (j = std::max(i - 1, 0L); j < nn; j++)
+		{
+			norm += std::abs(H_(i, j));
+		}
+	}
+
+	while (n >= 0)
+	{
+		// Look for a single small subdiagonal element.
+		l = n;
+		while (l > 0)
+		{
+			s = std::abs(H_(l - 1, l - 1)) + std::abs(H_(l, l));
+			if (s == 0)
+			{
+				s = norm;
+			}
+			if (std::abs(H_(l, l - 1)) < eps*s)
+			{
+				break;
+			}
+			l--;
+		}
+
+		if (l == n)
+		{
+			// One root found.
+			H_(n, n) += exshift;
+			wr[n] = H_(n, n);
+			wi[n] = 0;
+			n--;
+			iter = 0;
+		}
+		else if (l == n - 1)
+		{
+			// Two roots found.
+			w = H_(n, n - 1)*H_(n - 1, n);
+			p = (H_(n - 1, n - 1) - H_(n, n))/2;
+			q = p*p + w;
+			z = std::sqrt(std::abs(q));
+			H_(n, n) += exshift;
+			H_(n - 1, n - 1) += exshift;
+			x = H_(n, n);
+			if (q >= 0)
+			{
+				// Real pair.
+				z = (p >= 0) ? p + z : p - z;
+				wr[n - 1] = x + z;
+				wr[n] = (z != 0) ? x - w/z : wr[n - 1];
+				wi[n - 1] = 0;
+				wi[n] = 0;
+				if (vectors)
+				{
+					x = H_(n, n - 1);
+					s = std::abs(x) + std::abs(z);
+					p = x/s;
+					q = z/s;
+					r = std::sqrt(p*p + q*q);
+					p /= r;
+					q /= r;
+					for (j = n - 1; j < nn; j++)
+					{
+						z = H_(n - 1, j);
+						H_(n - 1, j) = q*z + p*H_(n, j);
+						H_(n, j) = q*H_(n, j) - p*z;
+					}
+					for (i = 0; i <= n; i++)
+					{
+						z = H_(i, n - 1);
+						H_(i, n - 1) = q*z + p*H_(i, n);
+						H_(i, n) = q*H_(i, n) - p*z;
+					}
+					for (i = 0; i < nn; i++)
+					{
+						z = V_(i, n - 1);
+						V_(i, n - 1) = q*z + p*V_(i, n);
+						V_(i, n) = q*V_(i, n) - p*z;
+					}
+				}
+			}
+			else
+			{
+				// Complex pair.
+				wr[n - 1] = x + p;
+				wr[n] = x + p;
+				wi[n - 1] = z;
+				wi[n] = -z;
+			}
+			n -= 2;
+			iter = 0;
+		}
+		else
+		{
+			// No convergence yet: form the shift.
+			x = H_(n, n);
+			y = 0;
+			w = 0;
+			if (l < n)
+			{
+				y = H_(n - 1, n - 1);
+				w = H_(n, n - 1)*H_(n - 1, n);
+			}
+			if (iter == EIG_MAX_ITERATIONS)
+			{
+				return false;
+			}
+			if (iter == 10)
+			{
+				// Wilkinson's original ad hoc shift.
+				exshift += x;
+				for (i = 0; i <= n; i++)
+				{
+					H_(i, i) -= x;
+				}
+				s = std::abs(H_(n, n - 1)) + std::abs(H_(n - 1, n - 2));
+				x = y = 0.75*s;
+				w = -0.4375*s*s;
+			}
+			if (iter == 30)
+			{
+				// MATLAB's ad hoc shift.
+				s = (y - x)/2;
+				s = s*s + w;
+				if (s > 0)
+				{
+					s = std::sqrt(s);
+					if (y < x)
+					{
+						s = -s;
+					}
+					s = x - w/((y - x)/2 + s);
+					for (i = 0; i <= n; i++)
+					{
+						H_(i, i) -= s;
+					}
+					exshift += s;
+					x = y = w = 0.964;
+				}
+			}
+			iter++;
+
+			// Look for two consecutive small subdiagonal elements.
+			m = n - 2;
+			while (m >= l)
+			{
+				z = H_(m, m);
+				r = x - z;
+				s = y - z;
+				p = (r*s - w)/H_(m + 1, m) + H_(m, m + 1);
+				q = H_(m + 1, m + 1) - z - r - s;
+				r = H_(m + 2, m + 1);
+				s = std::abs(p) + std::abs(q) + std::abs(r);
+				p /= s;
+				q /= s;
+				r /= s;
+				if (m == l)
+				{
+					break;
+				}
+				if (std::abs(H_(m, m - 1))*(std::abs(q) + std::abs(r)) <
+						eps*(std::abs(p)*(std::abs(H_(m - 1, m - 1)) + std::abs(z) + std::abs(H_(m + 1, m + 1)))))
+				{
+					break;
+				}
+				m--;
+			}
+			for (i = m + 2; i <= n; i++)
+			{
+				H_(i, i - 2) = 0;
+				if (i > m + 2)
+				{
+					H_(i, i - 3) = 0;
+				}
+			}
+
+			// Double QR step on rows l:n and columns m:n. Without vectors
+			// only the active window l:n is transformed.
+			const long j_end = vectors ? nn - 1 : n;
+			const long i_begin = vectors ? 0 : l;
+			for (k = m; k <= n - 1; k++)
+			{
+				const bool notlast = (k != n - 1);
+				if (k != m)
+				{
+					p = H_(k, k - 1);
+					q = H_(k + 1, k - 1);
+					r = notlast ? H_(k + 2, k - 1) : 0;
+					x = std::abs(p) + std::abs(q) + std::abs(r);
+					if (x == 0)
+					{
+						continue;
+					}
+					p /= x;
+					q /= x;
+					r /= x;
+				}
+				s = std::sqrt(p*p + q*q + r*r);
+				if (p < 0)
+				{
+					s = -s;
+				}
+				if (s == 0)
+				{
+					continue;
+				}
+				if (k != m)
+				{
+					H_(k, k - 1) = -s*x;
+				}
+				else if (l != m)
+				{
+					H_(k, k - 1) = -H_(k, k - 1);
+				}
+				p += s;
+				x = p/s;
+				y = q/s;
+				z = r/s;
+				q /= p;
+				r /= p;
+
+				// Row modification.
+				double* h_k = h + k*ldh;
+				double* h_k1 = h_k + ldh;
+				double* h_k2 = h_k1 + ldh;
+				for (j = k; j <= j_end; j++)
+				{
+					p = h_k[j] + q*h_k1[j];
+					if (notlast)
+					{
+						p += r*h_k2[j];
+						h_k2[j] -= p*z;
+					}
+					h_k[j] -= p*x;
+					h_k1[j] -= p*y;
+				}
+				// Column modification.
+				const long i_end = std::min(n, k + 3);
+				for (i = i_begin; i <= i_end; i++)
+				{
+					double* h_i = h + i*ldh;
+					p = x*h_i[k] + y*h_i[k + 1];
+					if (notlast)
+					{
+						p += z*h_i[k + 2];
+						h_i[k + 2] -= p*r;
+					}
+					h_i[k] -= p;
+					h_i[k + 1] -= p*q;
+				}
+				// Accumulate the transformations.
+				if (vectors)
+				{
+					for (i = 0; i < nn; i++)
+					{
+						double* v_i = v + i*ldv;
+						p = x*v_i[k] + y*v_i[k + 1];
+						if (notlast)
+						{
+							p += z*v_i[k + 2];
+							v_i[k + 2] -= p*r;
+						}
+						v_i[k] -= p;
+						v_i[k + 1] -= p*q;
+					}
+				}
+			}
+		}
+	}
+	if (!vectors || norm == 0)
+	{
+		return true;
+	}
+
+	// Back substitution: the eigenvectors of the quasi-triangular Schur
+	// form, stored in place of it.
+	for (n = nn - 1; n >= 0; n--)
+	{
+		p = wr[n];
+		q = wi[n];
+		if (q == 0)
+		{
+			// Real vector.
+			l = n;
+			H_(n, n) = 1;
+			for (i = n - 1; i >= 0; i--)
+			{
+				w = H_(i, i) - p;
+				r = 0;
+				for (j = l; j <= n; j++)
+				{
+					r += H_(i, j)*H_(j, n);
+				}
+				if (wi[i] < 0)
+				{
+					z = w;
+					s = r;
+				}
+				else
+				{
+					l = i;
+					if (wi[i] == 0)
+					{
+						H_(i, n) = (w != 0) ? -r/w : -r/(eps*norm);
+					}
+					else
+					{
+						x = H_(i, i + 1);
+						y = H_(i + 1, i);
+						q = (wr[i] - p)*(wr[i] - p) + wi[i]*wi[i];
+						t = (x*s - z*r)/q;
+						H_(i, n) = t;
+						H_(i + 1, n) = (std::abs(x) > std::abs(z)) ? (-r - w*t)/x : (-s - y*t)/z;
+					}
+					// Overflow control.
+					t = std::abs(H_(i, n));
+					if ((eps*t)*t > 1)
+					{
+						for (j = i; j <= n; j++)
+						{
+							H_(j, n) /= t;
+						}
+					}
+				}
+			}
+		}
+		else if (q < 0)
+		{
+			// Complex vector: the last component is imaginary.
+			l = n - 1;
+			if (std::abs(H_(n, n - 1)) > std::abs(H_(n - 1, n)))
+			{
+				H_(n - 1, n - 1) = q/H_(n, n - 1);
+				H_(n - 1, n) = -(H_(n, n) - p)/H_(n, n - 1);
+			}
+			else
+			{
+				eig_cdiv(0, -H_(n - 1, n), H_(n - 1, n - 1) - p, q, H_(n - 1, n - 1), H_(n - 1, n));
+			}
+			H_(n, n - 1) = 0;
+			H_(n, n) = 1;
+			for (i = n - 2; i >= 0; i--)
+			{
+				double ra = 0, sa = 0, vr, vi;
+				for (j = l; j <= n; j++)
+				{
+					ra += H_(i, j)*H_(j, n - 1);
+					sa += H_(i, j)*H_(j, n);
+				}
+				w = H_(i, i) - p;
+				if (wi[i] < 0)
+				{
+					z = w;
+					r = ra;
+					s = sa;
+				}
+				else
+				{
+					l = i;
+					if (wi[i] == 0)
+					{
+						eig_cdiv(-ra, -sa, w, q, H_(i, n - 1), H_(i, n));
+					}
+					else
+					{
+						x = H_(i, i + 1);
+						y = H_(i + 1, i);
+						vr = (wr[i] - p)*(wr[i] - p) + wi[i]*wi[i] - q*q;
+						vi = (wr[i] - p)*2*q;
+						if (vr == 0 && vi == 0)
+						{
+							vr = eps*norm*(std::abs(w) + std::abs(q) + std::abs(x) + std::abs(y) + std::abs(z));
+						}
+						eig_cdiv(x*r - z*ra + q*sa, x*s - z*sa - q*ra, vr, vi, H_(i, n - 1), H_(i, n));
+						if (std::abs(x) > std::abs(z) + std::abs(q))
+						{
+							H_(i + 1, n - 1) = (-ra - w*H_(i, n - 1) + q*H_(i, n))/x;
+							H_(i + 1, n) = (-sa - w*H_(i, n) - q*H_(i, n - 1))/x;
+						}
+						else
+						{
+							eig_cdiv(-r - y*H_(i, n - 1), -s - y*H_(i, n), z, q, H_(i + 1, n - 1), H_(i + 1, n));
+						}
+					}
+					// Overflow control.
+					t = std::max(std::abs(H_(i, n - 1)), std::abs(H_(i, n)));
+					if ((eps*t)*t > 1)
+					{
+						for (j = i; j <= n; j++)
+						{
+							H_(j, n - 1) /= t;
+							H_(j, n) /= t;
+						}
+					}
+				}
+			}
+		}
+	}
+#undef H_
+#undef V_
+
+	// V = V*X, with X the upper triangular eigenvectors left in h; every
+	// row of V is independent.
+	parallel_for(0, n_size, PARALLEL_GRAIN/(n_size*n_size/2 + 1) + 1, [&](size_t lo, size_t hi)
+	{
+		std::vector<double> row(n_size);
+		size_t a, b, c;
+		for (a = lo; a < hi; a++)
+		{
+			double* v_a = v + a*ldv;
+			std::fill(row.begin(), row.end(), 0.0);
+			for (b = 0; b < n_size; b++)
+			{
+				const double v_ab = v_a[b];
+				const double* h_b = h + b*ldh;
+				for (c = b; c < n_size; c++)
+				{
+					row[c] += v_ab*h_b[c];
+				}
+			}
+			std::copy(row.begin(), row.end(), v_a);
+		}
+	});
+	return true;
+}
+
+} /* namespace algebra */
+
+#endif /* EIG_KERNEL_H_ */
@@ -0,0 +1,296 @@
+/*============================================================================
+ * Name         : gemm.h implements a cache-blocked, register-tiled general
+ *                matrix-matrix multiplication (C += A*B) on raw row-major
+ *                buffers. It is the kernel behind Mat<T>::operator*.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+#ifndef GEMM_H_
+#define GEMM_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <complex>
+#include <algorithm>    // std::min
+
+#include "../utilities/workspace.h"
+#include "thread_pool.h"
+
+// Below that number of multiply-adds (m*n*k) packing does not pay
+// off and the plain i-k-j loop is used instead.
+#define GEMM_SMALL_PRODUCT (48*48*48)
+
+// Above that number of multiply-adds (m*n*k) C is split into tiles
+// which are computed on the thread pool.
+#define GEMM_PARALLEL_PRODUCT (128*128*128)
+
+namespace algebra {
+
+// The layout follows the classic Goto/BLIS scheme:
+//
+//   for jc (NC columns of B and C)          -> B panel lives in L3
+//     for pc (KC common dimension)          -> pack B(pc:pc+KC, jc:jc+NC)
+//       for ic (MC rows of A and C)         -> pack A(ic:ic+MC, pc:pc+KC), lives in L2
+//         for jr (NR columns), ir (MR rows) -> MRxNR micro-kernel on registers
+//
+// MR and NR set the register tile, MC/KC/NC the cache blocks. They are
+// chosen so that an MRxKC sliver of A and a KCxNR sliver of B fit in L1.
+template <class T>
+struct gemm_blocking
+{
+	static const size_t MR = 4;
+	static const size_t NR = 8;
+	static const size_t MC = 128;
+	static const size_t KC = 256;
+	static const size_t NC = 2048;
+};
+
+template <>
+struct gemm_blocking< std::complex<double> >
+{
+	static const size_t MR = 2;
+	static const size_t NR = 4;
+	static const size_t MC = 64;
+	static const size_t KC = 192;
+	static const size_t NC = 1024;
+};
+
+// Multiply-accumulate used by the micro-kernel. The complex overload
+// spells out the arithmetic so that the compiler does not fall back to
+// the NaN-aware library call it emits for std::complex multiplication.
+template <class T>
+inline void gemm_madd(T& acc, const T& a, const T& b) { acc += a*b; }
+
+inline void gemm_madd(std::complex<double>& acc, const std::complex<double>& a, const std::complex<double>& b)
+{
+	acc.real(acc.real() + a.real()*b.real() - a.imag()*b.imag());
+	acc.imag(acc.imag() + a.real()*b.imag() + a.imag()*b.real());
+}
+
+// Packs the mc x kc block of A (element (i,p) at a[i*rsa + p*csa]) into
+// consecutive MR-row slivers, each stored column after column. Rows past
+// mc are padded with zeros so the micro-kernel never needs edge cases.
+template <class T>
+inline void gemm_pack_a(size_t mc, size_t kc, const T* a, size_t rsa, size_t csa, T* buffer)
+{
+	const size_t MR = gemm_blocking<T>::MR;
+	size_t ir, i, p;
+	for (ir = 0; ir < mc; ir += MR)
+	{
+		size_t mr = std::min(MR, mc - ir);
+		for (p = 0; p < kc; p++)
+		{
+			for (i = 0; i < mr; i++)
+			{
+				buffer[i] = a[(ir + i)*rsa + p*csa];
+			}
+			for (i = mr; i < MR; i++)
+			{
+				buffer[i] = T(0);
+			}
+			buffer += MR;
+		}
+	}
+}
+
+// Packs the kc x nc block of B (element (p,j) at b[p*rsb + j*csb]) into
+// consecutive NR-column slivers, each stored row after row.
+template <class T>
+inline void gemm_pack_b(size_t kc, size_t nc, const T* b, size_t rsb, size_t csb, T* buffer)
+{
+	const size_t NR = gemm_blocking<T>::NR;
+	size_t jr, j, p;
+	for (jr = 0; jr < nc; jr += NR)
+	{
+		size_t nr = std::min(NR, nc - jr);
+		for (p = 0; p < kc; p++)
+		{
+			const T* b_row = b + p*rsb + jr*csb;
+			for (j = 0; j < nr; j++)
+			{
+				buffer[j] = b_row[j*csb];
+			}
+			for (j = nr; j < NR; j++)
+			{
+				buffer[j] = T(0);
+			}
+			buffer += NR;
+		}
+	}
+}
+
+// Computes the MRxNR tile C += A_sliver * B_sliver over kc steps.
+// Only the mr x nr top-left part of the tile is written back.
+template <class T>
+inline void gemm_micro_kernel(size_t kc, const T* a, const T* b, T* c, size_t ldc, size_t mr, size_t nr)
+{
+	const size_t MR = gemm_blocking<T>::MR;
+	const size_t NR = gemm_blocking<T>::NR;
+	T acc[MR][NR];
+	size_t i, j, p;
+	for (i = 0; i < MR; i++)
+	{
+		for (j = 0; j < NR; j++)
+		{
+			acc[i][j] = T(0);
+		}
+	}
+	for (p = 0; p < kc; p++)
+	{
+		for (i = 0; i < MR; i++)
+		{
+			const T a_ip = a[i];
+			for (j = 0; j < NR; j++)
+			{
+				gemm_madd(acc[i][j], a_ip, b[j]);
+			}
+		}
+		a += MR;
+		b += NR;
+	}
+	for (i = 0; i < mr; i++)
+	{
+		T* c_row = c + i*ldc;
+		for (j = 0; j < nr; j++)
+		{
+			c_row[j] += acc[i][j];
+		}
+	}
+}
+
+// Reference i-k-j product, used for small problems where packing
+// costs more than it saves.
+template <class T>
+inline void gemm_small(size_t m, size_t n, size_t k,
+		const T* a, size_t rsa, size_t csa,
+		const T* b, size_t rsb, size_t csb,
+		T* c, size_t ldc)
+{
+	size_t i, j, p;
+	for (i = 0; i < m; i++)
+	{
+		T* c_row = c + i*ldc;
+		for (p = 0; p < k; p++)
+		{
+			const T a_ip = a[i*rsa + p*csa];
+			const T* b_row = b + p*rsb;
+			for (j = 0; j < n; j++)
+			{
+				gemm_madd(c_row[j], a_ip, b_row[j*csb]);
+			}
+		}
+	}
+}
+
+// The packed, blocked product on a single thread.
+template <class T>
+inline void gemm_blocked(size_t m, size_t n, size_t k,
+		const T* a, size_t rsa, size_t csa,
+		const T* b, size_t rsb, size_t csb,
+		T* c, size_t ldc)
+{
+	const size_t MR = gemm_blocking<T>::MR;
+	const size_t NR = gemm_blocking<T>::NR;
+	const size_t MC = gemm_blocking<T>::MC;
+	const size_t KC = gemm_blocking<T>::KC;
+	const size_t NC = gemm_blocking<T>::NC;
+
+	std::vector<T, workspace_allocator<T> > a_packed(MC*KC);
+	std::vector<T, workspace_allocator<T> > b_packed(KC*std::min(NC, (n + NR - 1)/NR*NR));
+
+	size_t jc, pc, ic, jr, ir;
+	for (jc = 0; jc < n; jc += NC)
+	{
+		size_t nc = std::min(NC, n - jc);
+		for (pc = 0; pc < k; pc += KC)
+		{
+			size_t kc = std::min(KC, k - pc);
+			gemm_pack_b(kc, nc, b + pc*rsb + jc*csb, rsb, csb, b_packed.data());
+			for (ic = 0; ic < m; ic += MC)
+			{
+				size_t mc = std::min(MC, m - ic);
+				gemm_pack_a(mc, kc, a + ic*rsa + pc*csa, rsa, csa, a_packed.data());
+				for (jr = 0; jr < nc; jr += NR)
+				{
+					size_t nr = std::min(NR, nc - jr);
+					for (ir = 0; ir < mc; ir += MR)
+					{
+						size_t mr = std::min(MR, mc - ir);
+						gemm_micro_kernel(kc, &a_packed[ir*kc], &b_packed[jr*kc],
+								c + (ic + ir)*ldc + jc + jr, ldc, mr, nr);
+					}
+				}
+			}
+		}
+	}
+}
+
+// It computes C += A*B where A is m x k, B is k x n and C is m x n.
+// A and B are addressed through row/column strides, so a transposed
+// operand is passed by swapping its strides instead of materializing it.
+// C is row-major with leading dimension ldc.
+template <class T>
+inline void gemm(size_t m, size_t n, size_t k,
+		const T* a, size_t rsa, size_t csa,
+		const T* b, size_t rsb, size_t csb,
+		T* c, size_t ldc)
+{
+	if (m == 0 || n == 0 || k == 0)
+	{
+		return;
+	}
+	if (m*n*k <= GEMM_SMALL_PRODUCT)
+	{
+		gemm_small(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc);
+		return;
+	}
+	if (m*n*k <= GEMM_PARALLEL_PRODUCT || get_num_threads() == 1)
+	{
+		gemm_blocked(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc);
+		return;
+	}
+
+	// The tiles of C are disjoint, so they are computed independently;
+	// each one packs its own rows of A and columns of B.
+	const size_t TM = gemm_blocking<T>::MC;
+	const size_t TN = 2*gemm_blocking<T>::MC/gemm_blocking<T>::NR*gemm_blocking<T>::NR;
+	const size_t tile_rows = (m + TM - 1)/TM;
+	const size_t tile_cols = (n + TN - 1)/TN;
+	parallel_for(0, tile_rows*tile_cols, 1, [=](size_t lo, size_t hi)
+	{
+		size_t t;
+		for (t = lo; t < hi; t++)
+		{
+			size_t i = t/tile_cols*TM, j = t%tile_cols*TN;
+			gemm_blocked(std::min(TM, m - i), std::min(TN, n - j), k,
+					a + i*rsa, rsa, csa,
+					b + j*csb, rsb, csb,
+					c + i*ldc + j, ldc);
+		}
+	});
+}
+
+} /* namespace algebra */
+
+#endif /* GEMM_H_ */
@@ -0,0 +1,302 @@
+/*============================================================================
+ * Name         : lu.h implements a cache-blocked, right-looking LU
+ *                factorization with partial pivoting (P*A = L*U) on a raw
+ *                row-major buffer, and the triangular solves with its
+ *                factors. It is the kernel behind lup_decompose(),
+ *                lup_invert(), solve() and the LU class.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+#ifndef LU_KERNEL_H_
+#define LU_KERNEL_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <complex>
+#include <cmath>        // std::abs
+#include <limits>       // numeric limits
+#include <algorithm>    // std::min, std::swap_ranges
+
+#include "../utilities/workspace.h"
+#include "gemm.h"
+#include "thread_pool.h"
+
+// Number of columns factorized per panel. The trailing update of every
+// panel is a product with an inner dimension of LU_BLOCK_SIZE.
+#define LU_BLOCK_SIZE 64
+
+namespace algebra {
+
+// The factorization proceeds in panels of LU_BLOCK_SIZE columns:
+//
+//   [ A11 A12 ]    1. factorize the panel [A11; A21] column by column
+//   [ A21 A22 ]    2. U12 = inv(L11)*A12        (triangular solve)
+//                  3. A22 = A22 - L21*U12       (gemm)
+//
+// so most of the work is done by the blocked product kernel. Pivoting
+// swaps whole rows in place; the row-major layout makes that a
+// contiguous exchange of two rows.
+
+// It factorizes the panel made of rows k..n-1 and columns k..k+nb-1 of
+// the n x n matrix a. The rows are interchanged over their full length.
+template <class T>
+inline void lu_panel(size_t n, size_t k, size_t nb, T* a, size_t lda,
+		size_t* perm, size_t& swaps, double& min_pivot)
+{
+	size_t i, j, imax;
+	double max_a, abs_a;
+	for (j = k; j < k + nb; j++)
+	{
+		max_a = std::abs(a[j*lda + j]);
+		imax = j;
+		for (i = j + 1; i < n; i++)
+		{
+			if ((abs_a = std::abs(a[i*lda + j])) > max_a)
+			{
+				max_a = abs_a;
+				imax = i;
+			}
+		}
+		min_pivot = std::min(min_pivot, max_a);
+
+		if (imax != j)
+		{
+			std::swap_ranges(a + j*lda, a + j*lda + n, a + imax*lda);
+			std::swap(perm[j], perm[imax]);
+			swaps++;
+		}
+
+		// A zero column leaves nothing to eliminate.
+		if (max_a == 0)
+		{
+			continue;
+		}
+
+		// The rows below the pivot are updated independently.
+		const T* row_j = a + j*lda;
+		const size_t end = k + nb;
+		parallel_for(j + 1, n, PARALLEL_GRAIN/(end - j), [&](size_t lo, size_t hi)
+		{
+			size_t r, c;
+			for (r = lo; r < hi; r++)
+			{
+				T* row_r = a + r*lda;
+				row_r[j] /= row_j[j];
+				const T l_rj = row_r[j];
+				for (c = j + 1; c < end; c++)
+				{
+					row_r[c] -= l_rj * row_j[c];
+				}
+			}
+		});
+	}
+}
+
+// It computes P*A = L*U for the n x n row-major matrix a (leading
+// dimension lda). On return a holds U on and above the diagonal and the
+// unit lower triangular L below it, perm[i] is the row of A that ended up
+// in row i and swaps counts the row interchanges. It returns the smallest
+// absolute pivot, which is 0 for an exactly singular matrix.
+template <class T>
+inline double lu_factor(size_t n, T* a, size_t lda, size_t* perm, size_t& swaps)
+{
+	const size_t NB = LU_BLOCK_SIZE;
+	double min_pivot = std::numeric_limits<double>::infinity();
+	size_t i, k, p;
+
+	for (i = 0; i < n; i++)
+	{
+		perm[i] = i;
+	}
+	swaps = 0;
+
+	std::vector<T, workspace_allocator<T> > l21;
+	for (k = 0; k < n; k += NB)
+	{
+		const size_t nb = std::min(NB, n - k);
+		lu_panel(n, k, nb, a, lda, perm, swaps, min_pivot);
+
+		const size_t rest = n - k - nb;
+		if (rest == 0)
+		{
+			break;
+		}
+
+		// U12 = inv(L11)*A12, where L11 is unit lower triangular. The
+		// columns of A12 are independent, so they are solved in bands.
+		const T* l11 = a + k*lda + k;
+		T* a12 = a + k*lda + k + nb;
+		parallel_for(0, rest, PARALLEL_GRAIN/(nb*nb) + 1, [&](size_t lo, size_t hi)
+		{
+			size_t r, p, c;
+			for (r = 1; r < nb; r++)
+			{
+				T* row_r = a12 + r*lda;
+				for (p = 0; p < r; p++)
+				{
+					const T l_rp = l11[r*lda + p];
+					const T* row_p = a12 + p*lda;
+					for (c = lo; c < hi; c++)
+					{
+						row_r[c] -= l_rp * row_p[c];
+					}
+				}
+			}
+		});
+
+		// A22 -= L21*U12. gemm accumulates, so it gets -L21.
+		l21.resize(rest*nb);
+		for (i = 0; i < rest; i++)
+		{
+			const T* row = a + (k + nb + i)*lda + k;
+			for (p = 0; p < nb; p++)
+			{
+				l21[i*nb + p] = -row[p];
+			}
+		}
+		gemm(rest, rest, nb,
+				l21.data(), nb, (size_t) 1,
+				a12, lda, (size_t) 1,
+				a + (k + nb)*lda + k + nb, lda);
+	}
+	return n == 0 ? 0.0 : min_pivot;
+}
+
+// It solves L*X = B in place, where L is the unit lower triangular factor
+// stored below the diagonal of lu (leading dimension lda) and B is n x nrhs
+// (leading dimension ldb). Every diagonal block is solved by row updates,
+// the rows below it are updated by one gemm call.
+template <class T>
+inline void lu_solve_lower(size_t n, size_t nrhs, const T* lu, size_t lda, T* b, size_t ldb)
+{
+	const size_t NB = LU_BLOCK_SIZE;
+	std::vector<T, workspace_allocator<T> > l21;
+	size_t i, k, p;
+	for (k = 0; k < n; k += NB)
+	{
+		const size_t nb = std::min(NB, n - k);
+		const T* l11 = lu + k*lda + k;
+		T* b1 = b + k*ldb;
+		parallel_for(0, nrhs, PARALLEL_GRAIN/(nb*nb) + 1, [&](size_t lo, size_t hi)
+		{
+			size_t r, q, c;
+			for (r = 1; r < nb; r++)
+			{
+				T* row_r = b1 + r*ldb;
+				for (q = 0; q < r; q++)
+				{
+					const T l_rq = l11[r*lda + q];
+					const T* row_q = b1 + q*ldb;
+					for (c = lo; c < hi; c++)
+					{
+						row_r[c] -= l_rq * row_q[c];
+					}
+				}
+			}
+		});
+
+		const size_t rest = n - k - nb;
+		if (rest == 0)
+		{
+			break;
+		}
+		// B2 -= L21*B1
+		l21.resize(rest*nb);
+		for (i = 0; i < rest; i++)
+		{
+			const T* row = lu + (k + nb + i)*lda + k;
+			for (p = 0; p < nb; p++)
+			{
+				l21[i*nb + p] = -row[p];
+			}
+		}
+		gemm(rest, nrhs, nb,
+				l21.data(), nb, (size_t) 1,
+				b1, ldb, (size_t) 1,
+				b + (k + nb)*ldb, ldb);
+	}
+}
+
+// It solves U*X = B in place, where U is the upper triangular factor
+// stored on and above the diagonal of lu. The blocks are processed from
+// the bottom up; the rows above every diagonal block are updated by gemm.
+template <class T>
+inline void lu_solve_upper(size_t n, size_t nrhs, const T* lu, size_t lda, T* b, size_t ldb)
+{
+	const size_t NB = LU_BLOCK_SIZE;
+	std::vector<T, workspace_allocator<T> > u12;
+	size_t i, k, p, end;
+	for (end = n; end > 0; end = k)
+	{
+		k = end > NB ? end - NB : 0;
+		const size_t nb = end - k;
+		const T* u11 = lu + k*lda + k;
+		T* b1 = b + k*ldb;
+		parallel_for(0, nrhs, PARALLEL_GRAIN/(nb*nb) + 1, [&](size_t lo, size_t hi)
+		{
+			size_t r, q, c;
+			for (r = nb; r--;)
+			{
+				T* row_r = b1 + r*ldb;
+				for (q = r + 1; q < nb; q++)
+				{
+					const T u_rq = u11[r*lda + q];
+					const T* row_q = b1 + q*ldb;
+					for (c = lo; c < hi; c++)
+					{
+						row_r[c] -= u_rq * row_q[c];
+					}
+				}
+				const T u_rr = u11[r*lda + r];
+				for (c = lo; c < hi; c++)
+				{
+					row_r[c] /= u_rr;
+				}
+			}
+		});
+
+		if (k == 0)
+		{
+			break;
+		}
+		// B0 -= U01*B1
+		u12.resize(k*nb);
+		for (i = 0; i < k; i++)
+		{
+			const T* row = lu + i*lda + k;
+			for (p = 0; p < nb; p++)
+			{
+				u12[i*nb + p] = -row[p];
+			}
+		}
+		gemm(k, nrhs, nb,
+				u12.data(), nb, (size_t) 1,
+				b1, ldb, (size_t) 1,
+				b, ldb);
+	}
+}
+
+} /* namespace algebra */
+
+#endif /* LU_KERNEL_H_ */
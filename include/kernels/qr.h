@@ -0,0 +1,261 @@
+/*============================================================================
+ * Name         : qr.h implements a blocked Householder QR factorization
+ *                (A = Q*R) on a raw row-major buffer, with Q kept in the
+ *                compact WY representation, and the application of Q or
+ *                Q^H to a matrix without forming Q. They are the kernels
+ *                behind the QR class, qr() and lstsq().
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* Q = H(0)*H(1)*...*H(k-1), k = min(m,n), with the reflectors
+ *
+ *     H(j) = I - tau(j)*v(j)*v(j)^H,   v(j) = [0 ... 0 1 v(j+1..m-1)]
+ *
+ * The factorized matrix holds R on and above its diagonal and the tails
+ * of the v(j) below it, as in LAPACK. A panel of nb reflectors is applied
+ * at once as H = I - V*T*V^H, with T an nb x nb upper triangular matrix
+ * (compact WY), so that the trailing update is made of two gemm calls.
+ */
+
+#ifndef QR_KERNEL_H_
+#define QR_KERNEL_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <complex>
+#include <cmath>        // std::sqrt
+#include <algorithm>    // std::min
+
+#include "../utilities/workspace.h"
+#include "gemm.h"
+#include "scalar.h"
+#include "thread_pool.h"
+
+// Number of reflectors applied per block.
+#define QR_BLOCK_SIZE 32
+
+namespace algebra {
+
+// It computes the reflector H with H^H*[alpha; x] = [beta; 0], where x
+// is the column of length len below alpha (stride ldx). alpha becomes
+// beta, x becomes the tail of v and tau is returned.
+template <class T>
+inline T qr_householder(size_t len, T& alpha, T* x, size_t ldx)
+{
+	size_t i;
+	double xnorm2 = 0;
+	for (i = 0; i < len; i++)
+	{
+		xnorm2 += scalar_abs2(x[i*ldx]);
+	}
+	if (xnorm2 == 0 && scalar_real(alpha*alpha) == scalar_abs2(alpha))
+	{
+		// x is already zero and alpha is real: H = I.
+		return T(0);
+	}
+	double beta = std::sqrt(scalar_abs2(alpha) + xnorm2);
+	if (scalar_real(alpha) >= 0)
+	{
+		beta = -beta;
+	}
+	const T tau = (T(beta) - alpha)/T(beta);
+	const T scale = T(1)/(alpha - T(beta));
+	for (i = 0; i < len; i++)
+	{
+		x[i*ldx] *= scale;
+	}
+	alpha = T(beta);
+	return tau;
+}
+
+// It factorizes the m x nb panel at a column by column. The reflectors
+// are applied to the columns of the panel only.
+template <class T>
+inline void qr_panel(size_t m, size_t nb, T* a, size_t lda, T* tau)
+{
+	std::vector<T> w(nb);
+	size_t i, j, c;
+	for (j = 0; j < nb && j < m; j++)
+	{
+		T* a_jj = a + j*lda + j;
+		tau[j] = qr_householder(m - j - 1, *a_jj, a_jj + lda, lda);
+		if (tau[j] == T(0) || j + 1 == nb)
+		{
+			continue;
+		}
+		// [a_jj..; A(j:m, j+1:nb)] -= conj(tau)*v*(v^H*A), row by row.
+		const T t = scalar_conj(tau[j]);
+		const size_t cols = nb - j - 1;
+		std::fill(w.begin(), w.begin() + cols, T(0));
+		for (i = j; i < m; i++)
+		{
+			const T v_i = scalar_conj(i == j ? T(1) : a[i*lda + j]);
+			const T* row = a + i*lda + j + 1;
+			for (c = 0; c < cols; c++)
+			{
+				w[c] += v_i*row[c];
+			}
+		}
+		for (i = j; i < m; i++)
+		{
+			const T v_i = (i == j ? T(1) : a[i*lda + j])*t;
+			T* row = a + i*lda + j + 1;
+			for (c = 0; c < cols; c++)
+			{
+				row[c] -= v_i*w[c];
+			}
+		}
+	}
+}
+
+// It copies the nb reflectors stored below the diagonal of the m x nb
+// panel at a into the dense m x nb matrix v (unit diagonal, zeros above
+// it) and forms the upper triangular T of H(0)*...*H(nb-1) = I - V*T*V^H.
+template <class T>
+inline void qr_block_reflector(size_t m, size_t nb, const T* a, size_t lda, const T* tau, T* v, T* t)
+{
+	size_t i, j, p;
+	for (i = 0; i < m; i++)
+	{
+		for (j = 0; j < nb; j++)
+		{
+			v[i*nb + j] = i > j ? a[i*lda + j] : (i == j ? T(1) : T(0));
+		}
+	}
+
+	// T(0:j, j) = -tau(j)*T(0:j, 0:j)*(V(:, 0:j)^H*v(j)), T(j, j) = tau(j)
+	std::vector<T> z(nb);
+	for (j = 0; j < nb; j++)
+	{
+		for (p = 0; p < j; p++)
+		{
+			z[p] = T(0);
+		}
+		for (i = j; i < m; i++)
+		{
+			const T v_ij = v[i*nb + j];
+			const T* row = v + i*nb;
+			for (p = 0; p < j; p++)
+			{
+				z[p] += scalar_conj(row[p])*v_ij;
+			}
+		}
+		for (p = 0; p < j; p++)
+		{
+			T s = T(0);
+			for (i = p; i < j; i++)
+			{
+				s += t[p*nb + i]*z[i];
+			}
+			t[p*nb + j] = -tau[j]*s;
+		}
+		t[j*nb + j] = tau[j];
+		for (p = j + 1; p < nb; p++)
+		{
+			t[p*nb + j] = T(0);
+		}
+	}
+}
+
+// It computes B = (I - V*op(T)*V^H)*B for the m x ncols matrix b, where
+// op(T) = T^H when adjoint is true (Q^H is applied) and T otherwise:
+//
+//   W = V^H*B,  W = op(T)*W,  B = B - V*W
+template <class T>
+inline void qr_apply_block(size_t m, size_t nb, const T* v, const T* t, bool adjoint,
+		T* b, size_t ldb, size_t ncols)
+{
+	if (ncols == 0)
+	{
+		return;
+	}
+	std::vector<T, workspace_allocator<T> > vh(m*nb), w(nb*ncols), tw(nb*ncols), op_t(nb*nb);
+	size_t i, j;
+	// vh holds conj(V), read as V^H with swapped strides.
+	for (i = 0; i < m*nb; i++)
+	{
+		vh[i] = scalar_conj(v[i]);
+	}
+	// op_t holds -op(T).
+	for (i = 0; i < nb; i++)
+	{
+		for (j = 0; j < nb; j++)
+		{
+			op_t[i*nb + j] = adjoint ? -scalar_conj(t[j*nb + i]) : -t[i*nb + j];
+		}
+	}
+	gemm(nb, ncols, m, vh.data(), (size_t) 1, nb, b, ldb, (size_t) 1, w.data(), ncols);
+	gemm(nb, ncols, nb, op_t.data(), nb, (size_t) 1, w.data(), ncols, (size_t) 1, tw.data(), ncols);
+	gemm(m, ncols, nb, v, nb, (size_t) 1, tw.data(), ncols, (size_t) 1, b, ldb);
+}
+
+// It computes the QR factorization of the m x n matrix a in place and the
+// k = min(m,n) scalar factors tau.
+template <class T>
+inline void qr_factor(size_t m, size_t n, T* a, size_t lda, T* tau)
+{
+	const size_t NB = QR_BLOCK_SIZE;
+	const size_t k = std::min(m, n);
+	std::vector<T, workspace_allocator<T> > v, t(NB*NB);
+	size_t j;
+	for (j = 0; j < k; j += NB)
+	{
+		const size_t nb = std::min(NB, k - j);
+		const size_t rows = m - j;
+		T* panel = a + j*lda + j;
+		qr_panel(rows, nb, panel, lda, tau + j);
+		if (j + nb < n)
+		{
+			v.resize(rows*nb);
+			qr_block_reflector(rows, nb, panel, lda, tau + j, v.data(), t.data());
+			qr_apply_block(rows, nb, v.data(), t.data(), true, panel + nb, lda, n - j - nb);
+		}
+	}
+}
+
+// It overwrites the m x ncols matrix b with Q^H*b (adjoint) or Q*b, where
+// Q is given by the k reflectors stored in the m x n factorized matrix a.
+template <class T>
+inline void qr_apply_q(size_t m, size_t k, const T* a, size_t lda, const T* tau,
+		bool adjoint, T* b, size_t ldb, size_t ncols)
+{
+	const size_t NB = QR_BLOCK_SIZE;
+	std::vector<T, workspace_allocator<T> > v, t(NB*NB);
+	const size_t blocks = (k + NB - 1)/NB;
+	size_t q;
+	for (q = 0; q < blocks; q++)
+	{
+		// Q^H = H(k-1)^H*...*H(0)^H applies H(0) first, Q the reverse.
+		const size_t j = (adjoint ? q : blocks - 1 - q)*NB;
+		const size_t nb = std::min(NB, k - j);
+		const size_t rows = m - j;
+		v.resize(rows*nb);
+		qr_block_reflector(rows, nb, a + j*lda + j, lda, tau + j, v.data(), t.data());
+		qr_apply_block(rows, nb, v.data(), t.data(), adjoint, b + j*ldb, ldb, ncols);
+	}
+}
+
+} /* namespace algebra */
+
+#endif /* QR_KERNEL_H_ */
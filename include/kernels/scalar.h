@@ -0,0 +1,54 @@
+/*============================================================================
+ * Name         : scalar.h implements the scalar helpers shared by the
+ *                factorization kernels, so that one template serves real
+ *                and complex matrices alike.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+#ifndef SCALAR_H_
+#define SCALAR_H_
+
+#include <complex>
+
+namespace algebra {
+
+// Complex conjugate; the identity for real values. (std::conj(double)
+// would return a std::complex<double>.)
+template <class T>
+inline T scalar_conj(const T& x) { return x; }
+inline std::complex<double> scalar_conj(const std::complex<double>& x) { return std::conj(x); }
+
+// Real part; the value itself for real values.
+template <class T>
+inline double scalar_real(const T& x) { return (double) x; }
+inline double scalar_real(const std::complex<double>& x) { return x.real(); }
+
+// Squared magnitude |x|^2, without the square root of std::abs.
+template <class T>
+inline double scalar_abs2(const T& x) { return (double) x*(double) x; }
+inline double scalar_abs2(const std::complex<double>& x) { return std::norm(x); }
+
+} /* namespace algebra */
+
+#endif /* SCALAR_H_ */
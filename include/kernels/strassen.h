@@ -0,0 +1,352 @@
+/*============================================================================
+ * Name         : strassen.h implements the Strassen-Winograd product of
+ *                square matrices (C = A*B) on raw row-major buffers, with
+ *                dynamic peeling of odd sizes and a preallocated
+ *                workspace. It is the kernel behind strassen().
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* Every level splits A, B and C in quadrants, which are addressed in place
+ * through their leading dimension, and forms seven half-size products
+ * with the 15 additions of Winograd's variant:
+ *
+ *   S1 = A21 + A22   S2 = S1 - A11   S3 = A11 - A21   S4 = A12 - S2
+ *   T1 = B12 - B11   T2 = B22 - T1   T3 = B22 - B12   T4 = T2 - B21
+ *
+ *   P1 = A11*B11   P2 = A12*B21   P3 = S4*B22   P4 = A22*T4
+ *   P5 = S1*T1     P6 = S2*T2     P7 = S3*T3
+ *
+ *   C11 = P1 + P2           C12 = P1 + P6 + P5 + P3
+ *   C21 = P1 + P6 + P7 - P4 C22 = P1 + P6 + P7 + P5
+ *
+ * An odd size n is peeled: the even (n-1) x (n-1) core is multiplied
+ * recursively and the last row, the last column and the rank-1
+ * contribution of the last column of A are added by gemm.
+ *
+ * The lower levels follow the schedule of Douglas et al. (DGEFMM), which
+ * needs two temporaries of the quadrant size and computes the products
+ * in C itself. The top level keeps all the operands and computes the
+ * seven products on the thread pool. The recursion stops at the cutoff,
+ * which is measured once against gemm (see strassen_cutoff()).
+ */
+
+#ifndef STRASSEN_KERNEL_H_
+#define STRASSEN_KERNEL_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <atomic>
+#include <chrono>       // calibration of the cutoff
+#include <algorithm>    // std::fill, std::min
+
+#include "../utilities/aligned_allocator.h"
+#include "../utilities/workspace.h"
+#include "gemm.h"
+#include "thread_pool.h"
+
+// Smallest cutoff the calibration measures: below it the additions
+// cost more than the saved products on any machine.
+#define STRASSEN_MIN_CUTOFF 64
+// Largest size the calibration measures. If Strassen does not win
+// there, the products up to that size are left to gemm.
+#define STRASSEN_MAX_CUTOFF 1024
+
+namespace algebra {
+
+// It computes z = x + y on n x n blocks.
+template <class T>
+inline void strassen_add(size_t n, const T* x, size_t ldx, const T* y, size_t ldy, T* z, size_t ldz)
+{
+	parallel_for(0, n, PARALLEL_GRAIN/n + 1, [=](size_t lo, size_t hi)
+	{
+		size_t i, j;
+		for (i = lo; i < hi; i++)
+		{
+			const T* x_i = x + i*ldx;
+			const T* y_i = y + i*ldy;
+			T* z_i = z + i*ldz;
+			for (j = 0; j < n; j++)
+			{
+				z_i[j] = x_i[j] + y_i[j];
+			}
+		}
+	});
+}
+
+// It computes z = x - y on n x n blocks.
+template <class T>
+inline void strassen_sub(size_t n, const T* x, size_t ldx, const T* y, size_t ldy, T* z, size_t ldz)
+{
+	parallel_for(0, n, PARALLEL_GRAIN/n + 1, [=](size_t lo, size_t hi)
+	{
+		size_t i, j;
+		for (i = lo; i < hi; i++)
+		{
+			const T* x_i = x + i*ldx;
+			const T* y_i = y + i*ldy;
+			T* z_i = z + i*ldz;
+			for (j = 0; j < n; j++)
+			{
+				z_i[j] = x_i[j] - y_i[j];
+			}
+		}
+	});
+}
+
+// It computes C = A*B on n x n blocks with gemm.
+template <class T>
+inline void strassen_leaf(size_t n, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+	{
+		std::fill(c + i*ldc, c + i*ldc + n, T(0));
+	}
+	gemm(n, n, n, a, lda, 1, b, ldb, 1, c, ldc);
+}
+
+// C holds the product of the (n-1) x (n-1) cores of A and B; it adds
+// the contribution of the last column of A and the last row of B, and
+// computes the last row and the last column of C.
+template <class T>
+inline void strassen_peel(size_t n, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc)
+{
+	const size_t m = n - 1;
+	size_t i;
+	gemm(m, m, 1, a + m, lda, 1, b + m*ldb, ldb, 1, c, ldc);
+	for (i = 0; i < m; i++)
+	{
+		c[i*ldc + m] = T(0);
+	}
+	std::fill(c + m*ldc, c + m*ldc + n, T(0));
+	gemm(m, 1, n, a, lda, 1, b + m, ldb, 1, c + m, ldc);
+	gemm(1, n, n, a + m*lda, lda, 1, b, ldb, 1, c + m*ldc, ldc);
+}
+
+// It returns the number of elements of workspace strassen_serial() needs.
+inline size_t strassen_workspace(size_t n, size_t cutoff)
+{
+	size_t size = 0;
+	while (n > cutoff)
+	{
+		if (n % 2)
+		{
+			n--;
+			continue;
+		}
+		n /= 2;
+		size += 2*n*n;
+	}
+	return size;
+}
+
+// It computes C = A*B for n x n blocks, in the order of DGEFMM, with the
+// temporaries X and Y taken from work (strassen_workspace(n, cutoff)
+// elements).
+template <class T>
+void strassen_serial(size_t n, const T* a, size_t lda, const T* b, size_t ldb,
+		T* c, size_t ldc, T* work, size_t cutoff)
+{
+	if (n <= cutoff)
+	{
+		strassen_leaf(n, a, lda, b, ldb, c, ldc);
+		return;
+	}
+	if (n % 2)
+	{
+		strassen_serial(n - 1, a, lda, b, ldb, c, ldc, work, cutoff);
+		strassen_peel(n, a, lda, b, ldb, c, ldc);
+		return;
+	}
+	const size_t h = n/2;
+	const T *a11 = a, *a12 = a + h, *a21 = a + h*lda, *a22 = a21 + h;
+	const T *b11 = b, *b12 = b + h, *b21 = b + h*ldb, *b22 = b21 + h;
+	T *c11 = c, *c12 = c + h, *c21 = c + h*ldc, *c22 = c21 + h;
+	T *x = work, *y = work + h*h, *next = work + 2*h*h;
+
+	strassen_sub(h, a11, lda, a21, lda, x, h);                         // S3
+	strassen_sub(h, b22, ldb, b12, ldb, y, h);                         // T3
+	strassen_serial(h, x, h, y, h, c21, ldc, next, cutoff);            // P7
+	strassen_add(h, a21, lda, a22, lda, x, h);                         // S1
+	strassen_sub(h, b12, ldb, b11, ldb, y, h);                         // T1
+	strassen_serial(h, x, h, y, h, c22, ldc, next, cutoff);            // P5
+	strassen_sub(h, x, h, a11, lda, x, h);                             // S2
+	strassen_sub(h, b22, ldb, y, h, y, h);                             // T2
+	strassen_serial(h, x, h, y, h, c12, ldc, next, cutoff);            // P6
+	strassen_sub(h, a12, lda, x, h, x, h);                             // S4
+	strassen_serial(h, x, h, b22, ldb, c11, ldc, next, cutoff);        // P3
+	strassen_serial(h, a11, lda, b11, ldb, x, h, next, cutoff);        // P1
+	strassen_add(h, x, h, c12, ldc, c12, ldc);                         // P1 + P6
+	strassen_add(h, c12, ldc, c21, ldc, c21, ldc);                     // + P7
+	strassen_add(h, c12, ldc, c22, ldc, c12, ldc);                     // + P5
+	strassen_add(h, c21, ldc, c22, ldc, c22, ldc);                     // C22
+	strassen_add(h, c12, ldc, c11, ldc, c12, ldc);                     // C12
+	strassen_sub(h, y, h, b21, ldb, y, h);                             // T4
+	strassen_serial(h, a22, lda, y, h, c11, ldc, next, cutoff);        // P4
+	strassen_sub(h, c21, ldc, c11, ldc, c21, ldc);                     // C21
+	strassen_serial(h, a12, lda, b21, ldb, c11, ldc, next, cutoff);    // P2
+	strassen_add(h, x, h, c11, ldc, c11, ldc);                         // C11
+}
+
+// It computes C = A*B for n x n blocks. The top level computes its seven
+// products on the thread pool, every one with its own workspace; the
+// levels below are serial.
+template <class T>
+void strassen_multiply(size_t n, const T* a, size_t lda, const T* b, size_t ldb,
+		T* c, size_t ldc, size_t cutoff)
+{
+	cutoff = std::max(cutoff, (size_t) 1);
+	if (n <= cutoff)
+	{
+		strassen_leaf(n, a, lda, b, ldb, c, ldc);
+		return;
+	}
+	if (get_num_threads() == 1)
+	{
+		std::vector<T, workspace_allocator<T> > work(strassen_workspace(n, cutoff));
+		strassen_serial(n, a, lda, b, ldb, c, ldc, work.data(), cutoff);
+		return;
+	}
+	if (n % 2)
+	{
+		strassen_multiply(n - 1, a, lda, b, ldb, c, ldc, cutoff);
+		strassen_peel(n, a, lda, b, ldb, c, ldc);
+		return;
+	}
+	const size_t h = n/2, hh = h*h, w = strassen_workspace(h, cutoff);
+	const T *a11 = a, *a12 = a + h, *a21 = a + h*lda, *a22 = a21 + h;
+	const T *b11 = b, *b12 = b + h, *b21 = b + h*ldb, *b22 = b21 + h;
+	T *c11 = c, *c12 = c + h, *c21 = c + h*ldc, *c22 = c21 + h;
+
+	// S1..S4, T1..T4, P1, P2, P4 and the workspaces of the seven products.
+	std::vector<T, workspace_allocator<T> > work(11*hh + 7*w);
+	T* s[4] = { &work[0], &work[hh], &work[2*hh], &work[3*hh] };
+	T* t[4] = { &work[4*hh], &work[5*hh], &work[6*hh], &work[7*hh] };
+	T *p1 = &work[8*hh], *p2 = &work[9*hh], *p4 = &work[10*hh];
+	T* scratch = work.data() + 11*hh;
+
+	strassen_add(h, a21, lda, a22, lda, s[0], h);
+	strassen_sub(h, s[0], h, a11, lda, s[1], h);
+	strassen_sub(h, a11, lda, a21, lda, s[2], h);
+	strassen_sub(h, a12, lda, s[1], h, s[3], h);
+	strassen_sub(h, b12, ldb, b11, ldb, t[0], h);
+	strassen_sub(h, b22, ldb, t[0], h, t[1], h);
+	strassen_sub(h, b22, ldb, b12, ldb, t[2], h);
+	strassen_sub(h, t[1], h, b21, ldb, t[3], h);
+
+	// P3, P5, P6 and P7 go to the quadrants of C they are added to.
+	const T* lhs[7] = { a11, a12, s[3], a22, s[0], s[1], s[2] };
+	const size_t ldl[7] = { lda, lda, h, lda, h, h, h };
+	const T* rhs[7] = { b11, b21, b22, t[3], t[0], t[1], t[2] };
+	const size_t ldr[7] = { ldb, ldb, ldb, h, h, h, h };
+	T* prod[7] = { p1, p2, c11, p4, c22, c12, c21 };
+	const size_t ldp[7] = { h, h, ldc, h, ldc, ldc, ldc };
+	parallel_for(0, 7, 1, [&](size_t lo, size_t hi)
+	{
+		size_t p;
+		for (p = lo; p < hi; p++)
+		{
+			strassen_serial(h, lhs[p], ldl[p], rhs[p], ldr[p], prod[p], ldp[p], scratch + p*w, cutoff);
+		}
+	});
+
+	strassen_add(h, c12, ldc, p1, h, c12, ldc);                        // P1 + P6
+	strassen_add(h, c21, ldc, c12, ldc, c21, ldc);                     // + P7
+	strassen_add(h, c12, ldc, c22, ldc, c12, ldc);                     // + P5
+	strassen_add(h, c22, ldc, c21, ldc, c22, ldc);                     // C22
+	strassen_sub(h, c21, ldc, p4, h, c21, ldc);                        // C21
+	strassen_add(h, c12, ldc, c11, ldc, c12, ldc);                     // C12
+	strassen_add(h, p1, h, p2, h, c11, ldc);                           // C11
+}
+
+// It returns the smallest size, between STRASSEN_MIN_CUTOFF and
+// STRASSEN_MAX_CUTOFF, at which one Strassen level over gemm runs faster
+// than gemm alone, divided by two: the products up to that size are
+// left to gemm.
+inline size_t strassen_calibrate()
+{
+	typedef std::chrono::high_resolution_clock clock;
+	size_t n;
+	for (n = 2*STRASSEN_MIN_CUTOFF; n <= STRASSEN_MAX_CUTOFF; n *= 2)
+	{
+		std::vector<double, aligned_allocator<double> > a(n*n), b(n*n), c(n*n);
+		size_t i;
+		for (i = 0; i < n*n; i++)
+		{
+			a[i] = (double) (i % 7) - 3;
+			b[i] = (double) (i % 5) - 2;
+		}
+		double t_gemm = 0, t_strassen = 0;
+		int run;
+		for (run = 0; run < 2; run++)
+		{
+			clock::time_point t0 = clock::now();
+			strassen_leaf(n, a.data(), n, b.data(), n, c.data(), n);
+			clock::time_point t1 = clock::now();
+			strassen_multiply(n, a.data(), n, b.data(), n, c.data(), n, n/2);
+			clock::time_point t2 = clock::now();
+			const double g = std::chrono::duration<double>(t1 - t0).count();
+			const double s = std::chrono::duration<double>(t2 - t1).count();
+			t_gemm = (run == 0) ? g : std::min(t_gemm, g);
+			t_strassen = (run == 0) ? s : std::min(t_strassen, s);
+		}
+		if (t_strassen < t_gemm)
+		{
+			return n/2;
+		}
+	}
+	return STRASSEN_MAX_CUTOFF;
+}
+
+// The cutoff of the recursion; 0 until it is measured or set.
+inline std::atomic<size_t>& strassen_cutoff_value()
+{
+	static std::atomic<size_t> cutoff(0);
+	return cutoff;
+}
+
+// It sets the size up to which strassen() hands the products to gemm.
+// 0 restores the cutoff measured on the first call.
+inline void set_strassen_cutoff(size_t n)
+{
+	strassen_cutoff_value() = n;
+}
+
+// It returns the size up to which strassen() hands the products to gemm.
+// Unless it was set, it is measured on the first call by timing one
+// Strassen level against gemm, which takes a fraction of a second.
+inline size_t strassen_cutoff()
+{
+	size_t cutoff = strassen_cutoff_value();
+	if (cutoff == 0)
+	{
+		cutoff = strassen_calibrate();
+		strassen_cutoff_value() = cutoff;
+	}
+	return cutoff;
+}
+
+} /* namespace algebra */
+
+#endif /* STRASSEN_KERNEL_H_ */
@@ -0,0 +1,167 @@
+/*============================================================================
+ * Name         : svd.h implements the one-sided (Hestenes) Jacobi method on
+ *                a raw row-major buffer. It is the kernel behind svd(),
+ *                rank() and pinv().
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* One-sided Jacobi applies plane rotations J to the right of A until its
+ * columns are mutually orthogonal: A*V = U*S, with V the product of the
+ * rotations. The kernel works on W = A^H, whose rows are the (conjugated)
+ * columns of A, so that every rotation streams two contiguous rows:
+ *
+ *     V^H*W = S*U^H
+ *
+ * A sweep visits every pair of rows once, in the round-robin order of a
+ * tournament: the n/2 pairs of a round are disjoint and are rotated in
+ * parallel. The method is slower than bidiagonalization plus implicit QR,
+ * but it is simple, parallel and computes the small singular values to
+ * high relative accuracy.
+ */
+
+#ifndef SVD_KERNEL_H_
+#define SVD_KERNEL_H_
+
+#include <stddef.h>     // size_t
+#include <atomic>
+#include <utility>      // std::swap
+#include <complex>
+#include <cmath>        // std::sqrt, std::abs
+
+#include "scalar.h"
+#include "thread_pool.h"
+
+// Two rows are orthogonal when |x*y^H| <= SVD_TOLERANCE*||x||*||y||.
+#define SVD_TOLERANCE 1e-15
+// Upper bound of the sweeps; convergence usually takes 6 to 10.
+#define SVD_MAX_SWEEPS 60
+
+namespace algebra {
+
+// It rotates the rows x and y (length m) so that they become orthogonal,
+// and applies the same rotation to the rows vx and vy (length n) when vx
+// is not null. It returns false if x and y already are orthogonal.
+template <class T>
+inline bool svd_rotate(size_t m, T* x, T* y, size_t n, T* vx, T* vy)
+{
+	size_t i;
+	double alpha = 0, beta = 0;
+	T g = T(0);
+	for (i = 0; i < m; i++)
+	{
+		alpha += scalar_abs2(x[i]);
+		beta += scalar_abs2(y[i]);
+		g += x[i]*scalar_conj(y[i]);
+	}
+	const double abs_g = std::abs(g);
+	if (abs_g == 0 || abs_g <= SVD_TOLERANCE*m*std::sqrt(alpha*beta))
+	{
+		return false;
+	}
+
+	// The 2x2 Hermitian [alpha g; g' beta] is diagonalized by the rotation
+	// [c s*e; -s*e' c], e = g/|g|; t = s/c is the smaller root.
+	const double zeta = (beta - alpha)/(2*abs_g);
+	const double t = (zeta >= 0 ? 1.0 : -1.0)/(std::abs(zeta) + std::sqrt(1 + zeta*zeta));
+	const double c = 1/std::sqrt(1 + t*t);
+	const T e = g/T(abs_g);
+	const T se = T(c*t)*e, se_conj = T(c*t)*scalar_conj(e);
+	for (i = 0; i < m; i++)
+	{
+		const T x_i = x[i], y_i = y[i];
+		x[i] = T(c)*x_i - se*y_i;
+		y[i] = se_conj*x_i + T(c)*y_i;
+	}
+	if (vx)
+	{
+		for (i = 0; i < n; i++)
+		{
+			const T x_i = vx[i], y_i = vy[i];
+			vx[i] = T(c)*x_i - se*y_i;
+			vy[i] = se_conj*x_i + T(c)*y_i;
+		}
+	}
+	return true;
+}
+
+// It orthogonalizes the n rows of the n x m matrix w (leading dimension
+// ldw) and accumulates the rotations in the n x n matrix vh (leading
+// dimension ldv), unless vh is null. On return the norms of the rows of
+// w are the singular values of w^H. It returns the number of sweeps.
+template <class T>
+inline size_t svd_jacobi(size_t n, size_t m, T* w, size_t ldw, T* vh, size_t ldv)
+{
+	// Round-robin: player p - 1 is fixed, the others turn around it.
+	const size_t p = n + (n & 1);
+	const size_t pairs = p/2;
+	size_t sweep, round;
+	for (sweep = 0; sweep < SVD_MAX_SWEEPS; sweep++)
+	{
+		std::atomic<bool> rotated(false);
+		for (round = 0; round + 1 < p; round++)
+		{
+			parallel_for(0, pairs, PARALLEL_GRAIN/(m + n + 1) + 1, [&](size_t lo, size_t hi)
+			{
+				size_t k, i, j;
+				bool any = false;
+				for (k = lo; k < hi; k++)
+				{
+					if (k == 0)
+					{
+						i = round;
+						j = p - 1;
+					}
+					else
+					{
+						i = (round + k) % (p - 1);
+						j = (round + p - 1 - k) % (p - 1);
+					}
+					if (i >= n || j >= n)
+					{
+						continue;
+					}
+					if (i > j)
+					{
+						std::swap(i, j);
+					}
+					any |= svd_rotate(m, w + i*ldw, w + j*ldw, n,
+							vh ? vh + i*ldv : (T*) nullptr, vh ? vh + j*ldv : (T*) nullptr);
+				}
+				if (any)
+				{
+					rotated.store(true, std::memory_order_relaxed);
+				}
+			});
+		}
+		if (!rotated.load())
+		{
+			break;
+		}
+	}
+	return sweep;
+}
+
+} /* namespace algebra */
+
+#endif /* SVD_KERNEL_H_ */
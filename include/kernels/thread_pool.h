@@ -0,0 +1,358 @@
+/*============================================================================
+ * Name         : thread_pool.h implements the work-stealing thread pool
+ *                the heavy kernels of the library (products, LU, inverse,
+ *                large element-wise operations) are split onto.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* The pool is created on first use with one thread per hardware core; the
+ * calling thread counts as one of them, so set_num_threads(1) runs every
+ * kernel serially on the caller. Define DISABLE_THREADS to compile the
+ * serial path only (e.g. for targets without <thread>).
+ *
+ * Every worker owns a deque of tasks. It pops its own tasks from the back
+ * and, once it runs dry, steals from the front of the other deques. A
+ * thread waiting for a parallel_for to finish does not block: it keeps
+ * running queued tasks, so kernels may call parallel_for recursively
+ * (e.g. strassen over gemm) without deadlocking the pool.
+ *
+ * ATTENTION: do not call set_num_threads() while another thread is inside
+ * a parallel kernel.
+ */
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <deque>
+#include <memory>       // std::unique_ptr
+#include <algorithm>    // std::min, std::max
+#include <exception>    // std::exception_ptr
+
+#ifndef DISABLE_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
+
+// Below that many scalar operations a range is not split across threads;
+// every task of a parallel_for gets at least that much work.
+#define PARALLEL_GRAIN (1 << 15)
+
+namespace algebra {
+
+#ifndef DISABLE_THREADS
+
+class thread_pool {
+public:
+	static thread_pool& instance()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+	~thread_pool() { stop_workers(); }
+
+	// Number of threads a parallel_for runs on, the caller included.
+	size_t size() const noexcept { return workers_.size() + 1; }
+
+	// Called from inside a task it is ignored: a worker cannot join itself.
+	void resize(size_t n)
+	{
+		n = std::max(n, (size_t) 1);
+		if (n != size() && worker_index() < 0)
+		{
+			stop_workers();
+			start_workers(n - 1);
+		}
+	}
+
+	// It runs f(lo, hi) over consecutive sub-ranges covering [begin, end),
+	// each at least 'grain' long, and returns once all of them are done.
+	// The first exception thrown by f is rethrown here.
+	template <class F>
+	void parallel_for(size_t begin, size_t end, size_t grain, const F& f)
+	{
+		size_t n = end - begin;
+		grain = std::max(grain, (size_t) 1);
+		if (end <= begin || n <= grain || workers_.empty())
+		{
+			if (end > begin) { f(begin, end); }
+			return;
+		}
+
+		// A few chunks per thread leave room for stealing when the
+		// chunks do not cost the same (e.g. triangular loops).
+		size_t chunks = std::min((n + grain - 1)/grain, 4*size());
+		size_t step = (n + chunks - 1)/chunks;
+		chunks = (n + step - 1)/step;
+
+		task_group group(chunks);
+		std::vector<task> tasks(chunks);
+		size_t c;
+		for (c = 0; c < chunks; c++)
+		{
+			tasks[c].run = &invoke<F>;
+			tasks[c].f = &f;
+			tasks[c].lo = begin + c*step;
+			tasks[c].hi = std::min(begin + (c + 1)*step, end);
+			tasks[c].group = &group;
+		}
+
+		// The caller keeps the first chunk for itself.
+		for (c = chunks; --c;)
+		{
+			push(&tasks[c]);
+		}
+		execute(&tasks[0]);
+
+		while (group.pending.load(std::memory_order_acquire) != 0)
+		{
+			task* t = pop();
+			if (t != nullptr)
+			{
+				execute(t);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+		if (group.error)
+		{
+			std::rethrow_exception(group.error);
+		}
+	}
+
+private:
+	struct task_group
+	{
+		explicit task_group(size_t n) : pending(n) {}
+		std::atomic<size_t> pending;
+		std::mutex error_mutex;
+		std::exception_ptr error;
+	};
+
+	struct task
+	{
+		void (*run)(const void*, size_t, size_t);
+		const void* f;
+		size_t lo, hi;
+		task_group* group;
+	};
+
+	struct work_queue
+	{
+		std::mutex mutex;
+		std::deque<task*> tasks;
+	};
+
+	thread_pool() : queued_(0), next_(0), stop_(false)
+	{
+		size_t n = std::thread::hardware_concurrency();
+		start_workers(n > 1 ? n - 1 : 0);
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	template <class F>
+	static void invoke(const void* f, size_t lo, size_t hi)
+	{
+		(*static_cast<const F*>(f))(lo, hi);
+	}
+
+	// Index of the worker running on this thread, -1 for any other thread.
+	static int& worker_index()
+	{
+		static thread_local int index = -1;
+		return index;
+	}
+
+	void execute(task* t)
+	{
+		try
+		{
+			t->run(t->f, t->lo, t->hi);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(t->group->error_mutex);
+			if (!t->group->error)
+			{
+				t->group->error = std::current_exception();
+			}
+		}
+		t->group->pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	// A worker pushes onto its own deque; any other thread spreads its
+	// tasks over the deques in turn.
+	void push(task* t)
+	{
+		int self = worker_index();
+		size_t q = self >= 0 ? (size_t) self : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+		// Counted before it is queued, so that queued_ never drops below
+		// the number of tasks in the deques.
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			queued_++;
+		}
+		{
+			std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+			queues_[q]->tasks.push_back(t);
+		}
+		wake_.notify_one();
+	}
+
+	// It returns the newest task of the own deque, else the oldest task
+	// of another deque, else nullptr.
+	task* pop()
+	{
+		int self = worker_index();
+		size_t i, n = queues_.size();
+		size_t first = self >= 0 ? (size_t) self : next_.load(std::memory_order_relaxed) % n;
+		for (i = 0; i < n; i++)
+		{
+			size_t q = (first + i) % n;
+			std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+			std::deque<task*>& tasks = queues_[q]->tasks;
+			if (!tasks.empty())
+			{
+				task* t;
+				if ((int) q == self)
+				{
+					t = tasks.back();
+					tasks.pop_back();
+				}
+				else
+				{
+					t = tasks.front();
+					tasks.pop_front();
+				}
+				std::lock_guard<std::mutex> sleep_lock(sleep_mutex_);
+				queued_--;
+				return t;
+			}
+		}
+		return nullptr;
+	}
+
+	void work(int index)
+	{
+		worker_index() = index;
+		while (true)
+		{
+			task* t = pop();
+			if (t != nullptr)
+			{
+				execute(t);
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleep_mutex_);
+			wake_.wait(lock, [this]{ return stop_ || queued_ > 0; });
+			if (stop_)
+			{
+				return;
+			}
+		}
+	}
+
+	void start_workers(size_t n)
+	{
+		size_t i;
+		stop_ = false;
+		queues_.clear();
+		for (i = 0; i < n; i++)
+		{
+			queues_.emplace_back(new work_queue);
+		}
+		for (i = 0; i < n; i++)
+		{
+			workers_.emplace_back(&thread_pool::work, this, (int) i);
+		}
+	}
+
+	void stop_workers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for (std::thread& worker : workers_)
+		{
+			worker.join();
+		}
+		workers_.clear();
+	}
+
+	std::vector<std::thread> workers_;
+	std::vector< std::unique_ptr<work_queue> > queues_;
+	std::mutex sleep_mutex_;
+	std::condition_variable wake_;
+	size_t queued_;
+	std::atomic<size_t> next_;
+	bool stop_;
+};
+
+// It sets the number of threads the kernels run on (at least 1).
+inline void set_num_threads(size_t n)
+{
+	thread_pool::instance().resize(n);
+}
+
+// It returns the number of threads the kernels run on.
+inline size_t get_num_threads()
+{
+	return thread_pool::instance().size();
+}
+
+// It runs f(lo, hi) on sub-ranges of [begin, end) of at least 'grain'
+// elements, in parallel when the range is long enough.
+template <class F>
+inline void parallel_for(size_t begin, size_t end, size_t grain, const F& f)
+{
+	thread_pool::instance().parallel_for(begin, end, grain, f);
+}
+
+#else
+
+inline void set_num_threads(size_t) {}
+
+inline size_t get_num_threads() { return 1; }
+
+template <class F>
+inline void parallel_for(size_t begin, size_t end, size_t, const F& f)
+{
+	if (end > begin) { f(begin, end); }
+}
+
+#endif /* DISABLE_THREADS */
+
+} /* namespace algebra */
+
+#endif /* THREAD_POOL_H_ */
@@ -0,0 +1,153 @@
+/*============================================================================
+ * Name         : transpose.h implements the blocked out-of-place transpose
+ *                of a row-major matrix, and the in-place transposes of
+ *                square (blocked swaps) and rectangular (cycle following)
+ *                matrices. They are the kernels behind transpose() and
+ *                inplace_transpose().
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+#ifndef TRANSPOSE_KERNEL_H_
+#define TRANSPOSE_KERNEL_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <algorithm>    // std::min, std::swap
+
+#include "thread_pool.h"
+
+// Rows of the source transposed together by transpose_kernel(). Every
+// column of such a band is written as one contiguous run of the
+// destination, and the strided reads of a band stay within the TLB.
+#define TRANSPOSE_BAND 256
+// Edge of the tiles swapped by transpose_square_inplace().
+#define TRANSPOSE_BLOCK 32
+
+namespace algebra {
+
+// It writes the transpose of rows r0..r1-1 of the rows x cols matrix src
+// to columns r0..r1-1 of dst: dst(j,i) = src(i,j).
+template <class T>
+inline void transpose_band(size_t r0, size_t r1, size_t cols,
+		const T* src, size_t lds, T* dst, size_t ldd)
+{
+	size_t i, j;
+	for (j = 0; j < cols; j++)
+	{
+		T* d = dst + j*ldd;
+		const T* s = src + j;
+		for (i = r0; i < r1; i++)
+		{
+			d[i] = s[i*lds];
+		}
+	}
+}
+
+// It writes the transpose of the rows x cols matrix src to dst (cols x
+// rows). Read element by element, the source would be walked down its
+// columns with a page-sized stride; it is read in bands of TRANSPOSE_BAND
+// rows instead, which fill disjoint columns of dst and are transposed in
+// parallel.
+template <class T>
+inline void transpose_kernel(size_t rows, size_t cols, const T* src, size_t lds, T* dst, size_t ldd)
+{
+	if (rows == 0 || cols == 0)
+	{
+		return;
+	}
+	const size_t bands = (rows + TRANSPOSE_BAND - 1)/TRANSPOSE_BAND;
+	parallel_for(0, bands, PARALLEL_GRAIN/(TRANSPOSE_BAND*cols) + 1, [=](size_t lo, size_t hi)
+	{
+		size_t b;
+		for (b = lo; b < hi; b++)
+		{
+			transpose_band(b*TRANSPOSE_BAND, std::min(rows, (b + 1)*TRANSPOSE_BAND), cols, src, lds, dst, ldd);
+		}
+	});
+}
+
+// It transposes the n x n matrix a in place. Every tile above the
+// diagonal is swapped with the transpose of its mirror tile; the pairs
+// of a band of tile rows are disjoint from those of any other band.
+template <class T>
+inline void transpose_square_inplace(size_t n, T* a, size_t lda)
+{
+	const size_t NB = TRANSPOSE_BLOCK;
+	const size_t tiles = (n + NB - 1)/NB;
+	parallel_for(0, tiles, std::max((size_t) 1, PARALLEL_GRAIN/(n*NB + 1)), [=](size_t lo, size_t hi)
+	{
+		size_t bi, bj, i, j;
+		for (bi = lo; bi < hi; bi++)
+		{
+			const size_t i0 = bi*NB, i1 = std::min(n, i0 + NB);
+			for (bj = bi; bj < tiles; bj++)
+			{
+				const size_t j0 = bj*NB, j1 = std::min(n, j0 + NB);
+				for (i = i0; i < i1; i++)
+				{
+					for (j = (bi == bj) ? i + 1 : j0; j < j1; j++)
+					{
+						std::swap(a[i*lda + j], a[j*lda + i]);
+					}
+				}
+			}
+		}
+	});
+}
+
+// It transposes the contiguous rows x cols matrix a in place. The element
+// at position i*cols + j moves to j*rows + i; the permutation is applied
+// cycle by cycle, marking the visited positions in a bit vector (one bit
+// per element instead of a second copy).
+template <class T>
+inline void transpose_rect_inplace(size_t rows, size_t cols, T* a)
+{
+	const size_t n = rows*cols;
+	if (rows <= 1 || cols <= 1)
+	{
+		return;
+	}
+	std::vector<bool> visited(n);
+	size_t start, cur, next;
+	for (start = 1; start + 1 < n; start++)
+	{
+		if (visited[start])
+		{
+			continue;
+		}
+		T carry = a[start];
+		cur = start;
+		do
+		{
+			next = (cur % cols)*rows + cur/cols;
+			std::swap(a[next], carry);
+			visited[next] = true;
+			cur = next;
+		} while (cur != start);
+	}
+}
+
+} /* namespace algebra */
+
+#endif /* TRANSPOSE_KERNEL_H_ */
@@ -0,0 +1,763 @@
+/*============================================================================
+ * Name         : mapped_mat.h implements MappedMat, a matrix stored in a
+ *                memory-mapped file in square tiles, and the tile-at-a-time
+ *                product, transpose and element-wise operations on it, for
+ *                matrices that do not fit in memory.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* A 100000 x 100000 matrix of doubles takes 80 GB; as a MappedMat it lives
+ * in a file and only the tiles being worked on are in memory:
+ *
+ *     MappedMat<double> a("a.bin", n, n), b("b.bin", n, n), c("c.bin", n, n);
+ *     a.copy_from(...);  a.tile(0, 3) = ...;   // fill it tile by tile
+ *     multiply(a, b, c);                       // c = a*b
+ *     transpose(a, b);                         // b = a'
+ *     add(a, c, c);                            // c = a + c
+ *     MappedMat<double> d("c.bin", false);     // reopens a file read-only
+ *     Mat<double> t(d.ctile(1, 2));            // copies a tile of it
+ *
+ * The file holds a header page followed by the tiles in row-major order of
+ * tiles; every tile is tile() x tile() elements, row-major, the edge tiles
+ * padded with zeros. A tile is therefore a contiguous block of the file
+ * and tile(bi, bj) and ctile(bi, bj) return it as a MatView, so that the
+ * expressions and kernels of Mat work on it unchanged.
+ *
+ * The tiles touched through tile() are tracked in a least-recently-used
+ * list of cache_size() Bytes: a new tile is prefetched (MADV_WILLNEED), and
+ * once the list is full the oldest one is unmapped from the process
+ * (MADV_DONTNEED), its modified pages queued for write-back. The mapping is
+ * shared, so a dropped tile is found again in the page cache, or read back
+ * from the file, on its next access. The cache bounds the resident set of
+ * the process, not the page cache, which the kernel manages as usual; it
+ * never decides what is correct. The mapping is not charged to the memory
+ * budget of Vec and Mat.
+ */
+
+#ifndef MAPPED_MAT_H_
+#define MAPPED_MAT_H_
+
+#include <stddef.h>     // size_t
+#include <stdint.h>     // uint32_t, uint64_t
+#include <string.h>     // memcpy, memcmp, strerror
+#include <errno.h>
+#include <fcntl.h>      // open
+#include <unistd.h>     // close, ftruncate, sysconf
+#include <sys/mman.h>   // mmap, madvise, msync
+#include <sys/stat.h>   // fstat
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <memory>       // std::unique_ptr
+#include <algorithm>    // std::min, std::max
+#include <limits>
+#include <stdexcept>
+
+#include "mat.h"
+#include "kernels/transpose.h"
+
+// Default edge of the tiles of a MappedMat (8 MiB for double).
+#define MAPPED_TILE 1024
+// Default Bytes of tiles a MappedMat keeps resident.
+#define MAPPED_CACHE_SIZE (1ul << 30)
+// Bytes reserved for the header at the start of the file.
+#define MAPPED_HEADER_SIZE 4096
+#define MAPPED_VERSION 1
+
+namespace algebra {
+
+// The header page of a MappedMat file.
+struct mapped_header {
+	char magic[8];          // "LAMAPMAT"
+	uint32_t version;
+	uint32_t elem_size;     // sizeof(T)
+	uint64_t rows;
+	uint64_t cols;
+	uint64_t tile;
+};
+
+static const char MAPPED_MAGIC[8] = { 'L', 'A', 'M', 'A', 'P', 'M', 'A', 'T' };
+
+inline std::runtime_error mapped_io_error(const std::string& where, const std::string& path)
+{
+	std::string msg = FILE_LINE_ERROR + " exception in " + where + ": " + path + ": " + strerror(errno);
+	log_error(msg.c_str());
+	return std::runtime_error(msg);
+}
+
+template <class T>
+class MappedMat {
+public:
+	typedef T value_type;
+
+	// It creates (or truncates) the file path for a rows x cols matrix of
+	// zeros with tiles of tile x tile elements.
+	MappedMat(const std::string& path, size_t rows, size_t cols, size_t tile = MAPPED_TILE);
+	// It maps the existing file path, read-only unless writable is set.
+	explicit MappedMat(const std::string& path, bool writable = true);
+	MappedMat(const MappedMat<T>&) = delete;
+	MappedMat(MappedMat<T>&&) noexcept;
+	~MappedMat();
+
+	MappedMat<T>& operator=(const MappedMat<T>&) = delete;
+	MappedMat<T>& operator=(MappedMat<T>&&) noexcept;
+
+	size_t rows() const noexcept { return rows_; }
+	size_t cols() const noexcept { return cols_; }
+	size_t size() const noexcept { return rows_*cols_; }
+	size_t tile() const noexcept { return tile_; }
+	size_t row_tiles() const noexcept { return row_tiles_; }
+	size_t col_tiles() const noexcept { return col_tiles_; }
+	bool writable() const noexcept { return writable_; }
+	const std::string& path() const noexcept { return path_; }
+
+	// Element access, for the odd element; it bypasses the tile cache.
+	T operator()(size_t i, size_t j) const;
+	void set(size_t i, size_t j, T value);
+
+	// The tile (bi, bj), rows bi*tile()... and columns bj*tile()... of the
+	// matrix, without the padding of the edge tiles. The writable view needs
+	// a writable file; ctile() reads a tile of any file.
+	MatView<T> tile(size_t bi, size_t bj);
+	MatView<const T> tile(size_t bi, size_t bj) const;
+	MatView<const T> ctile(size_t bi, size_t bj) const { return tile(bi, bj); }
+	// It asks the kernel to start reading the tile (bi, bj).
+	void prefetch(size_t bi, size_t bj) const;
+
+	// A moved-from MappedMat has no cache: its size and tiles are 0 until
+	// set_cache_size() gives it a new one.
+	void set_cache_size(size_t bytes);
+	size_t cache_size() const noexcept { return cache_ ? cache_->capacity*tile_bytes() : 0; }
+	size_t cached_tiles() const;
+
+	void fill(T value);
+	void copy_from(const Mat<T>& m);
+	Mat<T> to_mat() const;
+	// It writes the modified pages back to the file and waits for them.
+	void flush();
+
+private:
+	struct tile_cache {
+		std::mutex mutex;
+		std::list<size_t> lru;      // most recently used first
+		std::unordered_map<size_t, std::list<size_t>::iterator> where;
+		size_t capacity;
+	};
+
+	bool layout(size_t rows, size_t cols, size_t tile) noexcept;
+	void map(const std::string& where);
+	void unmap() noexcept;
+	void check_tile(size_t bi, size_t bj, const char* function) const;
+	void check_writable(const char* function) const;
+	void touch(size_t t) const;
+	void advise(size_t t, int advice) const noexcept;
+
+	size_t tile_bytes() const noexcept { return tile_*tile_*sizeof(T); }
+	T* tile_data(size_t t) const noexcept
+	{
+		return reinterpret_cast<T*>(map_ + MAPPED_HEADER_SIZE) + t*tile_*tile_;
+	}
+	const T* base() const noexcept { return reinterpret_cast<const T*>(map_ + MAPPED_HEADER_SIZE); }
+
+	std::string path_;
+	int fd_;
+	char* map_;
+	size_t bytes_;
+	size_t rows_;
+	size_t cols_;
+	size_t tile_;
+	size_t row_tiles_;
+	size_t col_tiles_;
+	bool writable_;
+	std::unique_ptr<tile_cache> cache_;
+};
+
+typedef MappedMat<double> mapped_mat;
+
+template <class T>
+MappedMat<T>::MappedMat(const std::string& path, size_t rows, size_t cols, size_t tile) :
+	path_(path), fd_(-1), map_(nullptr), bytes_(0), rows_(rows), cols_(cols), tile_(tile),
+	row_tiles_(0), col_tiles_(0), writable_(true), cache_(new tile_cache)
+{
+	const std::string where = "mapped_mat::mapped_mat(const std::string& path, size_t rows, size_t cols, size_t tile)";
+	if (tile == 0)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + where + ": the tile size must be positive";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	if (!layout(rows, cols, tile))
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + where + ": the matrix does not fit in a file";
+		log_error(msg.c_str());
+		throw std::length_error(msg);
+	}
+
+	fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd_ < 0)
+	{
+		throw mapped_io_error(where, path);
+	}
+	// The file is extended without writing it: the tiles start as holes
+	// that read as zeros.
+	if (ftruncate(fd_, (off_t) bytes_) != 0)
+	{
+		std::runtime_error e = mapped_io_error(where, path);
+		unmap();
+		throw e;
+	}
+	map(where);
+
+	mapped_header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, MAPPED_MAGIC, sizeof(h.magic));
+	h.version = MAPPED_VERSION;
+	h.elem_size = sizeof(T);
+	h.rows = rows;
+	h.cols = cols;
+	h.tile = tile;
+	memcpy(map_, &h, sizeof(h));
+	set_cache_size(MAPPED_CACHE_SIZE);
+}
+
+template <class T>
+MappedMat<T>::MappedMat(const std::string& path, bool writable) :
+	path_(path), fd_(-1), map_(nullptr), bytes_(0), rows_(0), cols_(0), tile_(0),
+	row_tiles_(0), col_tiles_(0), writable_(writable), cache_(new tile_cache)
+{
+	const std::string where = "mapped_mat::mapped_mat(const std::string& path, bool writable)";
+	fd_ = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+	if (fd_ < 0)
+	{
+		throw mapped_io_error(where, path);
+	}
+	struct stat st;
+	mapped_header h;
+	if (fstat(fd_, &st) != 0 || pread(fd_, &h, sizeof(h), 0) != (ssize_t) sizeof(h))
+	{
+		std::runtime_error e = mapped_io_error(where, path);
+		unmap();
+		throw e;
+	}
+	std::string error;
+	if (memcmp(h.magic, MAPPED_MAGIC, sizeof(h.magic)) != 0 || h.version != MAPPED_VERSION)
+	{
+		error = "not a mapped matrix file";
+	}
+	else if (h.elem_size != sizeof(T) || h.tile == 0)
+	{
+		error = "the element type does not match the file";
+	}
+	else
+	{
+		rows_ = h.rows;
+		cols_ = h.cols;
+		tile_ = h.tile;
+		if (!layout(rows_, cols_, tile_))
+		{
+			error = "the dimensions in the header do not fit in a file";
+		}
+		else if ((size_t) st.st_size < bytes_)
+		{
+			error = "the file is shorter than its header says";
+		}
+	}
+	if (!error.empty())
+	{
+		unmap();
+		std::string msg = FILE_LINE_ERROR + " exception in " + where + ": " + path + ": " + error;
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	map(where);
+	set_cache_size(MAPPED_CACHE_SIZE);
+}
+
+// It sets the number of tiles and the size of the file for a rows x cols
+// matrix with tiles of tile x tile elements; it returns false, and leaves
+// them unset, when the file would be larger than a size_t can count.
+template <class T>
+bool MappedMat<T>::layout(size_t rows, size_t cols, size_t tile) noexcept
+{
+	const size_t max = std::numeric_limits<size_t>::max();
+	const size_t row_tiles = rows/tile + (rows % tile != 0);
+	const size_t col_tiles = cols/tile + (cols % tile != 0);
+	if (tile > max/tile/sizeof(T) || (row_tiles && col_tiles > max/row_tiles)
+			|| row_tiles*col_tiles > (max - MAPPED_HEADER_SIZE)/(tile*tile*sizeof(T)))
+	{
+		return false;
+	}
+	row_tiles_ = row_tiles;
+	col_tiles_ = col_tiles;
+	bytes_ = MAPPED_HEADER_SIZE + row_tiles*col_tiles*tile*tile*sizeof(T);
+	return true;
+}
+
+template <class T>
+MappedMat<T>::MappedMat(MappedMat<T>&& m) noexcept :
+	path_(std::move(m.path_)), fd_(m.fd_), map_(m.map_), bytes_(m.bytes_), rows_(m.rows_), cols_(m.cols_),
+	tile_(m.tile_), row_tiles_(m.row_tiles_), col_tiles_(m.col_tiles_), writable_(m.writable_),
+	cache_(std::move(m.cache_))
+{
+	m.fd_ = -1;
+	m.map_ = nullptr;
+	m.bytes_ = m.rows_ = m.cols_ = m.row_tiles_ = m.col_tiles_ = 0;
+}
+
+template <class T>
+MappedMat<T>& MappedMat<T>::operator=(MappedMat<T>&& m) noexcept
+{
+	if (this != &m)
+	{
+		unmap();
+		path_ = std::move(m.path_);
+		fd_ = m.fd_;
+		map_ = m.map_;
+		bytes_ = m.bytes_;
+		rows_ = m.rows_;
+		cols_ = m.cols_;
+		tile_ = m.tile_;
+		row_tiles_ = m.row_tiles_;
+		col_tiles_ = m.col_tiles_;
+		writable_ = m.writable_;
+		cache_ = std::move(m.cache_);
+		m.fd_ = -1;
+		m.map_ = nullptr;
+		m.bytes_ = m.rows_ = m.cols_ = m.row_tiles_ = m.col_tiles_ = 0;
+	}
+	return *this;
+}
+
+template <class T>
+MappedMat<T>::~MappedMat()
+{
+	unmap();
+}
+
+template <class T>
+void MappedMat<T>::map(const std::string& where)
+{
+	void* p = mmap(nullptr, bytes_, writable_ ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd_, 0);
+	if (p == MAP_FAILED)
+	{
+		std::runtime_error e = mapped_io_error(where, path_);
+		unmap();
+		throw e;
+	}
+	map_ = static_cast<char*>(p);
+}
+
+template <class T>
+void MappedMat<T>::unmap() noexcept
+{
+	if (map_)
+	{
+		munmap(map_, bytes_);
+		map_ = nullptr;
+	}
+	if (fd_ >= 0)
+	{
+		::close(fd_);
+		fd_ = -1;
+	}
+}
+
+template <class T>
+T MappedMat<T>::operator()(size_t i, size_t j) const
+{
+	if (i >= rows_ || j >= cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mapped_mat::operator()(size_t i, size_t j): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return tile_data((i/tile_)*col_tiles_ + j/tile_)[(i % tile_)*tile_ + j % tile_];
+}
+
+template <class T>
+void MappedMat<T>::set(size_t i, size_t j, T value)
+{
+	if (i >= rows_ || j >= cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mapped_mat::set(size_t i, size_t j, T value): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	check_writable("mapped_mat::set(size_t i, size_t j, T value)");
+	tile_data((i/tile_)*col_tiles_ + j/tile_)[(i % tile_)*tile_ + j % tile_] = value;
+}
+
+// A read-only file is mapped without PROT_WRITE: writing to it would fault.
+template <class T>
+void MappedMat<T>::check_writable(const char* function) const
+{
+	if (!writable_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": the file is mapped read-only";
+		log_error(msg.c_str());
+		throw std::logic_error(msg);
+	}
+}
+
+template <class T>
+void MappedMat<T>::check_tile(size_t bi, size_t bj, const char* function) const
+{
+	if (bi >= row_tiles_ || bj >= col_tiles_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": tile index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+}
+
+template <class T>
+MatView<T> MappedMat<T>::tile(size_t bi, size_t bj)
+{
+	check_tile(bi, bj, "mapped_mat::tile(size_t bi, size_t bj)");
+	check_writable("mapped_mat::tile(size_t bi, size_t bj)");
+	const size_t t = bi*col_tiles_ + bj;
+	touch(t);
+	return MatView<T>(tile_data(t), std::min(tile_, rows_ - bi*tile_), std::min(tile_, cols_ - bj*tile_), tile_, base());
+}
+
+template <class T>
+MatView<const T> MappedMat<T>::tile(size_t bi, size_t bj) const
+{
+	check_tile(bi, bj, "mapped_mat::tile(size_t bi, size_t bj) const");
+	const size_t t = bi*col_tiles_ + bj;
+	touch(t);
+	return MatView<const T>(tile_data(t), std::min(tile_, rows_ - bi*tile_), std::min(tile_, cols_ - bj*tile_), tile_, base());
+}
+
+template <class T>
+void MappedMat<T>::prefetch(size_t bi, size_t bj) const
+{
+	if (bi < row_tiles_ && bj < col_tiles_)
+	{
+		advise(bi*col_tiles_ + bj, MADV_WILLNEED);
+	}
+}
+
+// It applies advice to the pages of the tile t. The pages shared with a
+// neighbouring tile are prefetched with it, but never dropped with it.
+template <class T>
+void MappedMat<T>::advise(size_t t, int advice) const noexcept
+{
+	static const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+	size_t begin = MAPPED_HEADER_SIZE + t*tile_bytes(), end = begin + tile_bytes();
+	if (advice == MADV_WILLNEED)
+	{
+		begin = begin/page*page;
+		end = std::min(bytes_, (end + page - 1)/page*page);
+	}
+	else
+	{
+		begin = (begin + page - 1)/page*page;
+		end = end/page*page;
+	}
+	if (begin >= end)
+	{
+		return;
+	}
+	if (advice == MADV_DONTNEED && writable_)
+	{
+		// It starts the write-back of the dirty pages; MADV_DONTNEED on a
+		// shared mapping only drops the page table entries, the pages stay
+		// in the page cache until the kernel writes them and reclaims them.
+		msync(map_ + begin, end - begin, MS_ASYNC);
+	}
+	madvise(map_ + begin, end - begin, advice);
+}
+
+// It moves the tile t to the front of the cache, evicting the least
+// recently used tiles beyond its capacity.
+template <class T>
+void MappedMat<T>::touch(size_t t) const
+{
+	std::lock_guard<std::mutex> lock(cache_->mutex);
+	auto it = cache_->where.find(t);
+	if (it != cache_->where.end())
+	{
+		cache_->lru.splice(cache_->lru.begin(), cache_->lru, it->second);
+		return;
+	}
+	advise(t, MADV_WILLNEED);
+	cache_->lru.push_front(t);
+	cache_->where[t] = cache_->lru.begin();
+	while (cache_->lru.size() > cache_->capacity)
+	{
+		advise(cache_->lru.back(), MADV_DONTNEED);
+		cache_->where.erase(cache_->lru.back());
+		cache_->lru.pop_back();
+	}
+}
+
+// It sets the Bytes of tiles kept resident; at least four tiles (the
+// operands of a product and the next one being prefetched) are.
+template <class T>
+void MappedMat<T>::set_cache_size(size_t bytes)
+{
+	if (!cache_)
+	{
+		cache_.reset(new tile_cache);
+	}
+	std::lock_guard<std::mutex> lock(cache_->mutex);
+	cache_->capacity = std::max((size_t) 4, bytes/tile_bytes());
+	while (cache_->lru.size() > cache_->capacity)
+	{
+		advise(cache_->lru.back(), MADV_DONTNEED);
+		cache_->where.erase(cache_->lru.back());
+		cache_->lru.pop_back();
+	}
+}
+
+template <class T>
+size_t MappedMat<T>::cached_tiles() const
+{
+	if (!cache_)
+	{
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(cache_->mutex);
+	return cache_->lru.size();
+}
+
+template <class T>
+void MappedMat<T>::fill(T value)
+{
+	size_t bi, bj;
+	for (bi = 0; bi < row_tiles_; bi++)
+	{
+		for (bj = 0; bj < col_tiles_; bj++)
+		{
+			tile(bi, bj) = value;
+		}
+	}
+}
+
+template <class T>
+void MappedMat<T>::copy_from(const Mat<T>& m)
+{
+	if (m.rows() != rows_ || m.cols() != cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mapped_mat::copy_from(const mat& m): matrix dimensions do not match";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	size_t bi, bj, i;
+	for (bi = 0; bi < row_tiles_; bi++)
+	{
+		for (bj = 0; bj < col_tiles_; bj++)
+		{
+			MatView<T> t = tile(bi, bj);
+			for (i = 0; i < t.rows(); i++)
+			{
+				std::copy_n(m.data() + (bi*tile_ + i)*cols_ + bj*tile_, t.cols(), t.data() + i*tile_);
+			}
+		}
+	}
+}
+
+template <class T>
+Mat<T> MappedMat<T>::to_mat() const
+{
+	Mat<T> m(rows_, cols_);
+	size_t bi, bj, i;
+	for (bi = 0; bi < row_tiles_; bi++)
+	{
+		for (bj = 0; bj < col_tiles_; bj++)
+		{
+			MatView<const T> t = ctile(bi, bj);
+			for (i = 0; i < t.rows(); i++)
+			{
+				std::copy_n(t.data() + i*tile_, t.cols(), m.data() + (bi*tile_ + i)*cols_ + bj*tile_);
+			}
+		}
+	}
+	return m;
+}
+
+template <class T>
+void MappedMat<T>::flush()
+{
+	if (writable_ && map_ && msync(map_, bytes_, MS_SYNC) != 0)
+	{
+		throw mapped_io_error("mapped_mat::flush()", path_);
+	}
+}
+
+// ##################################################################################################
+// ########################################## TILED OPERATIONS ######################################
+
+// It checks that the tiles of a and b line up.
+template <class T>
+void mapped_check_tiles(const MappedMat<T>& a, const MappedMat<T>& b, const char* function)
+{
+	if (a.tile() != b.tile())
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": the matrices have different tile sizes";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+}
+
+template <class T>
+void mapped_check_dims(const MappedMat<T>& a, size_t rows, size_t cols, const char* function)
+{
+	if (a.rows() != rows || a.cols() != cols)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": matrix dimensions do not match";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+}
+
+// It computes c = a*b one tile of c at a time: c(i,j) is the sum over k of
+// a(i,k)*b(k,j), every term a gemm on two tiles read in place from the
+// mappings, while the next pair of tiles is being prefetched.
+template <class T>
+void multiply(const MappedMat<T>& a, const MappedMat<T>& b, MappedMat<T>& c)
+{
+	const char* function = "multiply(const mapped_mat& a, const mapped_mat& b, mapped_mat& c)";
+	if (a.cols() != b.rows())
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": the inner dimensions do not match";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	mapped_check_dims(c, a.rows(), b.cols(), function);
+	mapped_check_tiles(a, b, function);
+	mapped_check_tiles(a, c, function);
+	if (&c == &a || &c == &b)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": the product cannot overwrite an operand";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	const size_t nb = a.tile(), kt = a.col_tiles();
+	size_t bi, bj, bk;
+	for (bi = 0; bi < c.row_tiles(); bi++)
+	{
+		for (bj = 0; bj < c.col_tiles(); bj++)
+		{
+			MatView<T> ct = c.tile(bi, bj);
+			ct = T(0);
+			for (bk = 0; bk < kt; bk++)
+			{
+				if (bk + 1 < kt)
+				{
+					a.prefetch(bi, bk + 1);
+					b.prefetch(bk + 1, bj);
+				}
+				else
+				{
+					a.prefetch(bi + (bj + 1)/c.col_tiles(), 0);
+					b.prefetch(0, (bj + 1) % c.col_tiles());
+				}
+				MatView<const T> at = a.ctile(bi, bk), bt = b.ctile(bk, bj);
+				gemm(ct.rows(), ct.cols(), at.cols(), at.data(), nb, (size_t) 1, bt.data(), nb, (size_t) 1, ct.data(), nb);
+			}
+		}
+	}
+}
+
+// It writes the transpose of a to at: the tile a(i,j), transposed, is the
+// tile at(j,i).
+template <class T>
+void transpose(const MappedMat<T>& a, MappedMat<T>& at)
+{
+	const char* function = "transpose(const mapped_mat& a, mapped_mat& at)";
+	mapped_check_dims(at, a.cols(), a.rows(), function);
+	mapped_check_tiles(a, at, function);
+	if (&a == &at)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": the transpose cannot be computed in place";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	const size_t nb = a.tile();
+	size_t bi, bj;
+	for (bi = 0; bi < a.row_tiles(); bi++)
+	{
+		for (bj = 0; bj < a.col_tiles(); bj++)
+		{
+			a.prefetch(bi + (bj + 1)/a.col_tiles(), (bj + 1) % a.col_tiles());
+			MatView<const T> src = a.ctile(bi, bj);
+			MatView<T> dst = at.tile(bj, bi);
+			transpose_kernel(src.rows(), src.cols(), src.data(), nb, dst.data(), nb);
+		}
+	}
+}
+
+// It evaluates c(i,j) = f(a(i,j), b(i,j)) for every pair of tiles, where f
+// returns an expression of the two tile views; c may be a or b.
+template <class T, class F>
+void mapped_elementwise(const MappedMat<T>& a, const MappedMat<T>& b, MappedMat<T>& c, const F& f, const char* function)
+{
+	mapped_check_dims(b, a.rows(), a.cols(), function);
+	mapped_check_dims(c, a.rows(), a.cols(), function);
+	mapped_check_tiles(a, b, function);
+	mapped_check_tiles(a, c, function);
+	size_t bi, bj;
+	for (bi = 0; bi < c.row_tiles(); bi++)
+	{
+		for (bj = 0; bj < c.col_tiles(); bj++)
+		{
+			const size_t ni = bi + (bj + 1)/c.col_tiles(), nj = (bj + 1) % c.col_tiles();
+			a.prefetch(ni, nj);
+			b.prefetch(ni, nj);
+			MatView<T> ct = c.tile(bi, bj);
+			ct = f(a.ctile(bi, bj), b.ctile(bi, bj));
+		}
+	}
+}
+
+// It computes c = a + b.
+template <class T>
+void add(const MappedMat<T>& a, const MappedMat<T>& b, MappedMat<T>& c)
+{
+	mapped_elementwise(a, b, c, [](const MatView<const T>& x, const MatView<const T>& y) { return x + y; },
+			"add(const mapped_mat& a, const mapped_mat& b, mapped_mat& c)");
+}
+
+// It computes c = a - b.
+template <class T>
+void subtract(const MappedMat<T>& a, const MappedMat<T>& b, MappedMat<T>& c)
+{
+	mapped_elementwise(a, b, c, [](const MatView<const T>& x, const MatView<const T>& y) { return x - y; },
+			"subtract(const mapped_mat& a, const mapped_mat& b, mapped_mat& c)");
+}
+
+// It computes c = s*a.
+template <class T>
+void scale(const MappedMat<T>& a, T s, MappedMat<T>& c)
+{
+	mapped_elementwise(a, a, c, [s](const MatView<const T>& x, const MatView<const T>&) { return x*s; },
+			"scale(const mapped_mat& a, T s, mapped_mat& c)");
+}
+
+} /* namespace algebra */
+
+#endif /* MAPPED_MAT_H_ */
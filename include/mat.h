@@ -30,6 +30,9 @@
 
 
 #include "vec.h"
+#include "kernels/gemm.h"
+#include "kernels/lu.h"
+#include "kernels/strassen.h"
 
 // The absolute value of the determinant should be
 // above that threshold to consider a matrix invertible.
@@ -44,28 +47,29 @@ template<class T> class Mat;
 
 // Declaration of friend functions
 template <class T>
-Mat<T> transpose(const Mat<T>&);
-template <class T>
 ivec lup_decompose(Mat<T>&, bool& is_singular);
 template <class T>
-Mat<T> lup_invert(Mat<T>&, const ivec&);
+Mat<T> lup_invert(const Mat<T>&, const ivec&);
 template <class T>
 Mat<T> inv(const Mat<T>&);
 template <class T>
-Mat<T> pinv(Mat<T>&); // pseudoinverse
-template <class T>
-Mat<T> strassen_algorithm(const Mat<T>& , const Mat<T>&, size_t leafsize );
+void inplace_transpose(Mat<T>&);
 template <class T>
 Mat<T> strassen(const Mat<T>&, const Mat<T>& );
 
 
 template <class T>
-class Mat {
+class Mat : public MatExpr< Mat<T> > {
 public:
 	typedef T type;
+	typedef T value_type;
 
 	explicit Mat();
 	Mat(size_t, size_t);
+	Mat(const Mat<T>&);
+	Mat(Mat<T>&&) noexcept;
+	template <class E>
+	Mat(const MatExpr<E>&);
 	~Mat();
 
 	T get(size_t, size_t) const;
@@ -74,6 +78,9 @@ public:
 	size_t rows() const noexcept;
 	size_t cols() const noexcept;
 	size_t size_in_memory() const noexcept; // For debugging purposes
+	size_t ld() const noexcept;
+	T* data() noexcept;
+	const T* data() const noexcept;
 	void set_size(size_t, size_t);
 	void set(size_t, size_t, T);
 	void set_row(size_t, const Vec<T>&);
@@ -90,6 +97,19 @@ public:
 	Mat<T> get(size_t, size_t, size_t, size_t) const;
 	Mat<T> get(const ivec&, const ivec&) const;
 
+	// Views of a block of the matrix; they copy nothing and can be
+	// written through, see view.h.
+	MatView<T> view(size_t, size_t, size_t, size_t);
+	MatView<const T> view(size_t, size_t, size_t, size_t) const;
+	MatView<T> rows_view(size_t, size_t);
+	MatView<const T> rows_view(size_t, size_t) const;
+	MatView<T> cols_view(size_t, size_t);
+	MatView<const T> cols_view(size_t, size_t) const;
+	VecView<T> row_view(size_t);
+	VecView<const T> row_view(size_t) const;
+	VecView<T> col_view(size_t);
+	VecView<const T> col_view(size_t) const;
+
 	void zeros();
 	void clear();
 	void ones();
@@ -101,42 +121,53 @@ public:
 	/********** OVERLOAD OPERATORS ***********/
 	void operator=(const char* a);
 
-	T& operator()(size_t i, size_t j);
-	Mat<T> operator()(size_t r1, size_t r2, size_t c1, size_t c2);
-
-	// overload +
-	// add input matrix to current matrix
-	Mat<T> operator+(const Mat<T>& );
-	Mat<T> operator+(T);
-
-	// overload -
-	// subtract input matrix from current matrix
-	Mat<T> operator-(const Mat<T>&);
-	Mat<T> operator-(T);
+	// Evaluates a matrix expression (e.g. a + b*2.0) in a single pass.
+	// The element-wise operators +, -, * and / by a scalar, and the
+	// product of two matrices are defined as free functions below.
+	template <class E>
+	Mat<T>& operator=(const MatExpr<E>&);
+	// a = transpose(a) is done in place.
+	Mat<T>& operator=(const MatTransposeExpr< Mat<T> >&);
+
+	Mat<T>& operator=(const Mat<T>&);
+	Mat<T>& operator=(Mat<T>&&) noexcept;
+
+	// In-place compound assignments. Apart from *= by a matrix,
+	// they never reallocate.
+	template <class E>
+	Mat<T>& operator+=(const MatExpr<E>&);
+	template <class E>
+	Mat<T>& operator-=(const MatExpr<E>&);
+	template <class E>
+	Mat<T>& operator*=(const MatExpr<E>&);
+	Mat<T>& operator+=(T);
+	Mat<T>& operator-=(T);
+	Mat<T>& operator*=(T);
+	Mat<T>& operator/=(T);
 
-	// overload *
-	// multiply current matrix with scalar
-	Mat<T> operator*(T);
-
-	Mat<T> operator*(const Mat<T>&);
-
-	Vec<T> operator*(const Vec<T>&);
+	T& operator()(size_t i, size_t j);
+	MatView<T> operator()(size_t r1, size_t r2, size_t c1, size_t c2);
+	MatView<const T> operator()(size_t r1, size_t r2, size_t c1, size_t c2) const;
 
-	Mat<T> operator/(T t);
+	// Unchecked element access used by the expression templates.
+	T coeff(size_t i, size_t j) const { return data_[i*cols_ + j]; }
+	bool aliases(const T*) const noexcept { return false; }
+	bool depends_on(const T* p) const noexcept { return data_.data() == p; }
 
 	// Declaration of friend functions
-	friend Mat<T> transpose<>(const Mat<T>&);
 	friend ivec lup_decompose<>(Mat<T>&, bool& is_singular);
-	friend Mat<T> lup_invert<>(Mat<T>&, const ivec&);
+	friend Mat<T> lup_invert<>(const Mat<T>&, const ivec&);
 	friend Mat<T> inv<>(const Mat<T>&);
-	friend Mat<T> pinv<>(Mat<T>&); // pseudoinverse
-	friend Mat<T> strassen_algorithm<T>(const Mat<T>&, const Mat<T>&, size_t leafsize );
+	friend void inplace_transpose<>(Mat<T>&);
 	friend Mat<T> strassen<>(const Mat<T>&, const Mat<T>& );
 
 protected:
 
 private:
-	std::vector< std::vector<T> > data_;
+	// All elements are stored in one contiguous, row-major buffer:
+	// element (i,j) lives at data_[i*cols_ + j]. The buffer is aligned
+	// to MEMORY_ALIGNMENT so that kernels can stream it linearly.
+	std::vector<T, aligned_allocator<T> > data_;
 	size_t rows_ = NaN(size_t);
 	size_t cols_ = NaN(size_t);
 };
@@ -159,7 +190,7 @@ typedef Mat<std::complex<double>> cmat;
 template <class T>
 Mat<T>::Mat()
 {
-	data_.resize(0, std::vector<T> (0));
+	data_.resize(0);
 	rows_ = 0;
 	cols_ = 0;
 }
@@ -167,29 +198,53 @@ Mat<T>::Mat()
 template <class T>
 Mat<T>::Mat(size_t r, size_t c)
 {
-	if (( (r*c) > MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE) )
+	if ( !allocation_fits<T>(r, c) )
 	{
-		std::string msg = FILE_LINE_ERROR + "exception in mat(size_t r, size_t c): (r*c) should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + "exception in mat(size_t r, size_t c): " + allocation_error<T>(r, c);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
-		data_.resize(r, std::vector<T> (c));
+		// One allocation for the whole matrix, zero-initialized.
+		data_.assign(r*c, T(0));
 		rows_ = r;
 		cols_ = c;
-		// Initialization
-		size_t i,j;
-		for (i = r; i--;)
-		{
-			for (j = c; j--;)
-			{
-				data_[i][j] = 0;
-			}
-		}
 	}
 }
 
+// COPY CONSTRUCTOR
+template <class T>
+Mat<T>::Mat(const Mat<T>& m) : data_(m.data_), rows_(m.rows_), cols_(m.cols_) {}
+
+// MOVE CONSTRUCTOR
+// It steals the buffer of m and leaves m as a NULL matrix.
+template <class T>
+Mat<T>::Mat(Mat<T>&& m) noexcept : data_(std::move(m.data_)), rows_(m.rows_), cols_(m.cols_)
+{
+	m.data_.clear();
+	m.rows_ = 0;
+	m.cols_ = 0;
+}
+
+// It evaluates the expression e element by element.
+template <class T>
+template <class E>
+Mat<T>::Mat(const MatExpr<E>& e)
+{
+	const E& expr = e.derived();
+	if ( !allocation_fits<T>(expr.rows(), expr.cols()) )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mat(const MatExpr<E>& e): " + allocation_error<T>(expr.rows(), expr.cols());
+		log_error(msg.c_str());
+		throw std::length_error(msg);
+	}
+	rows_ = expr.rows();
+	cols_ = expr.cols();
+	data_.resize(rows_*cols_);
+	eval_into(data_.data(), expr);
+}
+
 template <class T>
 Mat<T>::~Mat() {}
 
@@ -211,7 +266,7 @@ T Mat<T>::get(size_t r1, size_t c1) const
 	}
 	else
 	{
-		return data_[r1][c1];
+		return data_[r1*cols_ + c1];
 	}
 }
 
@@ -231,35 +286,39 @@ size_t Mat<T>::cols() const noexcept{ return cols_; }
 template <class T>
 size_t Mat<T>::size_in_memory() const noexcept{ return (*this).size()*sizeof(T); }
 
+// It returns the leading dimension of the matrix, i.e. the distance
+// (in elements) between the first elements of two consecutive rows.
+template <class T>
+size_t Mat<T>::ld() const noexcept{ return cols_; }
+
+// It returns a pointer to the first element of the row-major buffer.
+template <class T>
+T* Mat<T>::data() noexcept{ return data_.data(); }
+
+template <class T>
+const T* Mat<T>::data() const noexcept{ return data_.data(); }
+
 // It sets the size of the matrix.
 template <class T>
 void Mat<T>::set_size(size_t r, size_t c)
 {
-	if ( r < 0 || c < 0 || (r*c) >  MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<T>(r, c) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::set_size(size_t r1, size_t c1): (r*c) should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::set_size(size_t r, size_t c): " + allocation_error<T>(r, c);
 		log_error(msg.c_str());
-		throw std::out_of_range(msg);
+		throw std::length_error(msg);
 	}
 	else if ( r == 0 || c == 0 )
 	{
-		data_.resize(0, std::vector<T> (0));
+		data_.resize(0);
 		rows_ = 0;
 		cols_ = 0;
 	}
 	else
 	{
-		data_.resize(r, std::vector<T> (c));
+		data_.assign(r*c, T(0));
 		rows_ = r;
 		cols_ = c;
-		size_t i,j;
-		for (i = r; i--;)
-		{
-			for (j = c; j--;)
-			{
-				data_[i][j] = 0;
-			}
-		}
 	}
 }
 
@@ -275,7 +334,7 @@ void Mat<T>::set(size_t r, size_t c, T value)
 	}
 	else
 	{
-		data_[r][c] = value;
+		data_[r*cols_ + c] = value;
 	}
 }
 
@@ -291,10 +350,11 @@ void Mat<T>::set_row(size_t r, const Vec<T>& v1)
 	}
 	else
 	{
+		T* row = &data_[r*cols_];
 		size_t j;
 		for (j = cols_; j--;)
 		{
-			data_[r][j] = v1.get(j);
+			row[j] = v1.get(j);
 		}
 	}
 }
@@ -314,7 +374,7 @@ void Mat<T>::set_col(size_t c, const Vec<T>& v1)
 		size_t i;
 		for (i = rows_; i--;)
 		{
-			data_[i][c] = v1.get(i);
+			data_[i*cols_ + c] = v1.get(i);
 		}
 	}
 }
@@ -331,13 +391,10 @@ void Mat<T>::set_rows(size_t r0, const Mat<T>& m1)
 	}
 	else
 	{
-		size_t i, j, rows = m1.rows(), cols = m1.cols();
+		size_t i, rows = m1.rows(), cols = m1.cols();
 		for (i = rows; i--;)
 		{
-			for (j = cols; j--;)
-			{
-				data_[i+r0][j] = m1.data_[i][j];
-			}
+			std::copy_n(&m1.data_[i*cols], cols, &data_[(i + r0)*cols_]);
 		}
 	}
 }
@@ -354,13 +411,10 @@ void Mat<T>::set_cols(size_t c0, const Mat<T>& m1)
 	}
 	else
 	{
-		size_t i, j, rows = m1.rows(), cols = m1.cols();
+		size_t i, rows = m1.rows(), cols = m1.cols();
 		for ( i = rows; i--;)
 		{
-			for (j = cols; j--;)
-			{
-				data_[i][j+c0] = m1.data_[i][j];
-			}
+			std::copy_n(&m1.data_[i*cols], cols, &data_[i*cols_ + c0]);
 		}
 	}
 }
@@ -377,13 +431,10 @@ void Mat<T>::set_submatrix(size_t r0, size_t c0, const Mat<T>& m)
 	}
 	else
 	{
-		size_t i, j, rows = m.rows(), cols = m.cols();
+		size_t i, rows = m.rows(), cols = m.cols();
 		for (i = rows; i--;)
 		{
-			for (j = cols; j--;)
-			{
-				data_[i+c0][j+c0] = m.data_[i][j];
-			}
+			std::copy_n(&m.data_[i*cols], cols, &data_[(i + r0)*cols_ + c0]);
 		}
 	}
 }
@@ -404,7 +455,7 @@ Vec<T> Mat<T>::get_col(size_t c) const
 		size_t i;
 		for (i = rows_; i--;)
 		{
-			result.set(i,  data_[i][c]);
+			result.set(i,  data_[i*cols_ + c]);
 		}
 		return result;
 	}
@@ -423,13 +474,10 @@ Mat<T> Mat<T>::get_cols(size_t c1, size_t c2) const
 	else
 	{
 		Mat<T> result(rows_, c2 - c1 + 1);
-		size_t i, j, rows = result.rows(), cols = result.cols();
+		size_t i, rows = result.rows(), cols = result.cols();
 		for (i = rows; i--;)
 		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] = data_[i][j + c1];
-			}
+			std::copy_n(&data_[i*cols_ + c1], cols, &result.data_[i*cols]);
 		}
 		return result;
 	}
@@ -448,10 +496,11 @@ Vec<T> Mat<T>::get_row(size_t r) const
 	else
 	{
 		Vec<T> result(cols_);
+		const T* row = &data_[r*cols_];
 		size_t i;
 		for (i = cols_; i--;)
 		{
-			result.set(i, data_[r][i]);
+			result.set(i, row[i]);
 		}
 		return result;
 	}
@@ -469,15 +518,9 @@ Mat<T> Mat<T>::get_rows(size_t r1, size_t r2) const
 	}
 	else
 	{
+		// The requested rows are contiguous in memory.
 		Mat<T> result(r2 - r1 + 1, cols_);
-		size_t i, j, rows = result.rows(), cols = result.cols();
-		for (i = rows; i--;)
-		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] = data_[i + r1][j];
-			}
-		}
+		std::copy_n(&data_[r1*cols_], result.size(), result.data_.data());
 		return result;
 	}
 }
@@ -501,18 +544,129 @@ Mat<T> Mat<T>::get(size_t r1, size_t r2, size_t c1, size_t c2) const
 	else
 	{
 		Mat<T> result(r2 - r1 + 1, c2 - c1 + 1);
-		size_t i, j, rows = result.rows(), cols = result.cols();
+		size_t i, rows = result.rows(), cols = result.cols();
 		for (i = rows; i--;)
 		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] = data_[i + r1][j + c1];
-			}
+			std::copy_n(&data_[(i + r1)*cols_ + c1], cols, &result.data_[i*cols]);
 		}
 		return result;
 	}
 }
 
+// It returns a view of the block between rows r1, r2 and columns c1, c2.
+// The rows of the block are cols() elements apart in the matrix.
+template <class T>
+MatView<T> Mat<T>::view(size_t r1, size_t r2, size_t c1, size_t c2)
+{
+	if ((*this).size() == 0)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::view(size_t r1, size_t r2, size_t c1, size_t c2): tried to access NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if (r1 >= rows_ || r2 >= rows_ || r1 > r2 || c1 >= cols_ || c2 >= cols_ || c1 > c2)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::view(size_t r1, size_t r2, size_t c1, size_t c2): Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return MatView<T>(data_.data() + r1*cols_ + c1, r2 - r1 + 1, c2 - c1 + 1, cols_, data_.data());
+}
+
+template <class T>
+MatView<const T> Mat<T>::view(size_t r1, size_t r2, size_t c1, size_t c2) const
+{
+	if ((*this).size() == 0)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::view(size_t r1, size_t r2, size_t c1, size_t c2) const: tried to access NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if (r1 >= rows_ || r2 >= rows_ || r1 > r2 || c1 >= cols_ || c2 >= cols_ || c1 > c2)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::view(size_t r1, size_t r2, size_t c1, size_t c2) const: Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return MatView<const T>(data_.data() + r1*cols_ + c1, r2 - r1 + 1, c2 - c1 + 1, cols_, data_.data());
+}
+
+// It returns a view of the rows r1 to r2.
+template <class T>
+MatView<T> Mat<T>::rows_view(size_t r1, size_t r2)
+{
+	return (*this).view(r1, r2, 0, cols_ - 1);
+}
+
+template <class T>
+MatView<const T> Mat<T>::rows_view(size_t r1, size_t r2) const
+{
+	return (*this).view(r1, r2, 0, cols_ - 1);
+}
+
+// It returns a view of the columns c1 to c2.
+template <class T>
+MatView<T> Mat<T>::cols_view(size_t c1, size_t c2)
+{
+	return (*this).view(0, rows_ - 1, c1, c2);
+}
+
+template <class T>
+MatView<const T> Mat<T>::cols_view(size_t c1, size_t c2) const
+{
+	return (*this).view(0, rows_ - 1, c1, c2);
+}
+
+// It returns a view of the r^th row (contiguous).
+template <class T>
+VecView<T> Mat<T>::row_view(size_t r)
+{
+	if (r >= rows_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::row_view(size_t r): Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecView<T>(data_.data() + r*cols_, cols_, 1, data_.data());
+}
+
+template <class T>
+VecView<const T> Mat<T>::row_view(size_t r) const
+{
+	if (r >= rows_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::row_view(size_t r) const: Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecView<const T>(data_.data() + r*cols_, cols_, 1, data_.data());
+}
+
+// It returns a view of the c^th column (stride cols()).
+template <class T>
+VecView<T> Mat<T>::col_view(size_t c)
+{
+	if (c >= cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::col_view(size_t c): Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecView<T>(data_.data() + c, rows_, cols_, data_.data());
+}
+
+template <class T>
+VecView<const T> Mat<T>::col_view(size_t c) const
+{
+	if (c >= cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::col_view(size_t c) const: Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecView<const T>(data_.data() + c, rows_, cols_, data_.data());
+}
+
 // It returns a matrix based on row-indices
 // vector r and column-indices vector c.
 template <class T>
@@ -572,7 +726,7 @@ Mat<T> Mat<T>::get(const ivec& r, const ivec& c) const
 	{
 		for (j = cols; j--;)
 		{
-			result.data_[i][j] = data_[r.get(i)][c.get(j)];
+			result.data_[i*cols + j] = data_[r.get(i)*cols_ + c.get(j)];
 		}
 	}
 	return result;
@@ -582,14 +736,7 @@ Mat<T> Mat<T>::get(const ivec& r, const ivec& c) const
 template <class T>
 void Mat<T>::zeros()
 {
-	size_t i,j;
-	for (i = rows_; i--;)
-	{
-		for (j = cols_; j--;)
-		{
-			data_[i][j] = T(0);
-		}
-	}
+	std::fill(data_.begin(), data_.end(), T(0));
 }
 
 // It sets all elements of matrix to 0.
@@ -600,14 +747,7 @@ void Mat<T>::clear() { zeros(); }
 template <class T>
 void Mat<T>::ones()
 {
-	size_t i,j;
-	for (i = rows_; i--;)
-	{
-		for (j = cols_; j--;)
-		{
-			data_[i][j] = T(1);
-		}
-	}
+	std::fill(data_.begin(), data_.end(), T(1));
 }
 
 // It swaps rows i and j.
@@ -616,9 +756,7 @@ void Mat<T>::swap_rows(size_t i, size_t j)
 {
 	if ( i < rows_ && j < rows_ && i >= 0 && j >= 0 )
 	{
-		Vec<T> tmp = (*this).get_row(i);
-		(*this).set_row(i, (*this).get_row(j));
-		(*this).set_row(j, tmp);
+		std::swap_ranges(&data_[i*cols_], &data_[i*cols_] + cols_, &data_[j*cols_]);
 	}
 	else
 	{
@@ -634,9 +772,11 @@ void Mat<T>::swap_cols(size_t i, size_t j)
 {
 	if ( i < cols_ && j < cols_ && i >= 0 && j >= 0 )
 	{
-		Vec<T> tmp = (*this).get_col(i);
-		(*this).set_col(i, (*this).get_col(j));
-		(*this).set_col(j, tmp);
+		size_t r;
+		for (r = rows_; r--;)
+		{
+			std::swap(data_[r*cols_ + i], data_[r*cols_ + j]);
+		}
 	}
 	else
 	{
@@ -648,449 +788,608 @@ void Mat<T>::swap_cols(size_t i, size_t j)
 
 // ========= Overload basic operators ===========
 // It pass the values of the string in a matrix.
-// The input must be of the form "1 2 3;4 5 6" or "[1 2 3;4 5 6]".
+// The input must be of the form "1 2 3;4 5 6" or "[1 2 3;4 5 6]"; commas
+// may separate the numbers of a row too. The matrix is left unchanged when
+// the input is invalid.
 template <class T>
 void Mat<T>::operator=(const char* a)
 {
-	// Clear matrix from any previous values
-	if( (*this).size() != 0 )
+	// A text without any digit is a null matrix.
+	if ( !strpbrk(a, "0123456789") )
 	{
-		data_.resize(0, std::vector<T> (0));
-		rows_ = 0;
-		cols_ = 0;
+		*this = Mat<T>();
+		return;
 	}
+	literal_parser parser(a, true, "mat::operator=(const char* a)");
+	Mat<T> tmp(parser.rows(), parser.cols());
+	parser.parse(tmp.data());
+	*this = std::move(tmp);
+}
 
-	//Convert input to string
-	std::string str = std::string(a);
-
-	// Remove brackets if there are any.
-	if (str.size() >= 1)
+// It returns the (i, j) element of the matrix.
+template <class T>
+T& Mat<T>::operator()(size_t i, size_t j)
+{
+	if ((*this).size() == 0)
 	{
-		std::string start = str.substr(0,1);
-		std::string end = str.substr(str.size()-1, str.size());
-		if ( start.compare("[") == 0 && end.compare("]") == 0)
-		{
-			str.erase(0,1);
-			str.erase(str.size()-1, str.size());
-		}
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator()(size_t i, size_t j): tried to access NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
 	}
-
-	// If there is no number in the string, consider it a null matrix
-	std::string numbers = "0123456789";
-	if( str.find_first_of(numbers) == std::string::npos ){
-		return;
+	else if ( i < 0 || i >= rows_ || j < 0 || j >= cols_ )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator()(size_t i, size_t j): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
 	}
-
-	std::string delimiter = ";"; // DEFAULT DELIMITER FOR ROWS' SEPARATION
-	size_t pos = 0;
-	std::vector<std::string> row_vector;
-
-	// Store the rows of the matrix in a string vector
-	while ((pos = str.find(delimiter)) != std::string::npos)
+	else
 	{
-		row_vector.push_back(str.substr(0, pos));
-		str.erase(0, pos + delimiter.length());
+		return data_[i*cols_ + j];
 	}
-	row_vector.push_back(str.substr(0, pos));
+}
 
-	// Find row dimension (it's equal to the number of the detected rows stored in the row_vector)
-	size_t mat_row = row_vector.size();
-	// Find column dimension
-	Vec<T> first_row; first_row = row_vector[0].c_str();
-	size_t mat_col = first_row.size();
+// It returns a view of the sub-matrix defined in rows [r1,r2] and cols
+// [c1,c2]; m(r1, r2, c1, c2) = e writes the block in place.
+template <class T>
+MatView<T> Mat<T>::operator()(size_t r1, size_t r2, size_t c1, size_t c2)
+{
+	return (*this).view(r1, r2, c1, c2);
+}
 
-	// Initialize matrix
-	data_.resize(mat_row, std::vector<T> (mat_col));
-	rows_ = mat_row;
-	cols_ = mat_col;
-	size_t i, j;
-	for (i = rows_; i--;)
+template <class T>
+MatView<const T> Mat<T>::operator()(size_t r1, size_t r2, size_t c1, size_t c2) const
+{
+	return (*this).view(r1, r2, c1, c2);
+}
+
+// It evaluates the expression e into the current matrix.
+template <class T>
+template <class E>
+Mat<T>& Mat<T>::operator=(const MatExpr<E>& e)
+{
+	const E& expr = e.derived();
+	if ( expr.aliases(data_.data()) )
 	{
-		for (j = cols_; j--;)
+		// The expression reads this matrix at other positions than the one
+		// being written, e.g. P = (P + transpose(P))*0.5. Evaluate it into
+		// a temporary first.
+		Mat<T> tmp(expr);
+		data_.swap(tmp.data_);
+		rows_ = tmp.rows_;
+		cols_ = tmp.cols_;
+		return *this;
+	}
+	size_t rows = expr.rows(), cols = expr.cols();
+	if ( (rows != 0 && cols > std::numeric_limits<size_t>::max()/rows) || data_.size() != rows*cols )
+	{
+		if ( !allocation_fits<T>(rows, cols) )
 		{
-			data_[i][j] = 0;
+			std::string msg = FILE_LINE_ERROR + " exception in mat::operator=(const MatExpr<E>& e): " + allocation_error<T>(rows, cols);
+			log_error(msg.c_str());
+			throw std::length_error(msg);
 		}
+		data_.resize(rows*cols);
 	}
+	rows_ = rows;
+	cols_ = cols;
+	eval_into(data_.data(), expr);
+	return *this;
+}
 
-	// Check that all the detected row vectors are of equal size,
-	// throw exception otherwise.
-	Vec<T> tmp;
-	for (i = rows_; i--;)
+// It evaluates the transpose of a matrix into the current matrix; the
+// transpose of the current matrix itself needs no temporary.
+template <class T>
+Mat<T>& Mat<T>::operator=(const MatTransposeExpr< Mat<T> >& e)
+{
+	if ( &e.nested() == this )
 	{
-		tmp = row_vector[i].c_str();
-		if(tmp.size() != first_row.size()){
-			std::string msg = FILE_LINE_ERROR + " exception in  mat::operator=(const char* a): rows must be of same length";
+		inplace_transpose(*this);
+		return *this;
+	}
+	size_t rows = e.rows(), cols = e.cols();
+	if ( data_.size() != rows*cols )
+	{
+		if ( !allocation_fits<T>(rows, cols) )
+		{
+			std::string msg = FILE_LINE_ERROR + " exception in mat::operator=(const MatTransposeExpr<mat>& e): " + allocation_error<T>(rows, cols);
 			log_error(msg.c_str());
-			throw std::out_of_range(msg);
-		}else{
-			for (j = cols_; j--;)
-			{
-				data_[i][j] = tmp[j];
-			}
+			throw std::length_error(msg);
 		}
+		data_.resize(rows*cols);
 	}
+	rows_ = rows;
+	cols_ = cols;
+	eval_into(data_.data(), e);
+	return *this;
 }
 
-// It returns the (i, j) element of the matrix.
+// It copies m into the current matrix. The current buffer is
+// reused when it is large enough.
 template <class T>
-T& Mat<T>::operator()(size_t i, size_t j)
+Mat<T>& Mat<T>::operator=(const Mat<T>& m)
 {
-	if ((*this).size() == 0)
+	if ( m.data_.size() > data_.capacity() && !allocation_fits<T>(m.rows_, m.cols_) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator()(size_t i, size_t j): tried to access NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::operator=(const mat& m): " + allocation_error<T>(m.rows_, m.cols_);
+		log_error(msg.c_str());
+		throw std::length_error(msg);
+	}
+	data_ = m.data_;
+	rows_ = m.rows_;
+	cols_ = m.cols_;
+	return *this;
+}
+
+// It takes over the buffer of m and leaves m as a NULL matrix.
+template <class T>
+Mat<T>& Mat<T>::operator=(Mat<T>&& m) noexcept
+{
+	data_.swap(m.data_);
+	rows_ = m.rows_;
+	cols_ = m.cols_;
+	m.data_.clear();
+	m.rows_ = 0;
+	m.cols_ = 0;
+	return *this;
+}
+
+// It adds the matrix expression e to the current matrix.
+template <class T>
+template <class E>
+Mat<T>& Mat<T>::operator+=(const MatExpr<E>& e)
+{
+	const E& expr = e.derived();
+	if ( (*this).size() == 0 || expr.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+=(const mat& m): tried to add NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else if ( i < 0 || i >= rows_ || j < 0 || j >= cols_ )
+	else if ( rows_ != expr.rows() || cols_ != expr.cols() )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator()(size_t i, size_t j): index out of range";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+=(const mat& m): dimension mismatch";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	if ( expr.aliases(data_.data()) )
 	{
-		return data_[i][j];
+		return *this += Mat<T>(expr);
 	}
+	eval_into(data_.data(), MatBinaryExpr<Mat<T>, E, add_op>(*this, expr));
+	return *this;
 }
 
-// It returns a sub-matrix defined in rows [r1,r2] and cols [c1,c2].
-template <class T>
-Mat<T> Mat<T>::operator()(size_t r1, size_t r2, size_t c1, size_t c2)
-{
-	return (*this).get(r1, r2, c1, c2);
-}
-
-// It returns the result of addition of matrix m with the current matrix.
+// It subtracts the matrix expression e from the current matrix.
 template <class T>
-Mat<T> Mat<T>::operator+(const Mat<T>& m)
+template <class E>
+Mat<T>& Mat<T>::operator-=(const MatExpr<E>& e)
 {
-	if ( (*this).size() == 0 || m.size() == 0 )
+	const E& expr = e.derived();
+	if ( (*this).size() == 0 || expr.size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(const mat& m): tried to add NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator-=(const mat& m): tried to subtract NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else if ( rows_ != m.rows() || cols_ != m.cols() )
+	else if ( rows_ != expr.rows() || cols_ != expr.cols() )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(const mat& m): dimension mismatch";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator-=(const mat& m): dimension mismatch";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	if ( expr.aliases(data_.data()) )
 	{
-		Mat<T> result = *this;
-		size_t rows = result.rows(), cols = result.cols(), i = 0, j = 0;
-		for (i = rows; i--;)
-		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] += m.data_[i][j];
-			}
-		}
-		return result;
+		return *this -= Mat<T>(expr);
 	}
+	eval_into(data_.data(), MatBinaryExpr<Mat<T>, E, sub_op>(*this, expr));
+	return *this;
 }
 
-// It adds 't' to each element of the matrix.
+// It multiplies the current matrix with the matrix expression e.
+// The product needs a new buffer, which then replaces the current one.
 template <class T>
-Mat<T> Mat<T>::operator+(T t)
+template <class E>
+Mat<T>& Mat<T>::operator*=(const MatExpr<E>& e)
+{
+	*this = *this * e;
+	return *this;
+}
+
+// It adds 't' to each element of the current matrix.
+template <class T>
+Mat<T>& Mat<T>::operator+=(T t)
 {
 	if ( (*this).size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(double t): tried to add NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+=(double t): tried to add NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	size_t i;
+	for (i = data_.size(); i--;)
 	{
-		Mat<T> result = *this;
-		size_t rows = result.rows(), cols = result.cols(), i = 0, j = 0;
-		for (i = rows; i--;)
-		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] += t;
-			}
-		}
-		return result;
+		data_[i] += t;
 	}
+	return *this;
 }
 
-// It returns the result of subtraction of matrix m from the current matrix.
+// It subtracts 't' from each element of the current matrix.
 template <class T>
-Mat<T> Mat<T>::operator-(const Mat<T>& m)
+Mat<T>& Mat<T>::operator-=(T t)
 {
-	if ( (*this).size() == 0 || m.size() == 0 )
+	if ( (*this).size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator-(const mat& m): tried to subtract NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator-=(double t): tried to subtract NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else if ( rows_ != m.rows() || cols_ != m.cols() )
+	size_t i;
+	for (i = data_.size(); i--;)
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator-(const mat& m): dimension mismatch";
-		log_error(msg.c_str());
-		throw std::out_of_range(msg);
+		data_[i] -= t;
 	}
-	else
+	return *this;
+}
+
+// It multiplies each element of the current matrix with 't'.
+template <class T>
+Mat<T>& Mat<T>::operator*=(T t)
+{
+	if ( (*this).size() == 0 )
 	{
-		Mat<T> result = *this;
-		size_t rows = result.rows(), cols = result.cols(), i = 0, j = 0;
-		for (i = rows; i--;)
-		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] -= m.data_[i][j];
-			}
-		}
-		return result;
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*=(double t): tried to multiply NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
 	}
+	simd_scale(data_.size(), data_.data(), t, data_.data());
+	return *this;
 }
 
-// It subtracts 't' from each element of the current matrix.
+// It devides each element of the current matrix by 't'.
 template <class T>
-Mat<T> Mat<T>::operator-(T t)
+Mat<T>& Mat<T>::operator/=(T t)
 {
 	if ( (*this).size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(double t): tried to subtract NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator/=(double t): tried to divide NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	else if ( t == T(0) ){
+		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in operator/=(T t): DIVISION BY ZERO ";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	size_t i;
+	for (i = data_.size(); i--;)
 	{
-		Mat<T> result = *this;
-		size_t rows = result.rows(), cols = result.cols(), i = 0, j = 0;
-		for (i = rows; i--;)
-		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] -= t;
-			}
-		}
-		return result;
+		data_[i] /= t;
 	}
+	return *this;
 }
 
-// It multiplies each element of the matrix with 't'.
-template <class T>
-Mat<T> Mat<T>::operator*(T t)
+// ========= Element-wise operators (see expr.h) ===========
+// They check the operands and return an unevaluated expression.
+
+// It adds matrices l and r.
+template <class L, class R>
+inline MatBinaryExpr<L, R, add_op> operator+(const MatExpr<L>& l, const MatExpr<R>& r)
 {
-	if ( (*this).size() == 0 )
+	const L& m1 = l.derived();
+	const R& m2 = r.derived();
+	if ( m1.size() == 0 || m2.size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(double t): tried to multiply NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(const mat& m): tried to add NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	else if ( m1.rows() != m2.rows() || m1.cols() != m2.cols() )
 	{
-		Mat result = *this;
-		size_t rows = result.rows(), cols = result.cols(), i = 0, j = 0;
-		for (i = rows; i--;)
-		{
-			for (j = cols; j--;)
-			{
-				result.data_[i][j] *= t;
-			}
-		}
-		return result;
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(const mat& m): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
 	}
+	return MatBinaryExpr<L, R, add_op>(m1, m2);
 }
 
-// It multiplies matrix m with the current matrix.
-template <class T>
-Mat<T> Mat<T>::operator*(const Mat<T>& m)
+// It adds 't' to each element of the matrix.
+template <class E>
+inline MatScalarExpr<E, add_op> operator+(const MatExpr<E>& e, const typename E::value_type& t)
 {
-	if ( (*this).size() == 0 || m.size() == 0 )
+	if ( e.derived().size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const mat& m): tried to multiply NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(double t): tried to add NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else if ( cols_ != m.rows() )
+	return MatScalarExpr<E, add_op>(e.derived(), t);
+}
+
+// It subtracts matrix r from matrix l.
+template <class L, class R>
+inline MatBinaryExpr<L, R, sub_op> operator-(const MatExpr<L>& l, const MatExpr<R>& r)
+{
+	const L& m1 = l.derived();
+	const R& m2 = r.derived();
+	if ( m1.size() == 0 || m2.size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const mat& m): dimension mismatch";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator-(const mat& m): tried to subtract NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	else if ( m1.rows() != m2.rows() || m1.cols() != m2.cols() )
 	{
-		Mat<T> result(rows_, m.cols());
-		size_t rows = result.rows(), cols = result.cols(), i = 0, j = 0, k = 0;
-		size_t common_dimension = cols_;
-		T tmp = T(0);
-		for (i = rows; i--;)
-		{
-			for (k = common_dimension; k--;)
-			{
-				tmp = data_[i][k];
-				for (j = cols; j--;)
-				{
-					result.data_[i][j] += tmp * m.data_[k][j];
-				}
-			}
-		}
-		return result;
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator-(const mat& m): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
 	}
+	return MatBinaryExpr<L, R, sub_op>(m1, m2);
 }
 
-// It multiplies vector v with the current matrix.
-template <class T>
-Vec<T> Mat<T>::operator*(const Vec<T>& v){
-	//convert vec into an v.size()x1 matrix depending
-	// a similar multiplication should exist in vec class
-	if ( (*this).size() == 0 || v.size() == 0 )
+// It subtracts 't' from each element of the matrix.
+template <class E>
+inline MatScalarExpr<E, sub_op> operator-(const MatExpr<E>& e, const typename E::value_type& t)
+{
+	if ( e.derived().size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const vec& v): tried to multiply NULL MATRIX or NULL VECTOR";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator+(double t): tried to subtract NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else if ( cols_ != v.size() )
+	return MatScalarExpr<E, sub_op>(e.derived(), t);
+}
+
+// It multiplies each element of the matrix with 't'.
+template <class E>
+inline MatScalarExpr<E, mul_op> operator*(const MatExpr<E>& e, const typename E::value_type& t)
+{
+	if ( e.derived().size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const vec& v): dimension mismatch";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(double t): tried to multiply NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	return MatScalarExpr<E, mul_op>(e.derived(), t);
+}
+
+// It devides each element by 't'.
+template <class E>
+inline MatScalarExpr<E, div_op> operator/(const MatExpr<E>& e, const typename E::value_type& t)
+{
+	if ( e.derived().size() == 0 )
 	{
-		Vec<T> result(rows_);
-		size_t i, j;
-		for (i = rows_; i--;)
-		{
-			for (j = cols_; j--;)
-			{
-				result.set(i, result.get(i) + data_[i][j]*v.get(j));
-			}
-		}
-		return result;
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(double t): tried to divide NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if ( t == typename E::value_type(0) ){
+		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in operator/(T t): DIVISION BY ZERO ";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
 	}
+	return MatScalarExpr<E, div_op>(e.derived(), t);
+}
+
+// ========= Operators on temporaries ===========
+// When an operand is a temporary matrix (e.g. the result of a product)
+// its buffer is reused for the result instead of allocating a new one.
+
+template <class T, class R>
+inline Mat<T> operator+(Mat<T>&& l, const MatExpr<R>& r)
+{
+	l += r;
+	return std::move(l);
+}
+
+template <class L, class T>
+inline Mat<T> operator+(const MatExpr<L>& l, Mat<T>&& r)
+{
+	r += l;
+	return std::move(r);
+}
+
+template <class T>
+inline Mat<T> operator+(Mat<T>&& l, Mat<T>&& r)
+{
+	l += r;
+	return std::move(l);
+}
+
+template <class T, class R>
+inline Mat<T> operator-(Mat<T>&& l, const MatExpr<R>& r)
+{
+	l -= r;
+	return std::move(l);
+}
+
+template <class T>
+inline Mat<T> operator+(Mat<T>&& m, const typename Mat<T>::value_type& t)
+{
+	m += t;
+	return std::move(m);
+}
+
+template <class T>
+inline Mat<T> operator-(Mat<T>&& m, const typename Mat<T>::value_type& t)
+{
+	m -= t;
+	return std::move(m);
+}
+
+template <class T>
+inline Mat<T> operator*(Mat<T>&& m, const typename Mat<T>::value_type& t)
+{
+	m *= t;
+	return std::move(m);
+}
+
+template <class T>
+inline Mat<T> operator/(Mat<T>&& m, const typename Mat<T>::value_type& t)
+{
+	m /= t;
+	return std::move(m);
 }
 
-// It devides each element by 't'.
+// It multiplies matrix m with vector v.
+// It is a free function (not a member) so that Vec's converting
+// constructor Vec(size_t) cannot compete with m*t for a scalar t.
 template <class T>
-Mat<T> Mat<T>::operator/(T t)
+Vec<T> operator*(const Mat<T>& m, const Vec<T>& v)
 {
-	if ( (*this).size() == 0 )
+	if ( m.size() == 0 || v.size() == 0 )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(double t): tried to divide NULL MATRIX";
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const vec& v): tried to multiply NULL MATRIX or NULL VECTOR";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else if ( t == T(0) ){
-		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in operator/(T t): DIVISION BY ZERO ";
+	else if ( m.cols() != v.size() )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const vec& v): dimension mismatch";
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::out_of_range(msg);
 	}
 	else
 	{
-		Mat<T> result = *this;
-		size_t rows = result.rows(), cols = result.cols(), i = 0, j = 0;
-		for (i = rows; i--;)
+		Vec<T> result(m.rows());
+		size_t cols = m.cols();
+		T* r = result.data();
+		parallel_for(0, m.rows(), PARALLEL_GRAIN/cols, [&](size_t lo, size_t hi)
 		{
-			for (j = cols; j--;)
+			size_t i;
+			for (i = lo; i < hi; i++)
 			{
-				result.data_[i][j] /= t;
+				r[i] = simd_dot(cols, m.data() + i*cols, v.data());
 			}
-		}
+		});
 		return result;
 	}
 }
 
-// ***************** DEFINITION OF FRIEND FUNCTIONS ********************************************
+// ================ Matrix product ==================
+// The product is not element-wise, so it is evaluated eagerly by the
+// blocked kernel of kernels/gemm.h. A Mat, a MatView and their transposes
+// are read in place (the transpose only swaps the strides); any other
+// expression is evaluated into a temporary first.
 
-// Implementation of the algorithm described in https://en.wikipedia.org/wiki/Strassen_algorithm
-// This algorithm is beneficial for large square matrices only.
-// ATTENTION: the Strassen multiplication algorithm requires more memory than the traditional one.
+// Operand of a matrix product: a buffer with element (i,j) at data[i*rs + j*cs].
 template <class T>
-Mat<T> strassen_algorithm(const Mat<T> &a, const Mat<T> &b, size_t leafsize )
+struct gemm_operand
 {
-	size_t size = a.rows();
-	if (size <= leafsize)
-	{
-		Mat<T> c(a.rows(), b.cols());
-		c = a;
-		return c * b;
-	}
-	else
-	{
-		size_t new_size = size/2;
-		Vec<T> inner(new_size);
-		Mat<T>
-		a11(new_size, new_size), a12(new_size, new_size), a21(new_size, new_size), a22(new_size, new_size),
-		b11(new_size, new_size), b12(new_size, new_size), b21(new_size, new_size), b22(new_size, new_size),
-		c11(new_size, new_size), c12(new_size, new_size), c21(new_size, new_size), c22(new_size, new_size),
-		m1(new_size, new_size), m2(new_size, new_size), m3(new_size, new_size), m4(new_size, new_size),
-		m5(new_size, new_size), m6(new_size, new_size), m7(new_size, new_size),
-		tmp_a(new_size, new_size), tmp_b(new_size, new_size);
-
-		size_t i, j;
-
-		//dividing the matrices in 4 sub-matrices:
-		for (i = new_size; i--;)
-		{
-			for (j = new_size; j--;)
-			{
-				a11.data_[i][j] = a.data_[i][j];
-				a12.data_[i][j] = a.data_[i][j + new_size];
-				a21.data_[i][j] = a.data_[i + new_size][j];
-				a22.data_[i][j] = a.data_[i + new_size][j + new_size];
-
-				b11.data_[i][j] = b.data_[i][j];
-				b12.data_[i][j] = b.data_[i][j + new_size];
-				b21.data_[i][j] = b.data_[i + new_size][j];
-				b22.data_[i][j] = b.data_[i + new_size][j + new_size];
-			}
-		}
-
-		// Calculating m1 to m7:
+	explicit gemm_operand(const Mat<T>& m) : data(m.data()), rs(m.ld()), cs(1) {}
 
-		tmp_a = a11 + a22; // a11 + a22
-		tmp_b = b11 + b22; // b11 + b22
-		m1 = strassen_algorithm( tmp_a, tmp_b, leafsize ); // m1 = (a11+a22) * (b11+b22)
+	explicit gemm_operand(const MatTransposeExpr< Mat<T> >& t) :
+		data(t.nested().data()), rs(1), cs(t.nested().ld()) {}
 
-		tmp_a = a21 + a22; // a21 + a22
-		m2 = strassen_algorithm( tmp_a, b11, leafsize ); // m2 = (a21+a22) * (b11)
+	template <class U>
+	explicit gemm_operand(const MatView<U>& v) : data(v.data()), rs(v.ld()), cs(1) {}
 
-		tmp_b = b12 - b22; // b12 - b22
-		m3 = strassen_algorithm( a11, tmp_b, leafsize ); // m3 = (a11) * (b12 - b22)
+	template <class U>
+	explicit gemm_operand(const MatTransposeExpr< MatView<U> >& t) :
+		data(t.nested().data()), rs(1), cs(t.nested().ld()) {}
 
-		tmp_b = b21 - b11; // b21 - b11
-		m4 = strassen_algorithm( a22, tmp_b, leafsize ); // m4 = (a22) * (b21 - b11)
+	template <class E>
+	explicit gemm_operand(const MatExpr<E>& e) : tmp(e), data(tmp.data()), rs(tmp.ld()), cs(1) {}
 
-		tmp_a = a11 + a12; // a11 + a12
-		m5 = strassen_algorithm( tmp_a, b22, leafsize ); // m5 = (a11+a12) * (b22)
+	Mat<T> tmp;
+	const T* data;
+	size_t rs, cs;
+};
 
-		tmp_a = a21 - a11; // a21 - a11
-		tmp_b = b11 + b12; // b11 + b12
-		m6 = strassen_algorithm( tmp_a, tmp_b, leafsize ); // m6 = (a21-a11) * (b11+b12)
+// Vector operand of a matrix-vector product: element i at data[i*inc].
+template <class T>
+struct gemv_operand
+{
+	explicit gemv_operand(const Vec<T>& v) : data(v.data()), inc(1) {}
 
-		tmp_a = a12 - a22; // a12 - a22
-		tmp_b = b21 + b22; // b21 + b22
-		m7 = strassen_algorithm( tmp_a, tmp_b, leafsize ); // m7 = (a12-a22) * (b21+b22)
+	template <class U>
+	explicit gemv_operand(const VecView<U>& v) : data(v.data()), inc(v.stride()) {}
 
-		// Calculate c21, c21, c11 and c22:
+	template <class E>
+	explicit gemv_operand(const VecExpr<E>& e) : tmp(e), data(tmp.data()), inc(1) {}
 
-		c11 = m1 + m4 - m5 + m7;
-		c12 = m3 + m5;
-		c21 = m2 + m4;
-		c22 = m1 - m2 + m3 + m6;
+	Vec<T> tmp;
+	const T* data;
+	size_t inc;
+};
 
-		// Shape the C matrix from its calculated 4 submatrices:
-		Mat<T> c(a.rows(), b.cols());
-		for (i = new_size; i--;)
+// It multiplies the matrix expression l with the vector expression r, e.g.
+// a block of a matrix with a column of another one. Views are read in
+// place through their strides.
+template <class L, class R>
+inline Vec<typename L::value_type> operator*(const MatExpr<L>& l, const VecExpr<R>& r)
+{
+	typedef typename L::value_type T;
+	const L& m = l.derived();
+	const R& v = r.derived();
+	if ( m.size() == 0 || v.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const vec& v): tried to multiply NULL MATRIX or NULL VECTOR";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if ( m.cols() != v.size() )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const vec& v): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	gemm_operand<T> a(m);
+	gemv_operand<T> x(v);
+	Vec<T> result(m.rows());
+	T* y = result.data();
+	const size_t cols = m.cols();
+	parallel_for(0, m.rows(), PARALLEL_GRAIN/cols + 1, [&](size_t lo, size_t hi)
+	{
+		size_t i, j;
+		for (i = lo; i < hi; i++)
 		{
-			for (j = new_size; j--;)
+			const T* row = a.data + i*a.rs;
+			T sum = T(0);
+			for (j = 0; j < cols; j++)
 			{
-				c.data_[i][j] = c11.data_[i][j];
-				c.data_[i][j + new_size] = c12.data_[i][j];
-				c.data_[i + new_size][j] = c21.data_[i][j];
-				c.data_[i + new_size][j + new_size] = c22.data_[i][j];
+				sum += row[j*a.cs]*x.data[j*x.inc];
 			}
+			y[i] = sum;
 		}
-		return c;
+	});
+	return result;
+}
+
+// It multiplies matrix l with matrix r.
+template <class L, class R>
+inline Mat<typename L::value_type> operator*(const MatExpr<L>& l, const MatExpr<R>& r)
+{
+	typedef typename L::value_type T;
+	const L& m1 = l.derived();
+	const R& m2 = r.derived();
+	if ( m1.size() == 0 || m2.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const mat& m): tried to multiply NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if ( m1.cols() != m2.rows() )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in  mat::operator*(const mat& m): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
 	}
+	gemm_operand<T> a(m1), b(m2);
+	Mat<T> result(m1.rows(), m2.cols());
+	gemm(m1.rows(), m2.cols(), m1.cols(),
+			a.data, a.rs, a.cs,
+			b.data, b.rs, b.cs,
+			result.data(), result.ld());
+	return result;
 }
 
+// ***************** DEFINITION OF FRIEND FUNCTIONS ********************************************
+
+// Implementation of the algorithm described in https://en.wikipedia.org/wiki/Strassen_algorithm,
+// in Winograd's variant, see kernels/strassen.h. Odd sizes are peeled
+// instead of padded, and the products up to strassen_cutoff() are left to
+// the blocked kernel of operator*.
+// ATTENTION: the Strassen multiplication algorithm requires more memory than the traditional one.
 template <class T>
 Mat<T> strassen(const Mat<T> &a, const Mat<T> &b)
 {
@@ -1103,159 +1402,127 @@ Mat<T> strassen(const Mat<T> &a, const Mat<T> &b)
 	else
 	{
 		size_t n = a.rows();
-
-		// If the matrices A, B are not of type 2^n × 2^n,
-		// we fill the missing rows and columns with zeros.
-		// Thus, we create new matrices with size equal to
-		// the next closest power of two.
-
-		size_t m = (size_t) std::pow(2, (ceil(std::log2(n))));
-		Mat<T> a_new(m, m), b_new(m, m), c_new(m, m);
-
-		// Calculate leafsize. How deep the strassen algorithm will recurse
-		size_t leafsize = ceil((m/32.0));;
-
-		size_t i,j;
-		// copy the elements of the small matrices
-		// into the larger ones.
-		for (i = n; i--;)
-		{
-			for (j = n; j--;)
-			{
-				a_new.data_[i][j] = a.data_[i][j];
-				b_new.data_[i][j] = b.data_[i][j];
-			}
-		}
-
-		c_new = strassen_algorithm(a_new, b_new, leafsize);
-		Mat<T> c(a.rows(), a.cols());
-		// pass the elements of the large matrix
-		// into the smaller matrix.
-		for (i = n; i--;)
-		{
-			for (j = n; j--;)
-			{
-				c.data_[i][j] = c_new.data_[i][j];
-			}
-		}
+		Mat<T> c(n, n);
+		strassen_multiply(n, a.data(), a.ld(), b.data(), b.ld(), c.data(), c.ld(), strassen_cutoff());
 		return c;
 	}
 }
 
-// It computes the transposed of the matrix m.
+// It returns the transposed of the matrix expression e. Nothing is copied
+// here: the result is evaluated when it is assigned to a matrix, or read
+// in place with swapped strides when it is an operand of a product.
+template <class E>
+inline MatTransposeExpr<E> transpose(const MatExpr<E>& e)
+{
+	return MatTransposeExpr<E>(e.derived());
+}
+
+// It transposes the matrix m in place, without a second buffer: square
+// matrices swap tiles across the diagonal, rectangular ones follow the
+// cycles of the permutation, see kernels/transpose.h.
 template <class T>
-Mat<T> transpose(const Mat<T>& m)
+void inplace_transpose(Mat<T>& m)
 {
-	Mat<T> result(m.cols(), m.rows());
-	size_t i, j, rows = result.rows(), cols = result.cols();
-	for (i = rows; i--;)
+	if ( m.rows_ == m.cols_ )
 	{
-		for (j = cols; j--;)
-		{
-			result.data_[i][j] = m.data_[j][i];
-		}
+		transpose_square_inplace(m.rows_, m.data_.data(), m.cols_);
 	}
-	return result;
+	else
+	{
+		transpose_rect_inplace(m.rows_, m.cols_, m.data_.data());
+		std::swap(m.rows_, m.cols_);
+	}
+}
+
+// It evaluates the matrix expression e into a new matrix.
+template <class E>
+inline Mat<typename E::value_type> eval(const MatExpr<E>& e)
+{
+	return Mat<typename E::value_type>(e);
 }
 
-// It computes the LU-Decomposition taken from: https://en.wikipedia.org/wiki/LU_decomposition
+// It computes the LU-Decomposition P*A = L*U in place, see
+// https://en.wikipedia.org/wiki/LU_decomposition and kernels/lu.h.
+// On return pivot[i] is the row of A that ended up in row i, and
+// pivot[n] is n plus the number of row interchanges (for determinant).
 template <class T>
 ivec lup_decompose(Mat<T>& a, bool& is_singular)
 {
 	size_t n = a.rows();
-	ivec pivot(n + 1); // Unit permutation vector
-	size_t i, j, k, imax;
-	double maxA, absA;
-	Vec<T> row_pivot(n);
+	ivec pivot(n + 1);
+	std::vector<size_t, workspace_allocator<size_t> > perm(n);
+	size_t i, swaps;
 
-	for (i = 0; i <= n; i++)
+	double min_pivot = lu_factor(n, a.data(), a.ld(), perm.data(), swaps);
+	if (min_pivot < SINGULARITY_THRESHOLD)
 	{
-		pivot[i] = i; // pivot[n] initialized with n
+		is_singular = true;
 	}
 
 	for (i = 0; i < n; i++)
 	{
-		maxA = 0.0;
-		imax = i;
-
-		for (k = i; k < n; k++)
-		{
-			if ((absA = fabs(a.data_[k][i])) > maxA)
-			{
-				maxA = absA;
-				imax = k;
-			}
-		}
-
-		if (maxA < SINGULARITY_THRESHOLD)
-		{
-			is_singular = true;
-		}
-
-		if (imax != i)
-		{
-			//pivoting P
-			j = pivot[i];
-			pivot[i] = pivot[imax];
-			pivot[imax] = j;
-
-			//pivoting rows of A
-			row_pivot = a.get_row(i);
-			a.set_row(i, a.get_row(imax));
-			a.set_row(imax,  row_pivot);
-
-			//counting pivots starting from N (for determinant)
-			pivot[n]++;
-		}
-
-		for (j = i + 1; j < n; j++)
-		{
-			a.data_[j][i] /= a.data_[i][i];
-			for (k = i + 1; k < n; k++)
-			{
-				a.data_[j][k] -= a.data_[j][i] * a.data_[i][k];
-			}
-		}
+		pivot[i] = perm[i];
 	}
+	pivot[n] = n + swaps;
 	return pivot;
-
-	//decomposition done
 }
 
 template <class T>
-Mat<T> lup_invert(Mat<T>& a, const ivec& pivot)
+Mat<T> lup_invert(const Mat<T>& a, const ivec& pivot)
 {
 	size_t N = a.rows();
 	Mat<T> a_inv(N, N);
-	for (size_t j = 0; j < N; j++)
+	const T* lu = a.data_.data();
+	T* x = a_inv.data_.data();
+	size_t i;
+
+	// Start from the permuted identity P*I.
+	for (i = 0; i < N; i++)
 	{
-		for (size_t i = 0; i < N; i++)
-		{
-			if ((size_t) pivot.get(i) == j)
-			{
-				a_inv.data_[i][j] = T(1);
-			}
-			else
-			{
-				a_inv.data_[i][j] = T(0);
-			}
+		x[i*N + pivot.get(i)] = T(1);
+	}
 
-			for (size_t k = 0; k < i; k++)
-			{
-				a_inv.data_[i][j] -= a.data_[i][k] * a_inv.data_[k][j];
-			}
-		}
-		for (size_t i =  N - 1; i < SIZE_T_MAX; i--)
-		{
-			for (size_t k = i + 1; k < N; k++)
-			{
-				a_inv.data_[i][j] -= a.data_[i][k] * a_inv.data_[k][j];
-			}
+	// Solve L*Y = P*I, then U*X = Y.
+	lu_solve_lower(N, N, lu, N, x, N);
+	lu_solve_upper(N, N, lu, N, x, N);
+	return a_inv;
+}
+
+// It computes the determinant from the factors of lup_decompose().
+template <class T>
+T lup_determinant(const Mat<T>& a, const ivec& pivot)
+{
+	size_t n = a.rows(), i;
+	const T* lu = a.data();
+	T det = ((size_t(pivot.get(n)) - n) % 2) ? T(-1) : T(1);
+	for (i = 0; i < n; i++)
+	{
+		det *= lu[i*n + i];
+	}
+	return det;
+}
 
-			a_inv.data_[i][j] /= a.data_[i][i];
+// It computes log|det| and the sign det/|det| from the factors of
+// lup_decompose(), as a sum of logs instead of a product of pivots.
+template <class T>
+double lup_log_determinant(const Mat<T>& a, const ivec& pivot, T& sign)
+{
+	size_t n = a.rows(), i;
+	const T* lu = a.data();
+	double log_det = 0;
+	sign = ((size_t(pivot.get(n)) - n) % 2) ? T(-1) : T(1);
+	for (i = 0; i < n; i++)
+	{
+		const double abs_u = std::abs(lu[i*n + i]);
+		if (abs_u == 0)
+		{
+			sign = T(0);
+			return -std::numeric_limits<double>::infinity();
 		}
+		sign *= lu[i*n + i]/abs_u;
+		log_det += std::log(abs_u);
 	}
-	return a_inv;
+	return log_det;
 }
 
 // It computes the inverse of the matrix a.
@@ -1265,7 +1532,7 @@ Mat<T> inv(const Mat<T>& a)
 	if (a.rows() == 1 && a.cols() == 1)
 	{
 		Mat<T> a_inv(1,1);
-		a_inv(0,0) = 1.0/a.data_[0][0];
+		a_inv(0,0) = T(1)/a.data_[0];
 		return a_inv;
 	}
 	else if ( is_square(a) )
@@ -1281,8 +1548,7 @@ Mat<T> inv(const Mat<T>& a)
 		}
 		else
 		{
-			std::string msg = FILE_LINE_ERROR + "warning in  mat::inv(const mat& m): SINGULAR MATRIX.";
-			warning(msg.c_str());
+			LOG_WARNING(FILE_LINE_ERROR + "warning in  mat::inv(const mat& m): SINGULAR MATRIX.");
 			return abs(a)*NaN(T);
 		}
 	}
@@ -1294,48 +1560,13 @@ Mat<T> inv(const Mat<T>& a)
 	}
 }
 
-// PseudoInverse: calculates the inverse of a non-square matrix
-// Based on Moore–Penrose pseudoinverse
-//
-// Some info for clarification:
-// Thin matrix case A(m,n) with m > n:
-// a) rank(A) <= n
-// b) The homogeneous system of equations Ax = 0 has a unique (trivial) solution
-//    if and only if rank(A) = n.
-// c) the system of equations Ax = b is inconsistent for all b in R^m
-// d) the system of equations Ax = b has at most one solution for every b in R^m
-//    if and only if rank(A) = n.
-//
-// Something similar holds for fat matrix case A(m,n) with m < n
-template <class T>
-Mat<T> pinv(Mat<T>& a)
+// It computes the inverse of the matrix expression e.
+template <class E>
+inline Mat<typename E::value_type> inv(const MatExpr<E>& e)
 {
-	Mat<T> a_inv;
-
-	if ( is_square(a) )
-	{
-		a_inv = inv(a); // Normal inverse
-	}
-	else if ( std::abs(determinant(transpose(a)*a)) > std::abs(determinant(a*transpose(a))) )
-	{
-		a_inv = inv(transpose(a)*a)*transpose(a); // Left inverse (full column rank)
-	}
-	else if ( std::abs(determinant(transpose(a)*a)) < std::abs(determinant(a*transpose(a))) )
-	{
-		a_inv = transpose(a)*inv(a*transpose(a)); // Right inverse (full row rank)
-	}
-	else
-	{
-		std::string msg = FILE_LINE_ERROR + "warning in 'mat::pinv(const mat& a)': ILL-DEFINED MATRIX !!!";
-		warning(msg.c_str());
-		Mat<T> tmp(a.cols(), a.rows());
-		a_inv = abs(tmp)*NaN(T);
-	}
-	return a_inv;
+	return inv(eval(e));
 }
 
-
-
 // ##################################################################################################
 // ############################ MISCELLANEOUS OPERATIONS AND FUNCTIONS ##############################
 
@@ -1351,11 +1582,13 @@ inline Vec<T> mat2vec(const Mat<T>& m)
 	}
 	else
 	{
-		Vec<T> result;
-		size_t i, size = m.rows();
-		for (i = 0; i < size; i++)
+		// The row-major buffer already is the vectorized matrix.
+		Vec<T> result(m.size());
+		const T* data = m.data();
+		size_t i, size = m.size();
+		for (i = size; i--;)
 		{
-			result = concat(result, m.get_row(i));
+			result[i] = data[i];
 		}
 		return result;
 	}
@@ -1376,14 +1609,7 @@ template <class T>
 inline Mat<T> abs(const Mat<T>& m)
 {
 	Mat<T> result(m.rows(), m.cols());
-	size_t i, j, rows = m.rows(), cols = m.cols();
-	for (i = rows; i--; )
-	{
-		for(j = cols; j--;)
-		{
-			result.set(i, j, std::abs(m.get(i,j)));
-		}
-	}
+	simd_abs(m.size(), m.data(), result.data());
 	return result;
 }
 
@@ -1439,11 +1665,11 @@ inline imat find_zero(const Mat<T>& m)
 // random elements within the range [-10, 10].
 inline mat rand(size_t m, size_t n)
 {
-	if ( (n*m) > MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<double>(m, n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::rand_double(size_t n, size_t m): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::rand(size_t m, size_t n): " + allocation_error<double>(m, n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1458,12 +1684,13 @@ inline mat rand(size_t m, size_t n)
 		// Define range
 		double min = -10, max = 10;
 		std::uniform_real_distribution<double> dis(0, 2*max);
+		double* data = a.data();
 		for (i = m; i--;)
 		{
 			for (j = n; j--;)
 			{
 				// Generate random double number within the range [-10 10]
-				a(i, j) = min + (double) dis(gen);
+				data[i*n + j] = min + (double) dis(gen);
 			}
 		}
 		return a;
@@ -1473,11 +1700,11 @@ inline mat rand(size_t m, size_t n)
 // It returns an 'integer'-matrix with random elements within the range [-10, 10].
 inline imat rand_i(size_t m, size_t n)
 {
-	if ( (n*m) > MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<int>(m, n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::rand_double(size_t n, size_t m): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::rand_i(size_t m, size_t n): " + allocation_error<int>(m, n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1493,12 +1720,13 @@ inline imat rand_i(size_t m, size_t n)
 		int min = -10, max = 10;
 
 		std::uniform_int_distribution<int> dis(0, 2*max);
+		int* data = a.data();
 		for (i = m; i--;)
 		{
 			for (j = n; j--;)
 			{
 				// Generate random double number within the range [-10 10]
-				a(i, j) = min + (int) dis(gen);
+				data[i*n + j] = min + (int) dis(gen);
 			}
 		}
 		return a;
@@ -1509,11 +1737,11 @@ inline imat rand_i(size_t m, size_t n)
 // with random elements within the range [-10, 10].
 inline mat rand_symmetric(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<double>(n, n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in rand_int_symmetric(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in rand_symmetric(size_t n): " + allocation_error<double>(n, n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1537,11 +1765,11 @@ inline mat rand_symmetric(size_t n)
 // random elements within the range [-10, 10].
 inline imat rand_symmetric_i(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<int>(n, n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in rand_int_symmetric(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in rand_symmetric_i(size_t n): " + allocation_error<int>(n, n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1566,71 +1794,48 @@ inline imat rand_symmetric_i(size_t n)
 // It sets all elements of Mat<double> to zero.
 inline mat zeros(size_t n, size_t m)
 {
-	if ( (n*m) > (MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE) )
+	if ( !allocation_fits<double>(n, m) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::zeros(size_t n, size_t m): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::zeros(size_t n, size_t m): " + allocation_error<double>(n, m);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
-		mat a(n,m);
-		size_t i, j;
-		for (i = n; i--;)
-		{
-			for (j = m; j--;)
-			{
-				a.set(i, j, 0.0);
-			}
-		}
-		return a;
+		// The constructor already zero-initializes the buffer.
+		return mat(n,m);
 	}
 }
 
 // It sets all elements of Mat<int> to zero.
 inline imat zeros_i(size_t n, size_t m)
 {
-	if ( (n*m) > (MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE) )
+	if ( !allocation_fits<int>(n, m) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::zeros(size_t n, size_t m): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::zeros_i(size_t n, size_t m): " + allocation_error<int>(n, m);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
-		imat a(n,m);
-		size_t i, j;
-		for (i = n; i--;)
-		{
-			for (j = m; j--;)
-			{
-				a.set(i, j, 0);
-			}
-		}
-		return a;
+		// The constructor already zero-initializes the buffer.
+		return imat(n,m);
 	}
 }
 
 // It sets all elements of Mat<double> to one.
 inline mat ones(size_t n, size_t m)
 {
-	if ( (n*m) > MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<double>(n, m) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::ones(size_t n, size_t m): n*m should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::ones(size_t n, size_t m): " + allocation_error<double>(n, m);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
 		mat a(n,m);
-		size_t i, j;
-		for (i = n; i--;)
-		{
-			for (j = m; j--;)
-			{
-				a.set(i, j, 1.0);
-			}
-		}
+		a.ones();
 		return a;
 	}
 }
@@ -1638,23 +1843,16 @@ inline mat ones(size_t n, size_t m)
 // It sets all elements of Mat<int> to one.
 inline imat ones_i(size_t n, size_t m)
 {
-	if ( (n*m) > MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<int>(n, m) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::ones(size_t n, size_t m): n*m should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::ones_i(size_t n, size_t m): " + allocation_error<int>(n, m);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
 		imat a(n,m);
-		size_t i, j;
-		for (i = n; i--;)
-		{
-			for (j = m; j--;)
-			{
-				a.set(i, j, 1);
-			}
-		}
+		a.ones();
 		return a;
 	}
 }
@@ -1662,11 +1860,11 @@ inline imat ones_i(size_t n, size_t m)
 // It returns the identity matrix.
 inline mat eye(size_t k)
 {
-	if ( k > MAX_ACCEPTABLE_VECTOR_SIZE)
+	if ( !allocation_fits<double>(k, k) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::eye(size_t k): k should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::eye(size_t k): " + allocation_error<double>(k, k);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1674,7 +1872,7 @@ inline mat eye(size_t k)
 		size_t i;
 		for (i = k; i--;)
 		{
-			result(i,i) = 1.0;
+			result.data()[i*k + i] = 1.0;
 		}
 		return result;
 	}
@@ -1683,11 +1881,11 @@ inline mat eye(size_t k)
 // It returns the identity matrix.
 inline imat eye_i(size_t k)
 {
-	if ( k > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<int>(k, k) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::eye(size_t k): k should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::eye_i(size_t k): " + allocation_error<int>(k, k);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1695,7 +1893,7 @@ inline imat eye_i(size_t k)
 		size_t i;
 		for (i = k; i--;)
 		{
-			result(i,i) = 1;
+			result.data()[i*k + i] = 1;
 		}
 		return result;
 	}
@@ -1820,71 +2018,64 @@ inline Mat<T> outer_product(const Vec<T>& v1, const Vec<T>& v2)
 	}
 }
 
-// It computes the determinant of matrix m.
+// It checks the input of determinant() and log_determinant().
 template <class T>
-inline T determinant(const Mat<T>& m)
+inline void determinant_check(const Mat<T>& m, const char* function)
 {
-	if( m.size() == 0 ){
-		std::string msg = FILE_LINE_ERROR + " exception in mat::determinant(const mat& m): Not defined for NULL MATRIX";
+	if ( m.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": Not defined for NULL MATRIX";
 		log_error(msg.c_str());
 		throw std::invalid_argument(msg);
 	}
-	else
+	else if ( !is_square(m) )
 	{
-		T det = T(1);
-		if ( is_square(m) )
-		{
-			size_t size = m.rows();
-			Mat<T> tmp(m.rows(), m.cols());
-			for (size_t i = 0; i < m.rows(); i++)
-			{
-				for (size_t j = 0; j < m.cols(); j++)
-				{
-					tmp(i,j) = m.get(i,j);
-				}
-			}
-			T k = T(1), con, kc;
-			size_t p;
-			for (p = 0; p < size - 1; p++)
-			{
-				if( tmp(p,p) != T(0) ) //prepares the pivots by making them 1
-				{
-					k *= (T(1) /tmp.get(p,p));
-					kc = (T(1) / tmp.get(p,p));
-					for (size_t j = p; j < size; j++)
-					{
-						tmp(j,p) *= kc;
-					}
-				}
-				for (size_t c = p + 1; c < size; c++) //makes the lower triangle matrix
-				{
-					con = T(-1) * tmp.get(p,c);
-					for (size_t i = 0; i < size; i++)
-					{
-						tmp(i,c) += (tmp.get(i,p) * con);
-					}
-				}
-			}
-
-			if ( tmp(p,p) != T(0) )// makes the elemnt n,n 1 to end the pivots
-			{
-				k *= (T(1) / tmp.get(p,p));
-				for(size_t j = p; j < size; j++)
-				{
-					tmp(p,j) /= tmp.get(p,p);
-				}
-			}
-			for (size_t z = 0; z < size; z++)
-			{
-				det *= tmp.get(z,z);
-			}
-			det /= k;  //divides by the connstant acumulated so far
-			//where det|A| = det|B|/k where B is the triangular matrix
-		}
-		return det;
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": NON-SQUARE MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
 	}
 }
 
+// It computes the determinant of matrix m from its pivoted LU
+// factorization: det(P)*u(0,0)*...*u(n-1,n-1), with det(P) = +-1.
+template <class T>
+inline T determinant(const Mat<T>& m)
+{
+	determinant_check(m, "mat::determinant(const mat& m)");
+	Mat<T> lu = m;
+	bool is_singular = false;
+	ivec pivot = lup_decompose(lu, is_singular);
+	return lup_determinant(lu, pivot);
+}
+
+// It computes log|det(m)| and the sign det(m)/|det(m)| of matrix m (+1
+// or -1 for a real matrix), without the overflow or underflow of the
+// product of the pivots. For a singular matrix sign is 0 and it returns
+// -inf.
+template <class T>
+inline double log_determinant(const Mat<T>& m, T& sign)
+{
+	determinant_check(m, "mat::log_determinant(const mat& m, T& sign)");
+	Mat<T> lu = m;
+	bool is_singular = false;
+	ivec pivot = lup_decompose(lu, is_singular);
+	return lup_log_determinant(lu, pivot, sign);
+}
+
+// It computes the determinant of the matrix expression e.
+template <class E>
+inline typename E::value_type determinant(const MatExpr<E>& e)
+{
+	return determinant(eval(e));
+}
+
+// It computes log|det(e)| and the sign of det(e) for the matrix expression e.
+template <class E>
+inline double log_determinant(const MatExpr<E>& e, typename E::value_type& sign)
+{
+	return log_determinant(eval(e), sign);
+}
+
 
 /*
    In any magic square, the first number i.e. 1 is stored at position (n/2, n-1).
@@ -1908,11 +2099,11 @@ inline T determinant(const Mat<T>& m)
 
 inline imat magic_square(int n)
 {
-	if ( n < 0 || n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( n < 0 || !allocation_fits<int>(n, n) )
 	{
-		std::string msg = FILE_LINE_ERROR + "exception in magic_square(int n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + "exception in magic_square(int n): " + allocation_error<int>(n, n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else if ( (n & 1) == 0 )
 	{
@@ -2031,6 +2222,13 @@ inline void print(const Mat<T>& m)
 	}
 }
 
+// It prints the elements of the matrix expression e.
+template <class E>
+inline void print(const MatExpr<E>& e)
+{
+	print(eval(e));
+}
+
 // ##################################################################################################
 // ########################### COMPLEX NUMBER OPERATIONS AND FUNCTIONS ##############################
 
@@ -2044,11 +2242,11 @@ inline std::complex<double> min(const cmat& m) { return min(mat2vec(m)); }
 // It returns a 'complex'-matrix with random elements within the range [-10, 10].
 inline cmat rand_c(size_t m, size_t n)
 {
-	if ( (n*m) > MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<std::complex<double>>(m, n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::rand_double(size_t n, size_t m): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::rand_c(size_t m, size_t n): " + allocation_error<std::complex<double>>(m, n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -2064,13 +2262,14 @@ inline cmat rand_c(size_t m, size_t n)
 		double min = -10, max = 10;
 
 		std::uniform_real_distribution<double> dis(0, 2*max);
+		std::complex<double>* data = a.data();
 		for (i = m; i--;)
 		{
 			for (j = n; j--;)
 			{
 				// Generate random complex number within the range [-10 10]
-				a(i, j).real(min + (double) dis(gen));
-				a(i, j).imag(min + (double) dis(gen));
+				data[i*n + j].real(min + (double) dis(gen));
+				data[i*n + j].imag(min + (double) dis(gen));
 			}
 		}
 		return a;
@@ -2081,11 +2280,11 @@ inline cmat rand_c(size_t m, size_t n)
 // random elements within the range [-10, 10].
 inline cmat rand_symmetric_c(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<std::complex<double>>(n, n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in rand_int_symmetric(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in rand_symmetric_c(size_t n): " + allocation_error<std::complex<double>>(n, n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -2109,36 +2308,27 @@ inline cmat rand_symmetric_c(size_t n)
 // It sets all elements of Mat<int> to zero.
 inline cmat zeros_c(size_t n, size_t m)
 {
-	if ( (n*m) > (MAX_ACCEPTABLE_VECTOR_SIZE*MAX_ACCEPTABLE_VECTOR_SIZE) )
+	if ( !allocation_fits<std::complex<double>>(n, m) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::zeros(size_t n, size_t m): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::zeros_c(size_t n, size_t m): " + allocation_error<std::complex<double>>(n, m);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
-		cmat a(n,m);
-		size_t i, j;
-		for (i = n; i--;)
-		{
-			for (j = m; j--;)
-			{
-				a(i,j).real(0);
-				a(i,j).imag(0);
-			}
-		}
-		return a;
+		// The constructor already zero-initializes the buffer.
+		return cmat(n,m);
 	}
 }
 
 // It returns the identity matrix.
 inline cmat eye_c(size_t k)
 {
-	if ( k > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<std::complex<double>>(k, k) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in mat::eye(size_t k): k should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in mat::eye_c(size_t k): " + allocation_error<std::complex<double>>(k, k);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -2146,8 +2336,7 @@ inline cmat eye_c(size_t k)
 		size_t i;
 		for (i = k; i--;)
 		{
-			result(i,i).real(1);
-			result(i,i).imag(0);
+			result.data()[i*k + i] = std::complex<double>(1, 0);
 		}
 		return result;
 	}
@@ -0,0 +1,353 @@
+/*============================================================================
+ * Name         : qr.h implements the QR class, a Householder QR
+ *                factorization A = Q*R of an m x n matrix, the economy
+ *                factorization qr(a, q, r) and the least-squares solver
+ *                lstsq(). Q is never formed unless it is asked for: it is
+ *                applied to a vector or a matrix through its reflectors.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* lstsq(A, b) minimizes ||A*x - b|| through R*x = Q'*b, without forming
+ * A'*A: the condition number of the problem is not squared, and a tall,
+ * thin A costs about 2*m*n^2 flops. Usage:
+ *
+ *     vec x = lstsq(A, b);          // least squares (m >= n) or the
+ *                                   // minimum norm solution (m < n)
+ *     QR<double> f(A);              // factorize once
+ *     vec c = f.apply_qt(b);        // Q'*b, Q is not formed
+ *     mat Q, R;
+ *     qr(A, Q, R);                  // economy size: Q is m x min(m,n)
+ */
+
+#ifndef QR_H_
+#define QR_H_
+
+#include "mat.h"
+#include "kernels/qr.h"
+#include "kernels/lu.h"
+
+namespace algebra {
+
+template <class T>
+class QR {
+public:
+	QR();
+	explicit QR(const Mat<T>&);
+	explicit QR(Mat<T>&&);
+
+	void compute(const Mat<T>&);
+	void compute(Mat<T>&&);
+
+	size_t rows() const noexcept { return qr_.rows(); }
+	size_t cols() const noexcept { return qr_.cols(); }
+
+	// R on and above the diagonal, the Householder vectors below it.
+	const Mat<T>& factors() const noexcept { return qr_; }
+	const Vec<T>& tau() const noexcept { return tau_; }
+
+	Mat<T> Q() const;                   // m x min(m,n)
+	Mat<T> R() const;                   // min(m,n) x n
+	bool is_full_rank() const;
+
+	// They compute Q*b and Q'*b (b has m rows) through the reflectors.
+	Vec<T> apply_q(const Vec<T>&) const;
+	Mat<T> apply_q(const Mat<T>&) const;
+	Vec<T> apply_qt(const Vec<T>&) const;
+	Mat<T> apply_qt(const Mat<T>&) const;
+
+	// Least-squares solution of A*x = b for m >= n.
+	Vec<T> solve(const Vec<T>&) const;
+	Mat<T> solve(const Mat<T>&) const;
+
+private:
+	void factorize();
+	void check_rows(size_t rows, const char* function) const;
+
+	Mat<T> qr_;
+	Vec<T> tau_;
+};
+
+template <class T>
+QR<T>::QR() {}
+
+template <class T>
+QR<T>::QR(const Mat<T>& a)
+{
+	compute(a);
+}
+
+template <class T>
+QR<T>::QR(Mat<T>&& a)
+{
+	compute(std::move(a));
+}
+
+// It factorizes a copy of the matrix a.
+template <class T>
+void QR<T>::compute(const Mat<T>& a)
+{
+	qr_ = a;
+	factorize();
+}
+
+// It factorizes the matrix a in its own buffer.
+template <class T>
+void QR<T>::compute(Mat<T>&& a)
+{
+	qr_ = std::move(a);
+	factorize();
+}
+
+template <class T>
+void QR<T>::factorize()
+{
+	if ( qr_.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in QR::compute(const mat& a): Not defined for NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	tau_ = Vec<T>(std::min(rows(), cols()));
+	qr_factor(rows(), cols(), qr_.data(), qr_.ld(), tau_.data());
+}
+
+template <class T>
+void QR<T>::check_rows(size_t r, const char* function) const
+{
+	if ( qr_.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in QR::" + function + ": no matrix has been factorized";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if ( r != rows() )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in QR::" + function + ": dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+}
+
+// It returns the m x min(m,n) matrix Q with orthonormal columns.
+template <class T>
+Mat<T> QR<T>::Q() const
+{
+	size_t k = std::min(rows(), cols()), i;
+	Mat<T> q(rows(), k);
+	for (i = 0; i < k; i++)
+	{
+		q(i, i) = T(1);
+	}
+	qr_apply_q(rows(), k, qr_.data(), qr_.ld(), tau_.data(), false, q.data(), q.ld(), k);
+	return q;
+}
+
+// It returns the min(m,n) x n upper triangular (trapezoidal) matrix R.
+template <class T>
+Mat<T> QR<T>::R() const
+{
+	size_t k = std::min(rows(), cols()), n = cols(), i;
+	Mat<T> r(k, n);
+	for (i = 0; i < k; i++)
+	{
+		std::copy(qr_.data() + i*n + i, qr_.data() + (i + 1)*n, r.data() + i*n + i);
+	}
+	return r;
+}
+
+// A diagonal element of R below SINGULARITY_THRESHOLD times the
+// largest one marks a rank deficient matrix.
+template <class T>
+bool QR<T>::is_full_rank() const
+{
+	size_t k = std::min(rows(), cols()), i;
+	double r_max = 0;
+	for (i = 0; i < k; i++)
+	{
+		r_max = std::max(r_max, (double) std::abs(qr_.data()[i*cols() + i]));
+	}
+	for (i = 0; i < k; i++)
+	{
+		if ( std::abs(qr_.data()[i*cols() + i]) <= SINGULARITY_THRESHOLD*r_max )
+		{
+			return false;
+		}
+	}
+	return r_max > 0;
+}
+
+template <class T>
+Vec<T> QR<T>::apply_q(const Vec<T>& b) const
+{
+	check_rows(b.size(), "apply_q(const vec& b)");
+	Vec<T> x = b;
+	qr_apply_q(rows(), tau_.size(), qr_.data(), qr_.ld(), tau_.data(), false, x.data(), 1, 1);
+	return x;
+}
+
+template <class T>
+Mat<T> QR<T>::apply_q(const Mat<T>& b) const
+{
+	check_rows(b.rows(), "apply_q(const mat& b)");
+	Mat<T> x = b;
+	qr_apply_q(rows(), tau_.size(), qr_.data(), qr_.ld(), tau_.data(), false, x.data(), x.ld(), x.cols());
+	return x;
+}
+
+template <class T>
+Vec<T> QR<T>::apply_qt(const Vec<T>& b) const
+{
+	check_rows(b.size(), "apply_qt(const vec& b)");
+	Vec<T> x = b;
+	qr_apply_q(rows(), tau_.size(), qr_.data(), qr_.ld(), tau_.data(), true, x.data(), 1, 1);
+	return x;
+}
+
+template <class T>
+Mat<T> QR<T>::apply_qt(const Mat<T>& b) const
+{
+	check_rows(b.rows(), "apply_qt(const mat& b)");
+	Mat<T> x = b;
+	qr_apply_q(rows(), tau_.size(), qr_.data(), qr_.ld(), tau_.data(), true, x.data(), x.ld(), x.cols());
+	return x;
+}
+
+// It solves R*x = (Q'*b)(0:n) for every column of b.
+template <class T>
+Mat<T> QR<T>::solve(const Mat<T>& b) const
+{
+	check_rows(b.rows(), "solve(const mat& b)");
+	size_t n = cols(), nrhs = b.cols();
+	if ( rows() < n )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in QR::solve(const mat& b): UNDERDETERMINED SYSTEM: use lstsq(const mat& a, const mat& b)";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	else if ( !is_full_rank() )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in QR::solve(const mat& b): RANK DEFICIENT MATRIX: use pinv(const mat& a)");
+		Mat<T> x(n, nrhs);
+		return abs(x)*NaN(T);
+	}
+	Mat<T> c = apply_qt(b);
+	Mat<T> x(n, nrhs);
+	std::copy_n(c.data(), n*nrhs, x.data());
+	lu_solve_upper(n, nrhs, qr_.data(), qr_.ld(), x.data(), nrhs);
+	return x;
+}
+
+template <class T>
+Vec<T> QR<T>::solve(const Vec<T>& b) const
+{
+	Mat<T> b_mat(b.size(), 1);
+	std::copy_n(b.data(), b.size(), b_mat.data());
+	return mat2vec(solve(b_mat));
+}
+
+
+// ##################################################################################################
+// ##################################### QR AND LEAST SQUARES #######################################
+
+// It computes the economy size factorization a = q*r: q is m x min(m,n)
+// with orthonormal columns, r is min(m,n) x n upper triangular.
+template <class T>
+inline void qr(const Mat<T>& a, Mat<T>& q, Mat<T>& r)
+{
+	QR<T> f(a);
+	q = f.Q();
+	r = f.R();
+}
+
+// It returns the solution of a*X = b with the least squared error for
+// m >= n, and the solution with the least norm for m < n.
+template <class T>
+inline Mat<T> lstsq(const Mat<T>& a, const Mat<T>& b)
+{
+	if ( a.rows() != b.rows() )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in lstsq(const mat& a, const mat& b): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	if ( a.rows() >= a.cols() )
+	{
+		return QR<T>(a).solve(b);
+	}
+
+	// a' = Q*R, so a*x = b becomes R'*y = b with x = Q*y, and the
+	// smallest x is the one with y zero beyond its first m elements.
+	size_t m = a.rows(), n = a.cols(), nrhs = b.cols(), i, j, p;
+	Mat<T> a_h(n, m);
+	for (i = 0; i < m; i++)
+	{
+		for (j = 0; j < n; j++)
+		{
+			a_h.data()[j*m + i] = scalar_conj(a.data()[i*n + j]);
+		}
+	}
+	QR<T> f(std::move(a_h));
+	Mat<T> x(n, nrhs);
+	if ( !f.is_full_rank() )
+	{
+		LOG_WARNING(FILE_LINE_ERROR + "warning in lstsq(const mat& a, const mat& b): RANK DEFICIENT MATRIX: use pinv(const mat& a)");
+		return abs(x)*NaN(T);
+	}
+	const T* r = f.factors().data();
+	T* y = x.data();
+	std::copy_n(b.data(), m*nrhs, y);
+	for (i = 0; i < m; i++)
+	{
+		T* y_i = y + i*nrhs;
+		for (p = 0; p < i; p++)
+		{
+			const T r_pi = scalar_conj(r[p*m + i]);
+			const T* y_p = y + p*nrhs;
+			for (j = 0; j < nrhs; j++)
+			{
+				y_i[j] -= r_pi*y_p[j];
+			}
+		}
+		const T r_ii = scalar_conj(r[i*m + i]);
+		for (j = 0; j < nrhs; j++)
+		{
+			y_i[j] /= r_ii;
+		}
+	}
+	return f.apply_q(x);
+}
+
+// It returns the least-squares (m >= n) or least-norm (m < n)
+// solution of a*x = b.
+template <class T>
+inline Vec<T> lstsq(const Mat<T>& a, const Vec<T>& b)
+{
+	Mat<T> b_mat(b.size(), 1);
+	std::copy_n(b.data(), b.size(), b_mat.data());
+	return mat2vec(lstsq(a, b_mat));
+}
+
+} /* namespace algebra */
+
+#endif /* QR_H_ */
@@ -0,0 +1,501 @@
+/*============================================================================
+ * Name         : serialize.h implements the binary file format of Vec and
+ *                Mat: save() and load(), and MappedArray, which maps a saved
+ *                file and reads its elements in place instead of copying
+ *                them.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/*     save("model.bin", w);                 // w is a mat, a cmat, a vec, ...
+ *     mat w2; load("model.bin", w2);        // reads the file into w2
+ *
+ *     MappedArray<double> m("model.bin");   // maps the file, reads nothing
+ *     vec y = m.mat()*x;                    // the elements are used in place
+ *
+ * A file is a header page followed by the elements, row-major, exactly as
+ * they are in memory. The header records the format version, the byte
+ * order, the element type, the shape, the layout, the alignment of the
+ * elements in the file and a checksum of them. load() reads the elements
+ * straight into the new container and verifies the checksum. MappedArray
+ * maps the file privately and read-only: its mat() and vec() are views of
+ * the page cache, so that opening even a large file costs one mmap() and
+ * the pages are read when first used. It verifies the checksum only when
+ * asked to, since that reads the whole file.
+ */
+
+#ifndef SERIALIZE_H_
+#define SERIALIZE_H_
+
+#include <stddef.h>     // size_t
+#include <stdint.h>     // uint32_t, uint64_t
+#include <string.h>     // memcpy, memcmp, memset, strerror
+#include <errno.h>
+#include <stdio.h>      // rename
+#include <fcntl.h>      // open
+#include <unistd.h>     // read, write, close, fsync
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+#include <string>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+
+#include "mat.h"
+
+// Alignment (in Bytes) of the elements in a file, a page so that a
+// mapping can use them in place.
+#define ARRAY_ALIGNMENT 4096
+#define ARRAY_VERSION 1
+#define ARRAY_BYTE_ORDER 0x01020304u
+#define ARRAY_ROW_MAJOR 0
+
+namespace algebra {
+
+// The header at the start of a saved Vec or Mat.
+struct array_header {
+	char magic[8];          // "LAARRAY\0"
+	uint32_t version;
+	uint32_t byte_order;    // ARRAY_BYTE_ORDER, as the writer stores it
+	uint32_t dtype;         // array_dtype<T>::code
+	uint32_t elem_size;     // sizeof(T)
+	uint32_t rank;          // 1 for a Vec, 2 for a Mat
+	uint32_t layout;        // ARRAY_ROW_MAJOR
+	uint64_t rows;          // the size of a Vec
+	uint64_t cols;          // 1 for a Vec
+	uint64_t alignment;
+	uint64_t data_offset;
+	uint64_t data_bytes;
+	uint64_t checksum;      // array_checksum() of the elements
+};
+
+static const char ARRAY_MAGIC[8] = { 'L', 'A', 'A', 'R', 'R', 'A', 'Y', '\0' };
+
+// The element types a file can hold.
+template <class T>
+struct array_dtype;
+
+template <>
+struct array_dtype<int> { enum { code = 1 }; static const char* name() { return "int32"; } };
+template <>
+struct array_dtype<double> { enum { code = 2 }; static const char* name() { return "float64"; } };
+template <>
+struct array_dtype< std::complex<double> > { enum { code = 3 }; static const char* name() { return "complex128"; } };
+
+inline uint64_t array_rotl(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+// It returns a 64-bit checksum of bytes Bytes at p. It is an FNV-1a hash
+// over 8-byte words, in four independent lanes so that the multiplies of
+// consecutive words overlap, with a rotation feeding the high bits of a
+// word back into the low ones.
+inline uint64_t array_checksum(const void* p, size_t bytes)
+{
+	const uint64_t PRIME = 0x100000001b3ull;
+	const unsigned char* s = static_cast<const unsigned char*>(p);
+	uint64_t h[4] = { 0xcbf29ce484222325ull, 0x84222325cbf29ce4ull, 0x9ce484222325cbf2ull, 0x222325cbf29ce484ull };
+	size_t i, k;
+	for (i = 0; i + 32 <= bytes; i += 32)
+	{
+		for (k = 0; k < 4; k++)
+		{
+			uint64_t w;
+			memcpy(&w, s + i + 8*k, 8);
+			h[k] = array_rotl((h[k] ^ w)*PRIME, 31);
+		}
+	}
+	uint64_t r = h[0];
+	for (k = 1; k < 4; k++)
+	{
+		r = array_rotl((r ^ h[k])*PRIME, 31);
+	}
+	for (; i < bytes; i++)
+	{
+		r = (r ^ s[i])*PRIME;
+	}
+	return (r ^ bytes)*PRIME;
+}
+
+inline std::runtime_error array_io_error(const std::string& where, const std::string& path)
+{
+	std::string msg = FILE_LINE_ERROR + " exception in " + where + ": " + path + ": " + strerror(errno);
+	log_error(msg.c_str());
+	return std::runtime_error(msg);
+}
+
+inline std::invalid_argument array_format_error(const std::string& where, const std::string& path, const std::string& error)
+{
+	std::string msg = FILE_LINE_ERROR + " exception in " + where + ": " + path + ": " + error;
+	log_error(msg.c_str());
+	return std::invalid_argument(msg);
+}
+
+// It writes bytes Bytes to fd, resuming the partial writes.
+inline bool array_write_all(int fd, const void* p, size_t bytes)
+{
+	const char* s = static_cast<const char*>(p);
+	while (bytes > 0)
+	{
+		ssize_t n = ::write(fd, s, bytes);
+		if (n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n <= 0)
+		{
+			return false;
+		}
+		s += n;
+		bytes -= (size_t) n;
+	}
+	return true;
+}
+
+// It reads bytes Bytes at offset of fd, resuming the partial reads.
+inline bool array_read_all(int fd, void* p, size_t bytes, size_t offset)
+{
+	char* d = static_cast<char*>(p);
+	while (bytes > 0)
+	{
+		ssize_t n = pread(fd, d, bytes, (off_t) offset);
+		if (n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (n <= 0)
+		{
+			if (n == 0)
+			{
+				errno = EIO;
+			}
+			return false;
+		}
+		d += n;
+		bytes -= (size_t) n;
+		offset += (size_t) n;
+	}
+	return true;
+}
+
+// It writes rows x cols elements of rank rank to path. The file is written
+// under a temporary name, flushed to the disk and renamed at the end, so
+// that path holds either the old file or the complete new one, even after
+// a crash or a power loss. The rename puts a new file at path: the mappings
+// and open descriptors of the old one still see the old elements.
+template <class T>
+void array_save(const std::string& path, const T* data, size_t rows, size_t cols, uint32_t rank, const char* where)
+{
+	array_header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, ARRAY_MAGIC, sizeof(h.magic));
+	h.version = ARRAY_VERSION;
+	h.byte_order = ARRAY_BYTE_ORDER;
+	h.dtype = array_dtype<T>::code;
+	h.elem_size = sizeof(T);
+	h.rank = rank;
+	h.layout = ARRAY_ROW_MAJOR;
+	h.rows = rows;
+	h.cols = cols;
+	h.alignment = ARRAY_ALIGNMENT;
+	h.data_offset = (sizeof(h) + ARRAY_ALIGNMENT - 1)/ARRAY_ALIGNMENT*ARRAY_ALIGNMENT;
+	h.data_bytes = rows*cols*sizeof(T);
+	h.checksum = array_checksum(data, h.data_bytes);
+
+	char page[ARRAY_ALIGNMENT];
+	memset(page, 0, sizeof(page));
+	memcpy(page, &h, sizeof(h));
+
+	const std::string part = path + ".part";
+	int fd = ::open(part.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		throw array_io_error(where, part);
+	}
+	if (!array_write_all(fd, page, h.data_offset) || !array_write_all(fd, data, h.data_bytes))
+	{
+		std::runtime_error e = array_io_error(where, part);
+		::close(fd);
+		::unlink(part.c_str());
+		throw e;
+	}
+	if (fsync(fd) != 0)
+	{
+		std::runtime_error e = array_io_error(where, part);
+		::close(fd);
+		::unlink(part.c_str());
+		throw e;
+	}
+	if (::close(fd) != 0 || rename(part.c_str(), path.c_str()) != 0)
+	{
+		std::runtime_error e = array_io_error(where, path);
+		::unlink(part.c_str());
+		throw e;
+	}
+}
+
+// It reads and checks the header of the file fd for elements of type T
+// and rank rank (0 accepts both).
+template <class T>
+array_header array_read_header(int fd, const std::string& path, uint32_t rank, const char* where)
+{
+	array_header h;
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		throw array_io_error(where, path);
+	}
+	if ((size_t) st.st_size < sizeof(h) || !array_read_all(fd, &h, sizeof(h), 0))
+	{
+		throw array_format_error(where, path, "the file is too short for a header");
+	}
+	if (memcmp(h.magic, ARRAY_MAGIC, sizeof(h.magic)) != 0)
+	{
+		throw array_format_error(where, path, "not a vector or matrix file");
+	}
+	if (h.version != ARRAY_VERSION)
+	{
+		throw array_format_error(where, path, "unsupported format version " + std::to_string(h.version));
+	}
+	if (h.byte_order != ARRAY_BYTE_ORDER)
+	{
+		throw array_format_error(where, path, "the file was written with a different byte order");
+	}
+	if (h.dtype != (uint32_t) array_dtype<T>::code || h.elem_size != sizeof(T))
+	{
+		throw array_format_error(where, path, std::string("the file does not hold ") + array_dtype<T>::name() + " elements");
+	}
+	if (h.layout != ARRAY_ROW_MAJOR || (h.rank != 1 && h.rank != 2) || (h.rank == 1 && h.cols != 1))
+	{
+		throw array_format_error(where, path, "unsupported layout");
+	}
+	if (rank != 0 && h.rank != rank)
+	{
+		throw array_format_error(where, path, h.rank == 1 ? "the file holds a vector" : "the file holds a matrix");
+	}
+	const uint64_t max = std::numeric_limits<uint64_t>::max();
+	if ((h.cols && h.rows > max/h.cols/sizeof(T)) || h.data_bytes != h.rows*h.cols*sizeof(T)
+			|| h.data_offset < sizeof(h) || h.alignment == 0 || h.data_offset % h.alignment != 0
+			|| h.data_offset > max - h.data_bytes || (uint64_t) st.st_size < h.data_offset + h.data_bytes)
+	{
+		throw array_format_error(where, path, "the header does not match the size of the file");
+	}
+	return h;
+}
+
+// It reads the elements of the file path into data, which holds
+// h.rows*h.cols elements, and verifies them against the checksum.
+template <class T>
+void array_load(const std::string& path, int fd, const array_header& h, T* data, const char* where)
+{
+	if (!array_read_all(fd, data, h.data_bytes, h.data_offset))
+	{
+		throw array_io_error(where, path);
+	}
+	if (array_checksum(data, h.data_bytes) != h.checksum)
+	{
+		throw array_format_error(where, path, "checksum mismatch");
+	}
+}
+
+// It closes the file descriptor it is given when it goes out of scope.
+class array_file {
+public:
+	array_file(const std::string& path, const char* where) : fd_(::open(path.c_str(), O_RDONLY))
+	{
+		if (fd_ < 0)
+		{
+			throw array_io_error(where, path);
+		}
+	}
+	array_file(const array_file&) = delete;
+	array_file& operator=(const array_file&) = delete;
+	~array_file() { ::close(fd_); }
+
+	int fd() const noexcept { return fd_; }
+
+private:
+	int fd_;
+};
+
+// It writes the vector v to the file path.
+template <class T>
+void save(const std::string& path, const Vec<T>& v)
+{
+	array_save(path, v.data(), v.size(), (size_t) 1, 1, "save(const std::string& path, const vec& v)");
+}
+
+// It writes the matrix m to the file path.
+template <class T>
+void save(const std::string& path, const Mat<T>& m)
+{
+	array_save(path, m.data(), m.rows(), m.cols(), 2, "save(const std::string& path, const mat& m)");
+}
+
+// It reads the vector saved in the file path into v.
+template <class T>
+void load(const std::string& path, Vec<T>& v)
+{
+	const char* where = "load(const std::string& path, vec& v)";
+	array_file f(path, where);
+	array_header h = array_read_header<T>(f.fd(), path, 1, where);
+	Vec<T> tmp(h.rows);
+	array_load(path, f.fd(), h, tmp.data(), where);
+	v = std::move(tmp);
+}
+
+// It reads the matrix saved in the file path into m.
+template <class T>
+void load(const std::string& path, Mat<T>& m)
+{
+	const char* where = "load(const std::string& path, mat& m)";
+	array_file f(path, where);
+	array_header h = array_read_header<T>(f.fd(), path, 2, where);
+	Mat<T> tmp(h.rows, h.cols);
+	array_load(path, f.fd(), h, tmp.data(), where);
+	m = std::move(tmp);
+}
+
+// ##################################################################################################
+// ############################################ MAPPED ARRAY ########################################
+
+// A saved Vec or Mat, mapped read-only; its elements are used in place.
+template <class T>
+class MappedArray {
+public:
+	typedef T value_type;
+
+	// It maps the file path; verify checks the elements against the
+	// checksum, which reads the whole file.
+	explicit MappedArray(const std::string& path, bool verify = false);
+	MappedArray(const MappedArray<T>&) = delete;
+	MappedArray(MappedArray<T>&&) noexcept;
+	~MappedArray();
+
+	MappedArray<T>& operator=(const MappedArray<T>&) = delete;
+	MappedArray<T>& operator=(MappedArray<T>&&) noexcept;
+
+	size_t rows() const noexcept { return rows_; }
+	size_t cols() const noexcept { return cols_; }
+	size_t size() const noexcept { return rows_*cols_; }
+	// 1 for a saved Vec, 2 for a saved Mat.
+	int rank() const noexcept { return rank_; }
+	const T* data() const noexcept { return data_; }
+
+	// All the elements, in row-major order.
+	VecView<const T> vec() const { return VecView<const T>(data_, size(), 1, data_); }
+	// The rows() x cols() matrix (a saved Vec is a column).
+	MatView<const T> mat() const { return MatView<const T>(data_, rows_, cols_, cols_, data_); }
+
+private:
+	void unmap() noexcept;
+
+	char* map_;
+	size_t bytes_;
+	const T* data_;
+	size_t rows_;
+	size_t cols_;
+	int rank_;
+};
+
+template <class T>
+MappedArray<T>::MappedArray(const std::string& path, bool verify) :
+	map_(nullptr), bytes_(0), data_(nullptr), rows_(0), cols_(0), rank_(0)
+{
+	const char* where = "mapped_array::mapped_array(const std::string& path, bool verify)";
+	array_file f(path, where);
+	array_header h = array_read_header<T>(f.fd(), path, 0, where);
+	rows_ = h.rows;
+	cols_ = h.cols;
+	rank_ = (int) h.rank;
+	bytes_ = h.data_offset + h.data_bytes;
+	// The mapping outlives the file descriptor. A later save() to the same
+	// path does not disturb it, because save() renames a new file over the
+	// path and leaves this one unchanged; MAP_PRIVATE would not protect it,
+	// as the pages never written by the process still show the writes made
+	// to the file in place.
+	void* p = mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, f.fd(), 0);
+	if (p == MAP_FAILED)
+	{
+		throw array_io_error(where, path);
+	}
+	map_ = static_cast<char*>(p);
+	data_ = reinterpret_cast<const T*>(map_ + h.data_offset);
+	if (verify && array_checksum(data_, h.data_bytes) != h.checksum)
+	{
+		unmap();
+		throw array_format_error(where, path, "checksum mismatch");
+	}
+}
+
+template <class T>
+MappedArray<T>::MappedArray(MappedArray<T>&& a) noexcept :
+	map_(a.map_), bytes_(a.bytes_), data_(a.data_), rows_(a.rows_), cols_(a.cols_), rank_(a.rank_)
+{
+	a.map_ = nullptr;
+	a.data_ = nullptr;
+	a.bytes_ = a.rows_ = a.cols_ = 0;
+	a.rank_ = 0;
+}
+
+template <class T>
+MappedArray<T>& MappedArray<T>::operator=(MappedArray<T>&& a) noexcept
+{
+	if (this != &a)
+	{
+		unmap();
+		map_ = a.map_;
+		bytes_ = a.bytes_;
+		data_ = a.data_;
+		rows_ = a.rows_;
+		cols_ = a.cols_;
+		rank_ = a.rank_;
+		a.map_ = nullptr;
+		a.data_ = nullptr;
+		a.bytes_ = a.rows_ = a.cols_ = 0;
+		a.rank_ = 0;
+	}
+	return *this;
+}
+
+template <class T>
+MappedArray<T>::~MappedArray()
+{
+	unmap();
+}
+
+template <class T>
+void MappedArray<T>::unmap() noexcept
+{
+	if (map_)
+	{
+		munmap(map_, bytes_);
+		map_ = nullptr;
+		data_ = nullptr;
+	}
+}
+
+} /* namespace algebra */
+
+#endif /* SERIALIZE_H_ */
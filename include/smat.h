@@ -0,0 +1,847 @@
+/*============================================================================
+ * Name         : smat.h implements fixed-size vectors SVec<T,N> and matrices
+ *                SMat<T,R,C>. Their dimensions are template arguments, the
+ *                elements live on the stack and every loop has a compile-time
+ *                trip count, so small products, inverses and determinants
+ *                are unrolled by the compiler and never touch the heap.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* Dimension errors are compile errors: SMat<T,2,3>*SMat<T,2,3> does not
+ * compile, and neither does inv() of a non-square SMat. Conversions from
+ * Vec/Mat check the dimensions at run time, conversions to Vec/Mat are
+ * implicit, so an SVec/SMat can be passed wherever a vec/mat is expected:
+ *
+ *     smat<2,2> F = {1, 0.1, 0, 1};
+ *     svec<2>   x = {0, 1};
+ *     x = F*x;                      // no allocation
+ *     mat P = F;                    // copy into a dynamic matrix
+ */
+
+#ifndef SMAT_H_
+#define SMAT_H_
+
+#include <initializer_list>
+
+#include "mat.h"
+
+namespace algebra {
+
+// ##################################################################################################
+// ############################################ SVec ################################################
+
+template <class T, size_t N>
+class SVec {
+	static_assert(N > 0, "SVec<T,N> requires N > 0");
+public:
+	typedef T value_type;
+
+	SVec();
+	SVec(std::initializer_list<T>);
+	explicit SVec(const Vec<T>&);
+
+	static constexpr size_t size() noexcept { return N; }
+
+	T* data() noexcept { return data_; }
+	const T* data() const noexcept { return data_; }
+
+	// Checked element access.
+	void set(size_t, T);
+	T get(size_t) const;
+
+	// Unchecked element access: the hot path of small filters.
+	T& operator()(size_t k) noexcept { return data_[k]; }
+	const T& operator()(size_t k) const noexcept { return data_[k]; }
+	T& operator[](size_t k) noexcept { return data_[k]; }
+	const T& operator[](size_t k) const noexcept { return data_[k]; }
+
+	void zeros();
+	void ones();
+
+	SVec<T, N>& operator+=(const SVec<T, N>&);
+	SVec<T, N>& operator-=(const SVec<T, N>&);
+	SVec<T, N>& operator+=(T);
+	SVec<T, N>& operator-=(T);
+	SVec<T, N>& operator*=(T);
+	SVec<T, N>& operator/=(T);
+
+	// It copies the elements into a dynamic vector.
+	operator Vec<T>() const;
+
+private:
+	T data_[N];
+};
+
+// DEFAULT CONSTRUCTOR: all elements are zero.
+template <class T, size_t N>
+SVec<T, N>::SVec()
+{
+	zeros();
+}
+
+// It initializes the vector from a list of exactly N values.
+template <class T, size_t N>
+SVec<T, N>::SVec(std::initializer_list<T> l)
+{
+	if ( l.size() != N )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in svec(initializer_list l): l should contain " + std::to_string(N) + " elements";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	std::copy_n(l.begin(), N, data_);
+}
+
+// It copies a dynamic vector of size N.
+template <class T, size_t N>
+SVec<T, N>::SVec(const Vec<T>& v)
+{
+	if ( v.size() != N )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in svec(const vec& v): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	for (size_t i = N; i--;)
+	{
+		data_[i] = v.get(i);
+	}
+}
+
+// It sets the i^th element of the vector.
+template <class T, size_t N>
+void SVec<T, N>::set(size_t i, T value)
+{
+	if ( i >= N )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in svec::set(size_t i, T value): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	data_[i] = value;
+}
+
+// It returns the i^th element of the vector.
+template <class T, size_t N>
+T SVec<T, N>::get(size_t i) const
+{
+	if ( i >= N )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in svec::get(size_t i): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return data_[i];
+}
+
+template <class T, size_t N>
+void SVec<T, N>::zeros()
+{
+	std::fill(data_, data_ + N, T(0));
+}
+
+template <class T, size_t N>
+void SVec<T, N>::ones()
+{
+	std::fill(data_, data_ + N, T(1));
+}
+
+template <class T, size_t N>
+SVec<T, N>& SVec<T, N>::operator+=(const SVec<T, N>& v)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		data_[i] += v.data_[i];
+	}
+	return *this;
+}
+
+template <class T, size_t N>
+SVec<T, N>& SVec<T, N>::operator-=(const SVec<T, N>& v)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		data_[i] -= v.data_[i];
+	}
+	return *this;
+}
+
+template <class T, size_t N>
+SVec<T, N>& SVec<T, N>::operator+=(T t)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		data_[i] += t;
+	}
+	return *this;
+}
+
+template <class T, size_t N>
+SVec<T, N>& SVec<T, N>::operator-=(T t)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		data_[i] -= t;
+	}
+	return *this;
+}
+
+template <class T, size_t N>
+SVec<T, N>& SVec<T, N>::operator*=(T t)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		data_[i] *= t;
+	}
+	return *this;
+}
+
+// I throw exception if t = 0 (undefined behavior in some cases)
+template <class T, size_t N>
+SVec<T, N>& SVec<T, N>::operator/=(T t)
+{
+	if ( t == T(0) )
+	{
+		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in svec::operator/=(T t): DIVISION BY ZERO ";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	for (size_t i = 0; i < N; i++)
+	{
+		data_[i] /= t;
+	}
+	return *this;
+}
+
+template <class T, size_t N>
+SVec<T, N>::operator Vec<T>() const
+{
+	Vec<T> v(N);
+	for (size_t i = N; i--;)
+	{
+		v.set(i, data_[i]);
+	}
+	return v;
+}
+
+
+// ##################################################################################################
+// ############################################ SMat ################################################
+
+template <class T, size_t R, size_t C>
+class SMat {
+	static_assert(R > 0 && C > 0, "SMat<T,R,C> requires R > 0 and C > 0");
+public:
+	typedef T value_type;
+
+	SMat();
+	SMat(std::initializer_list<T>);
+	explicit SMat(const Mat<T>&);
+
+	static constexpr size_t rows() noexcept { return R; }
+	static constexpr size_t cols() noexcept { return C; }
+	static constexpr size_t size() noexcept { return R*C; }
+
+	// Elements are stored row-major, like Mat.
+	T* data() noexcept { return data_; }
+	const T* data() const noexcept { return data_; }
+
+	// Checked element access.
+	void set(size_t, size_t, T);
+	T get(size_t, size_t) const;
+	SVec<T, C> get_row(size_t) const;
+	SVec<T, R> get_col(size_t) const;
+
+	// Unchecked element access: the hot path of small filters.
+	T& operator()(size_t i, size_t j) noexcept { return data_[i*C + j]; }
+	const T& operator()(size_t i, size_t j) const noexcept { return data_[i*C + j]; }
+
+	void zeros();
+	void ones();
+
+	SMat<T, R, C>& operator+=(const SMat<T, R, C>&);
+	SMat<T, R, C>& operator-=(const SMat<T, R, C>&);
+	SMat<T, R, C>& operator+=(T);
+	SMat<T, R, C>& operator-=(T);
+	SMat<T, R, C>& operator*=(T);
+	SMat<T, R, C>& operator/=(T);
+
+	// It copies the elements into a dynamic matrix.
+	operator Mat<T>() const;
+
+private:
+	T data_[R*C];
+};
+
+// DEFAULT CONSTRUCTOR: all elements are zero.
+template <class T, size_t R, size_t C>
+SMat<T, R, C>::SMat()
+{
+	zeros();
+}
+
+// It initializes the matrix from a list of exactly R*C values, row after row.
+template <class T, size_t R, size_t C>
+SMat<T, R, C>::SMat(std::initializer_list<T> l)
+{
+	if ( l.size() != R*C )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in smat(initializer_list l): l should contain " + std::to_string(R*C) + " elements";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	std::copy_n(l.begin(), R*C, data_);
+}
+
+// It copies a dynamic R x C matrix.
+template <class T, size_t R, size_t C>
+SMat<T, R, C>::SMat(const Mat<T>& m)
+{
+	if ( m.rows() != R || m.cols() != C )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in smat(const mat& m): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	std::copy_n(m.data(), R*C, data_);
+}
+
+// It sets the (i,j) element of the matrix.
+template <class T, size_t R, size_t C>
+void SMat<T, R, C>::set(size_t i, size_t j, T value)
+{
+	if ( i >= R || j >= C )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in smat::set(size_t i, size_t j, T value): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	data_[i*C + j] = value;
+}
+
+// It returns the (i,j) element of the matrix.
+template <class T, size_t R, size_t C>
+T SMat<T, R, C>::get(size_t i, size_t j) const
+{
+	if ( i >= R || j >= C )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in smat::get(size_t i, size_t j): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return data_[i*C + j];
+}
+
+// It returns the i^th row of the matrix.
+template <class T, size_t R, size_t C>
+SVec<T, C> SMat<T, R, C>::get_row(size_t i) const
+{
+	if ( i >= R )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in smat::get_row(size_t i): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	SVec<T, C> v;
+	std::copy_n(&data_[i*C], C, v.data());
+	return v;
+}
+
+// It returns the j^th column of the matrix.
+template <class T, size_t R, size_t C>
+SVec<T, R> SMat<T, R, C>::get_col(size_t j) const
+{
+	if ( j >= C )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in smat::get_col(size_t j): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	SVec<T, R> v;
+	for (size_t i = 0; i < R; i++)
+	{
+		v(i) = data_[i*C + j];
+	}
+	return v;
+}
+
+template <class T, size_t R, size_t C>
+void SMat<T, R, C>::zeros()
+{
+	std::fill(data_, data_ + R*C, T(0));
+}
+
+template <class T, size_t R, size_t C>
+void SMat<T, R, C>::ones()
+{
+	std::fill(data_, data_ + R*C, T(1));
+}
+
+template <class T, size_t R, size_t C>
+SMat<T, R, C>& SMat<T, R, C>::operator+=(const SMat<T, R, C>& m)
+{
+	for (size_t i = 0; i < R*C; i++)
+	{
+		data_[i] += m.data_[i];
+	}
+	return *this;
+}
+
+template <class T, size_t R, size_t C>
+SMat<T, R, C>& SMat<T, R, C>::operator-=(const SMat<T, R, C>& m)
+{
+	for (size_t i = 0; i < R*C; i++)
+	{
+		data_[i] -= m.data_[i];
+	}
+	return *this;
+}
+
+template <class T, size_t R, size_t C>
+SMat<T, R, C>& SMat<T, R, C>::operator+=(T t)
+{
+	for (size_t i = 0; i < R*C; i++)
+	{
+		data_[i] += t;
+	}
+	return *this;
+}
+
+template <class T, size_t R, size_t C>
+SMat<T, R, C>& SMat<T, R, C>::operator-=(T t)
+{
+	for (size_t i = 0; i < R*C; i++)
+	{
+		data_[i] -= t;
+	}
+	return *this;
+}
+
+template <class T, size_t R, size_t C>
+SMat<T, R, C>& SMat<T, R, C>::operator*=(T t)
+{
+	for (size_t i = 0; i < R*C; i++)
+	{
+		data_[i] *= t;
+	}
+	return *this;
+}
+
+// I throw exception if t = 0 (undefined behavior in some cases)
+template <class T, size_t R, size_t C>
+SMat<T, R, C>& SMat<T, R, C>::operator/=(T t)
+{
+	if ( t == T(0) )
+	{
+		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in smat::operator/=(T t): DIVISION BY ZERO ";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	for (size_t i = 0; i < R*C; i++)
+	{
+		data_[i] /= t;
+	}
+	return *this;
+}
+
+template <class T, size_t R, size_t C>
+SMat<T, R, C>::operator Mat<T>() const
+{
+	Mat<T> m(R, C);
+	std::copy_n(data_, R*C, m.data());
+	return m;
+}
+
+
+// ##################################################################################################
+// ############################## DEFINITIONS OF svec, smat and friends #############################
+
+template <size_t N> using svec = SVec<double, N>;
+template <size_t N> using isvec = SVec<int, N>;
+template <size_t N> using csvec = SVec<std::complex<double>, N>;
+
+template <size_t R, size_t C> using smat = SMat<double, R, C>;
+template <size_t R, size_t C> using ismat = SMat<int, R, C>;
+template <size_t R, size_t C> using csmat = SMat<std::complex<double>, R, C>;
+
+
+// ##################################################################################################
+// ############################################ OPERATORS ###########################################
+
+template <class T, size_t N>
+inline SVec<T, N> operator+(SVec<T, N> l, const SVec<T, N>& r) { return l += r; }
+
+template <class T, size_t N>
+inline SVec<T, N> operator-(SVec<T, N> l, const SVec<T, N>& r) { return l -= r; }
+
+template <class T, size_t N>
+inline SVec<T, N> operator+(SVec<T, N> v, const typename SVec<T, N>::value_type& t) { return v += t; }
+
+template <class T, size_t N>
+inline SVec<T, N> operator-(SVec<T, N> v, const typename SVec<T, N>::value_type& t) { return v -= t; }
+
+template <class T, size_t N>
+inline SVec<T, N> operator*(SVec<T, N> v, const typename SVec<T, N>::value_type& t) { return v *= t; }
+
+template <class T, size_t N>
+inline SVec<T, N> operator/(SVec<T, N> v, const typename SVec<T, N>::value_type& t) { return v /= t; }
+
+// It returns the inner product of the vectors.
+template <class T, size_t N>
+inline T operator*(const SVec<T, N>& l, const SVec<T, N>& r)
+{
+	T result = T(0);
+	for (size_t i = 0; i < N; i++)
+	{
+		result += l(i)*r(i);
+	}
+	return result;
+}
+
+template <class T, size_t R, size_t C>
+inline SMat<T, R, C> operator+(SMat<T, R, C> l, const SMat<T, R, C>& r) { return l += r; }
+
+template <class T, size_t R, size_t C>
+inline SMat<T, R, C> operator-(SMat<T, R, C> l, const SMat<T, R, C>& r) { return l -= r; }
+
+template <class T, size_t R, size_t C>
+inline SMat<T, R, C> operator+(SMat<T, R, C> m, const typename SMat<T, R, C>::value_type& t) { return m += t; }
+
+template <class T, size_t R, size_t C>
+inline SMat<T, R, C> operator-(SMat<T, R, C> m, const typename SMat<T, R, C>::value_type& t) { return m -= t; }
+
+template <class T, size_t R, size_t C>
+inline SMat<T, R, C> operator*(SMat<T, R, C> m, const typename SMat<T, R, C>::value_type& t) { return m *= t; }
+
+template <class T, size_t R, size_t C>
+inline SMat<T, R, C> operator/(SMat<T, R, C> m, const typename SMat<T, R, C>::value_type& t) { return m /= t; }
+
+// It multiplies the R x K matrix l with the K x C matrix r.
+// A dimension mismatch does not compile.
+template <class T, size_t R, size_t K, size_t C>
+inline SMat<T, R, C> operator*(const SMat<T, R, K>& l, const SMat<T, K, C>& r)
+{
+	SMat<T, R, C> result;
+	for (size_t i = 0; i < R; i++)
+	{
+		for (size_t p = 0; p < K; p++)
+		{
+			const T l_ip = l(i,p);
+			for (size_t j = 0; j < C; j++)
+			{
+				result(i,j) += l_ip*r(p,j);
+			}
+		}
+	}
+	return result;
+}
+
+// It multiplies the R x C matrix m with the vector v of size C.
+template <class T, size_t R, size_t C>
+inline SVec<T, R> operator*(const SMat<T, R, C>& m, const SVec<T, C>& v)
+{
+	SVec<T, R> result;
+	for (size_t i = 0; i < R; i++)
+	{
+		T sum = T(0);
+		for (size_t j = 0; j < C; j++)
+		{
+			sum += m(i,j)*v(j);
+		}
+		result(i) = sum;
+	}
+	return result;
+}
+
+
+// ##################################################################################################
+// ############################ MISCELLANEOUS OPERATIONS AND FUNCTIONS ##############################
+
+// It returns the transposed of the matrix m.
+template <class T, size_t R, size_t C>
+inline SMat<T, C, R> transpose(const SMat<T, R, C>& m)
+{
+	SMat<T, C, R> result;
+	for (size_t i = 0; i < R; i++)
+	{
+		for (size_t j = 0; j < C; j++)
+		{
+			result(j,i) = m(i,j);
+		}
+	}
+	return result;
+}
+
+// It returns the N x N identity matrix.
+template <class T, size_t N>
+inline SMat<T, N, N> eye()
+{
+	SMat<T, N, N> result;
+	for (size_t i = 0; i < N; i++)
+	{
+		result(i,i) = T(1);
+	}
+	return result;
+}
+
+// It returns a vector containing the diagonal elements of matrix m.
+template <class T, size_t N>
+inline SVec<T, N> diag(const SMat<T, N, N>& m)
+{
+	SVec<T, N> result;
+	for (size_t i = 0; i < N; i++)
+	{
+		result(i) = m(i,i);
+	}
+	return result;
+}
+
+// It returns a matrix with diagonal elements the elements of vector v.
+template <class T, size_t N>
+inline SMat<T, N, N> diag(const SVec<T, N>& v)
+{
+	SMat<T, N, N> result;
+	for (size_t i = 0; i < N; i++)
+	{
+		result(i,i) = v(i);
+	}
+	return result;
+}
+
+// It computes the determinant of matrix m by Gaussian elimination
+// with partial pivoting. The sizes 1, 2 and 3 have closed forms below.
+template <class T, size_t N>
+inline T determinant(const SMat<T, N, N>& m)
+{
+	SMat<T, N, N> a = m;
+	T det = T(1);
+	size_t i, j, k, p;
+	for (k = 0; k < N; k++)
+	{
+		p = k;
+		for (i = k + 1; i < N; i++)
+		{
+			if ( std::abs(a(i,k)) > std::abs(a(p,k)) )
+			{
+				p = i;
+			}
+		}
+		if ( a(p,k) == T(0) )
+		{
+			return T(0);
+		}
+		if ( p != k )
+		{
+			std::swap_ranges(&a(p,0), &a(p,0) + N, &a(k,0));
+			det = -det;
+		}
+		det *= a(k,k);
+		for (i = k + 1; i < N; i++)
+		{
+			const T l_ik = a(i,k)/a(k,k);
+			for (j = k + 1; j < N; j++)
+			{
+				a(i,j) -= l_ik*a(k,j);
+			}
+		}
+	}
+	return det;
+}
+
+template <class T>
+inline T determinant(const SMat<T, 1, 1>& m)
+{
+	return m(0,0);
+}
+
+template <class T>
+inline T determinant(const SMat<T, 2, 2>& m)
+{
+	return m(0,0)*m(1,1) - m(0,1)*m(1,0);
+}
+
+template <class T>
+inline T determinant(const SMat<T, 3, 3>& m)
+{
+	return m(0,0)*(m(1,1)*m(2,2) - m(1,2)*m(2,1))
+	     - m(0,1)*(m(1,0)*m(2,2) - m(1,2)*m(2,0))
+	     + m(0,2)*(m(1,0)*m(2,1) - m(1,1)*m(2,0));
+}
+
+// It returns the matrix of NaNs that inv() returns for a singular matrix.
+template <class T, size_t N>
+inline SMat<T, N, N> inv_singular()
+{
+	LOG_WARNING(FILE_LINE_ERROR + "warning in  smat::inv(const smat& m): SINGULAR MATRIX.");
+	SMat<T, N, N> result;
+	std::fill(result.data(), result.data() + N*N, NaN(T));
+	return result;
+}
+
+// It computes the inverse of matrix m by Gauss-Jordan elimination
+// with partial pivoting. The sizes 1, 2 and 3 have closed forms below.
+template <class T, size_t N>
+inline SMat<T, N, N> inv(const SMat<T, N, N>& m)
+{
+	SMat<T, N, N> a = m, result = eye<T, N>();
+	size_t i, j, k, p;
+	for (k = 0; k < N; k++)
+	{
+		p = k;
+		for (i = k + 1; i < N; i++)
+		{
+			if ( std::abs(a(i,k)) > std::abs(a(p,k)) )
+			{
+				p = i;
+			}
+		}
+		if ( std::abs(a(p,k)) < SINGULARITY_THRESHOLD )
+		{
+			return inv_singular<T, N>();
+		}
+		if ( p != k )
+		{
+			std::swap_ranges(&a(p,0), &a(p,0) + N, &a(k,0));
+			std::swap_ranges(&result(p,0), &result(p,0) + N, &result(k,0));
+		}
+		const T pivot = T(1)/a(k,k);
+		for (j = 0; j < N; j++)
+		{
+			a(k,j) *= pivot;
+			result(k,j) *= pivot;
+		}
+		for (i = 0; i < N; i++)
+		{
+			if ( i != k )
+			{
+				const T l_ik = a(i,k);
+				for (j = 0; j < N; j++)
+				{
+					a(i,j) -= l_ik*a(k,j);
+					result(i,j) -= l_ik*result(k,j);
+				}
+			}
+		}
+	}
+	return result;
+}
+
+// It returns the smallest absolute pivot of the LU-Decomposition of m with
+// partial pivoting, without computing the decomposition, so that the closed
+// forms below find m singular exactly when the elimination above and
+// inv(const Mat&) do: the pivots are the largest element of the first
+// column, the largest element of the second column of its Schur complement
+// and |det| divided by the ones before.
+template <class T>
+inline double inv_min_pivot(const SMat<T, 2, 2>& m, const T& det)
+{
+	const double u00 = std::max(std::abs(m(0,0)), std::abs(m(1,0)));
+	if ( u00 == 0 )
+	{
+		return 0;
+	}
+	return std::min(u00, std::abs(det)/u00);
+}
+
+template <class T>
+inline double inv_min_pivot(const SMat<T, 3, 3>& m, const T& det)
+{
+	size_t p = 0, i;
+	for (i = 1; i < 3; i++)
+	{
+		if ( std::abs(m(i,0)) > std::abs(m(p,0)) )
+		{
+			p = i;
+		}
+	}
+	const double u00 = std::abs(m(p,0));
+	if ( u00 == 0 )
+	{
+		return 0;
+	}
+	const size_t r = (p == 0) ? 1 : 0, s = (p == 2) ? 1 : 2;
+	const double u11 = std::max(std::abs(m(r,1) - m(r,0)/m(p,0)*m(p,1)),
+	                            std::abs(m(s,1) - m(s,0)/m(p,0)*m(p,1)));
+	if ( u11 == 0 )
+	{
+		return 0;
+	}
+	return std::min(std::min(u00, u11), std::abs(det)/(u00*u11));
+}
+
+template <class T>
+inline SMat<T, 1, 1> inv(const SMat<T, 1, 1>& m)
+{
+	if ( std::abs(m(0,0)) < SINGULARITY_THRESHOLD )
+	{
+		return inv_singular<T, 1>();
+	}
+	return SMat<T, 1, 1>{ T(1)/m(0,0) };
+}
+
+template <class T>
+inline SMat<T, 2, 2> inv(const SMat<T, 2, 2>& m)
+{
+	const T det = determinant(m);
+	if ( inv_min_pivot(m, det) < SINGULARITY_THRESHOLD )
+	{
+		return inv_singular<T, 2>();
+	}
+	const T inv_det = T(1)/det;
+	return SMat<T, 2, 2>{  m(1,1)*inv_det, -m(0,1)*inv_det,
+	                      -m(1,0)*inv_det,  m(0,0)*inv_det };
+}
+
+template <class T>
+inline SMat<T, 3, 3> inv(const SMat<T, 3, 3>& m)
+{
+	const T det = determinant(m);
+	if ( inv_min_pivot(m, det) < SINGULARITY_THRESHOLD )
+	{
+		return inv_singular<T, 3>();
+	}
+	const T inv_det = T(1)/det;
+	return SMat<T, 3, 3>{
+		(m(1,1)*m(2,2) - m(1,2)*m(2,1))*inv_det, (m(0,2)*m(2,1) - m(0,1)*m(2,2))*inv_det, (m(0,1)*m(1,2) - m(0,2)*m(1,1))*inv_det,
+		(m(1,2)*m(2,0) - m(1,0)*m(2,2))*inv_det, (m(0,0)*m(2,2) - m(0,2)*m(2,0))*inv_det, (m(0,2)*m(1,0) - m(0,0)*m(1,2))*inv_det,
+		(m(1,0)*m(2,1) - m(1,1)*m(2,0))*inv_det, (m(0,1)*m(2,0) - m(0,0)*m(2,1))*inv_det, (m(0,0)*m(1,1) - m(0,1)*m(1,0))*inv_det };
+}
+
+// It prints the elements of the vector.
+template <class T, size_t N>
+inline void print(const SVec<T, N>& v)
+{
+	print(Vec<T>(v));
+}
+
+// It prints the elements of the matrix.
+template <class T, size_t R, size_t C>
+inline void print(const SMat<T, R, C>& m)
+{
+	print(Mat<T>(m));
+}
+
+} /* namespace algebra */
+
+#endif /* SMAT_H_ */
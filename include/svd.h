@@ -0,0 +1,345 @@
+/*============================================================================
+ * Name         : svd.h implements the singular value decomposition
+ *                A = U*diag(s)*V' (svd), the numerical rank (rank) and the
+ *                Moore-Penrose pseudoinverse (pinv) with a tolerance-based
+ *                rank cutoff.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* The economy size decomposition of an m x n matrix, k = min(m,n):
+ *
+ *     mat U, V; vec s;
+ *     svd(A, U, s, V);          // U: m x k, s: k (descending), V: n x k
+ *     vec s = svd(A);           // singular values only
+ *     size_t r = rank(A);       // singular values above the tolerance
+ *     mat X = pinv(A);          // X = V*diag(1/s)*U' over the first r
+ *
+ * A tall matrix is first reduced by a QR factorization (A = Q*R), so that
+ * the Jacobi sweeps run on the n x n factor R only. The default tolerance
+ * is max(m,n)*s(0)*eps, as in MATLAB and NumPy: singular values below it
+ * are treated as zero, which gives the minimum norm least-squares solution
+ * x = pinv(A)*b for rank deficient A instead of NaN.
+ */
+
+#ifndef SVD_H_
+#define SVD_H_
+
+#include <limits>
+#include <numeric>      // std::iota
+
+#include "mat.h"
+#include "qr.h"
+#include "kernels/svd.h"
+
+namespace algebra {
+
+// It computes the decomposition of the m x n matrix a with m >= n; u and
+// v are skipped when null.
+template <class T>
+void svd_tall(const Mat<T>& a, Mat<T>* u, vec& s, Mat<T>* v)
+{
+	size_t m = a.rows(), n = a.cols(), i, j, p, q;
+
+	// w = R^H (or a^H for a square a) holds the columns of R in its rows.
+	QR<T> f;
+	Mat<T> w(n, n);
+	if ( m > n )
+	{
+		f.compute(a);
+		const T* r = f.factors().data();
+		for (i = 0; i < n; i++)
+		{
+			for (j = i; j < n; j++)
+			{
+				w.data()[j*n + i] = scalar_conj(r[i*n + j]);
+			}
+		}
+	}
+	else
+	{
+		for (i = 0; i < n; i++)
+		{
+			for (j = 0; j < n; j++)
+			{
+				w.data()[j*n + i] = scalar_conj(a.data()[i*n + j]);
+			}
+		}
+	}
+	Mat<T> vh;
+	if ( v )
+	{
+		vh = Mat<T>(n, n);
+		for (i = 0; i < n; i++)
+		{
+			vh.data()[i*n + i] = T(1);
+		}
+	}
+	svd_jacobi(n, n, w.data(), w.ld(), v ? vh.data() : (T*) nullptr, n);
+
+	// The singular values are the norms of the rows of w, in descending order.
+	std::vector<double> sigma(n);
+	std::vector<size_t> order(n);
+	for (i = 0; i < n; i++)
+	{
+		double norm2 = 0;
+		for (j = 0; j < n; j++)
+		{
+			norm2 += scalar_abs2(w.data()[i*n + j]);
+		}
+		sigma[i] = std::sqrt(norm2);
+	}
+	std::iota(order.begin(), order.end(), (size_t) 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return sigma[x] > sigma[y]; });
+	s = vec(n);
+	for (i = 0; i < n; i++)
+	{
+		s.data()[i] = sigma[order[i]];
+	}
+
+	if ( v )
+	{
+		*v = Mat<T>(n, n);
+		for (j = 0; j < n; j++)
+		{
+			const T* row = vh.data() + order[j]*n;
+			for (i = 0; i < n; i++)
+			{
+				v->data()[i*n + j] = scalar_conj(row[i]);
+			}
+		}
+	}
+	if ( !u )
+	{
+		return;
+	}
+
+	// u(:,j) = conj(w(order[j],:))/s(j). The columns of the (numerically)
+	// zero singular values are completed by Gram-Schmidt on e(0), e(1), ...
+	Mat<T> u_n(n, n);
+	const double cutoff = n*std::numeric_limits<double>::epsilon()*(n ? s.data()[0] : 0);
+	std::vector<size_t> done;
+	std::vector<T> c(n);
+	for (j = 0; j < n; j++)
+	{
+		double s_j = s.data()[j];
+		if ( s_j > cutoff && s_j > 0 )
+		{
+			const T* row = w.data() + order[j]*n;
+			for (i = 0; i < n; i++)
+			{
+				u_n.data()[i*n + j] = scalar_conj(row[i])/T(s_j);
+			}
+			done.push_back(j);
+		}
+	}
+	for (j = 0, q = 0; j < n && done.size() < n; j++)
+	{
+		if ( s.data()[j] > cutoff && s.data()[j] > 0 )
+		{
+			continue;
+		}
+		for (; q < n; q++)
+		{
+			std::fill(c.begin(), c.end(), T(0));
+			c[q] = T(1);
+			int pass;
+			for (pass = 0; pass < 2; pass++)
+			{
+				for (p = 0; p < done.size(); p++)
+				{
+					T dot = T(0);
+					for (i = 0; i < n; i++)
+					{
+						dot += scalar_conj(u_n.data()[i*n + done[p]])*c[i];
+					}
+					for (i = 0; i < n; i++)
+					{
+						c[i] -= dot*u_n.data()[i*n + done[p]];
+					}
+				}
+			}
+			double norm2 = 0;
+			for (i = 0; i < n; i++)
+			{
+				norm2 += scalar_abs2(c[i]);
+			}
+			if ( norm2 > 0.25 )
+			{
+				for (i = 0; i < n; i++)
+				{
+					u_n.data()[i*n + j] = c[i]/T(std::sqrt(norm2));
+				}
+				done.push_back(j);
+				q++;
+				break;
+			}
+		}
+	}
+
+	if ( m > n )
+	{
+		// u = Q*[u_n; 0], applied through the reflectors of the QR.
+		Mat<T> u_m(m, n);
+		std::copy_n(u_n.data(), n*n, u_m.data());
+		*u = f.apply_q(u_m);
+	}
+	else
+	{
+		*u = std::move(u_n);
+	}
+}
+
+// It returns the conjugate transpose of the matrix a.
+template <class T>
+Mat<T> svd_adjoint(const Mat<T>& a)
+{
+	size_t m = a.rows(), n = a.cols(), i;
+	Mat<T> a_h(n, m);
+	transpose_kernel(m, n, a.data(), n, a_h.data(), m);
+	for (i = 0; i < a_h.size(); i++)
+	{
+		a_h.data()[i] = scalar_conj(a_h.data()[i]);
+	}
+	return a_h;
+}
+
+template <class T>
+void svd_check(const Mat<T>& a, const char* function)
+{
+	if ( a.size() == 0 )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in " + function + ": Not defined for NULL MATRIX";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+}
+
+// It computes the economy size singular value decomposition
+// a = u*diag(s)*v', with the singular values s in descending order.
+template <class T>
+inline void svd(const Mat<T>& a, Mat<T>& u, vec& s, Mat<T>& v)
+{
+	svd_check(a, "svd(const mat& a, mat& u, vec& s, mat& v)");
+	if ( a.rows() >= a.cols() )
+	{
+		svd_tall(a, &u, s, &v);
+	}
+	else
+	{
+		// a' = v*diag(s)*u'
+		svd_tall(svd_adjoint(a), &v, s, &u);
+	}
+}
+
+// It returns the singular values of a in descending order.
+template <class T>
+inline vec svd(const Mat<T>& a)
+{
+	svd_check(a, "svd(const mat& a)");
+	vec s;
+	svd_tall(a.rows() >= a.cols() ? a : svd_adjoint(a), (Mat<T>*) nullptr, s, (Mat<T>*) nullptr);
+	return s;
+}
+
+// It returns the default tolerance of the rank cutoff.
+inline double svd_default_tolerance(size_t m, size_t n, const vec& s)
+{
+	return std::max(m, n)*std::numeric_limits<double>::epsilon()*(s.size() ? s.data()[0] : 0);
+}
+
+// It returns the number of singular values of a above tol. A negative
+// tol selects the default max(m,n)*s(0)*eps.
+template <class T>
+inline size_t rank(const Mat<T>& a, double tol = -1)
+{
+	vec s = svd(a);
+	if ( tol < 0 )
+	{
+		tol = svd_default_tolerance(a.rows(), a.cols(), s);
+	}
+	size_t r = 0;
+	while ( r < s.size() && s.data()[r] > tol )
+	{
+		r++;
+	}
+	return r;
+}
+
+// It computes the Moore-Penrose pseudoinverse of a: pinv(a) = V*inv(S)*U'
+// over the singular values above tol. A negative tol selects the default
+// max(m,n)*s(0)*eps. The result satisfies a*pinv(a)*a = a for every a,
+// rank deficient or not.
+template <class T>
+inline Mat<T> pinv(const Mat<T>& a, double tol = -1)
+{
+	svd_check(a, "pinv(const mat& a)");
+	size_t m = a.rows(), n = a.cols(), i, j;
+	Mat<T> u, v;
+	vec s;
+	svd(a, u, s, v);
+	if ( tol < 0 )
+	{
+		tol = svd_default_tolerance(m, n, s);
+	}
+	size_t r = 0, k = s.size();
+	while ( r < k && s.data()[r] > tol )
+	{
+		r++;
+	}
+
+	// x = (v(:,0:r)*inv(S)) * u(:,0:r)'
+	Mat<T> x(n, m);
+	if ( r == 0 )
+	{
+		return x;
+	}
+	std::vector<T, workspace_allocator<T> > v_s(n*r), u_h(r*m);
+	for (i = 0; i < n; i++)
+	{
+		for (j = 0; j < r; j++)
+		{
+			v_s[i*r + j] = v.data()[i*k + j]/T(s.data()[j]);
+		}
+	}
+	for (i = 0; i < m; i++)
+	{
+		for (j = 0; j < r; j++)
+		{
+			u_h[j*m + i] = scalar_conj(u.data()[i*k + j]);
+		}
+	}
+	gemm(n, m, r, v_s.data(), r, (size_t) 1, u_h.data(), m, (size_t) 1, x.data(), x.ld());
+	return x;
+}
+
+// It computes the pseudoinverse of the matrix expression e.
+template <class E>
+inline Mat<typename E::value_type> pinv(const MatExpr<E>& e, double tol = -1)
+{
+	return pinv(eval(e), tol);
+}
+
+} /* namespace algebra */
+
+#endif /* SVD_H_ */
@@ -0,0 +1,1105 @@
+/*============================================================================
+ * Name         : text_io.h implements the readers and writers of the text
+ *                formats exchanged with other tools: CSV (read_csv,
+ *                write_csv) and Matrix Market (read_mtx, read_mtx_coordinate,
+ *                write_mtx), with CooMat, a sparse matrix in coordinate form.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/*     mat a = read_csv<double>("log.csv", ',', 1);   // skips a header line
+ *     write_csv("out.csv", a);
+ *     mat k = read_mtx<double>("k.mtx");             // array or coordinate
+ *     CooMat<double> s = read_mtx_coordinate<double>("k.mtx");
+ *     write_mtx("s.mtx", s);                         // coordinate format
+ *
+ * A reader maps the file and cuts it into chunks of get_text_chunk_size()
+ * Bytes that end at a line boundary. The chunks are scanned in parallel
+ * to count their records, which gives every chunk the row it starts at;
+ * a second parallel pass parses them straight into the result. Errors
+ * name the line of the file. A writer formats blocks of rows in parallel
+ * and writes them in order through one descriptor.
+ *
+ * The CSV fields are numbers; quoted fields are not supported. An empty
+ * field of a floating point matrix reads as NaN. A symmetric, skew-
+ * symmetric or hermitian Matrix Market file is expanded to all its
+ * entries.
+ */
+
+#ifndef TEXT_IO_H_
+#define TEXT_IO_H_
+
+#include <stddef.h>     // size_t
+#include <stdlib.h>     // strtod, strtol, strtoull
+#include <stdio.h>      // snprintf
+#include <string.h>     // memchr, memcpy
+#include <errno.h>
+#include <strings.h>    // strncasecmp
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+#include <sys/mman.h>   // mmap, madvise
+#include <sys/stat.h>   // fstat
+#include <string>
+#include <vector>
+#include <complex>
+#include <limits>
+#include <atomic>
+#include <type_traits>  // std::is_arithmetic
+#include <stdexcept>
+
+#include "mat.h"
+#include "serialize.h"
+#include "kernels/scalar.h"
+#include "kernels/thread_pool.h"
+
+// Default Bytes of text parsed by one task of a reader.
+#define TEXT_CHUNK_SIZE (4 << 20)
+// Elements formatted by one task of a writer.
+#define TEXT_WRITE_BLOCK (1 << 15)
+// Longest number accepted in a field.
+#define TEXT_TOKEN_MAX 128
+
+namespace algebra {
+
+inline std::atomic<size_t>& text_chunk_slot()
+{
+	static std::atomic<size_t> slot(TEXT_CHUNK_SIZE);
+	return slot;
+}
+
+inline size_t get_text_chunk_size() noexcept { return text_chunk_slot().load(); }
+
+// It sets the Bytes of text parsed by one task (the default when 0).
+inline void set_text_chunk_size(size_t bytes) noexcept
+{
+	text_chunk_slot().store(bytes ? bytes : TEXT_CHUNK_SIZE);
+}
+
+inline std::invalid_argument text_error(const char* where, const std::string& path, size_t line, const std::string& what)
+{
+	std::string msg = FILE_LINE_ERROR + " exception in " + where + ": " + path + ":" + std::to_string(line) + ": " + what;
+	log_error(msg.c_str());
+	return std::invalid_argument(msg);
+}
+
+// ##################################################################################################
+// ############################################# READING ############################################
+
+// A file mapped read-only for parsing.
+class text_file {
+public:
+	text_file(const std::string& path, const char* where) : map_(nullptr), size_(0)
+	{
+		array_file f(path, where);
+		struct stat st;
+		if (fstat(f.fd(), &st) != 0)
+		{
+			throw array_io_error(where, path);
+		}
+		size_ = (size_t) st.st_size;
+		if (size_ > 0)
+		{
+			void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, f.fd(), 0);
+			if (p == MAP_FAILED)
+			{
+				throw array_io_error(where, path);
+			}
+			map_ = static_cast<char*>(p);
+			madvise(map_, size_, MADV_SEQUENTIAL);
+		}
+	}
+	text_file(const text_file&) = delete;
+	text_file& operator=(const text_file&) = delete;
+	~text_file()
+	{
+		if (map_)
+		{
+			munmap(map_, size_);
+		}
+	}
+
+	const char* begin() const noexcept { return map_; }
+	const char* end() const noexcept { return map_ + size_; }
+
+private:
+	char* map_;
+	size_t size_;
+};
+
+// It returns the end of the line that starts at p: its '\n' or end.
+inline const char* text_line_end(const char* p, const char* end)
+{
+	const char* q = static_cast<const char*>(memchr(p, '\n', end - p));
+	return q ? q : end;
+}
+
+inline bool text_is_blank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+// It trims the blanks around the text [b, e).
+inline void text_trim(const char*& b, const char*& e)
+{
+	while (b < e && text_is_blank(*b))
+	{
+		b++;
+	}
+	while (e > b && text_is_blank(e[-1]))
+	{
+		e--;
+	}
+}
+
+// It cuts [p, end) into chunks of about get_text_chunk_size() Bytes that
+// end after a newline; chunk k is [cuts[k], cuts[k + 1]).
+inline std::vector<const char*> text_split(const char* p, const char* end)
+{
+	const size_t chunk = get_text_chunk_size();
+	std::vector<const char*> cuts(1, p);
+	while ((size_t) (end - cuts.back()) > chunk)
+	{
+		const char* q = static_cast<const char*>(memchr(cuts.back() + chunk, '\n', end - cuts.back() - chunk));
+		if (!q)
+		{
+			break;
+		}
+		cuts.push_back(q + 1);
+	}
+	cuts.push_back(end);
+	return cuts;
+}
+
+// The fields of a record, separated by delimiter; a blank delimiter
+// stands for any run of blanks.
+class text_fields {
+public:
+	text_fields(const char* b, const char* e, char delimiter) :
+		p_(b), e_(e), delimiter_(delimiter), blank_(delimiter == ' ' || delimiter == '\t'), done_(false) {}
+
+	// It returns the next field in [b, f), trimmed; false after the last.
+	bool next(const char*& b, const char*& f)
+	{
+		if (blank_)
+		{
+			while (p_ < e_ && text_is_blank(*p_))
+			{
+				p_++;
+			}
+			if (p_ == e_)
+			{
+				return false;
+			}
+			b = p_;
+			while (p_ < e_ && !text_is_blank(*p_))
+			{
+				p_++;
+			}
+			f = p_;
+			return true;
+		}
+		if (done_)
+		{
+			return false;
+		}
+		const char* q = static_cast<const char*>(memchr(p_, delimiter_, e_ - p_));
+		b = p_;
+		f = q ? q : e_;
+		p_ = q ? q + 1 : e_;
+		done_ = !q;
+		text_trim(b, f);
+		return true;
+	}
+
+private:
+	const char* p_;
+	const char* e_;
+	char delimiter_;
+	bool blank_;
+	bool done_;
+};
+
+// It parses the number [b, f) into v and returns false when it is not one.
+inline bool text_parse(const char* b, const char* f, double& v)
+{
+	char buffer[TEXT_TOKEN_MAX];
+	const size_t n = f - b;
+	if (n == 0 || n >= TEXT_TOKEN_MAX)
+	{
+		return false;
+	}
+	memcpy(buffer, b, n);
+	buffer[n] = '\0';
+	char* stop;
+	v = strtod(buffer, &stop);
+	return stop == buffer + n;
+}
+
+inline bool text_parse(const char* b, const char* f, int& v)
+{
+	char buffer[TEXT_TOKEN_MAX];
+	const size_t n = f - b;
+	if (n == 0 || n >= TEXT_TOKEN_MAX)
+	{
+		return false;
+	}
+	memcpy(buffer, b, n);
+	buffer[n] = '\0';
+	char* stop;
+	long x = strtol(buffer, &stop, 10);
+	v = (int) x;
+	return stop == buffer + n && x >= std::numeric_limits<int>::min() && x <= std::numeric_limits<int>::max();
+}
+
+inline bool text_parse(const char* b, const char* f, size_t& v)
+{
+	char buffer[TEXT_TOKEN_MAX];
+	const size_t n = f - b;
+	if (n == 0 || n >= TEXT_TOKEN_MAX || *b < '0' || *b > '9')
+	{
+		return false;
+	}
+	memcpy(buffer, b, n);
+	buffer[n] = '\0';
+	char* stop;
+	errno = 0;
+	unsigned long long x = strtoull(buffer, &stop, 10);
+	v = (size_t) x;
+	return stop == buffer + n && errno == 0 && x <= std::numeric_limits<size_t>::max();
+}
+
+// What a chunk scan found: its lines, the records among them, the fields
+// of its first record and the first record (a line index within the
+// chunk) whose field count differs from that one.
+struct text_chunk_info {
+	size_t lines;
+	size_t records;
+	size_t fields;
+	size_t first;
+	size_t bad;
+};
+
+// It scans the chunk [p, end) of a CSV file.
+inline text_chunk_info csv_scan(const char* p, const char* end, char delimiter)
+{
+	const size_t npos = std::numeric_limits<size_t>::max();
+	text_chunk_info info = { 0, 0, 0, npos, npos };
+	while (p < end)
+	{
+		const char* e = text_line_end(p, end);
+		const char* b = p;
+		p = e < end ? e + 1 : end;
+		info.lines++;
+		text_trim(b, e);
+		if (b == e)
+		{
+			continue;
+		}
+		size_t count = 0;
+		const char *f0, *f1;
+		text_fields fields(b, e, delimiter);
+		while (fields.next(f0, f1))
+		{
+			count++;
+		}
+		if (info.records == 0)
+		{
+			info.fields = count;
+			info.first = info.lines - 1;
+		}
+		else if (count != info.fields && info.bad == npos)
+		{
+			info.bad = info.lines - 1;
+		}
+		info.records++;
+	}
+	return info;
+}
+
+// It parses the records of the chunk [p, end) of a CSV file, the first of
+// which is on line line, to out.
+template <class T>
+void csv_parse(const char* p, const char* end, char delimiter, T* out, size_t line,
+		const std::string& path, const char* where)
+{
+	for (; p < end; line++)
+	{
+		const char* e = text_line_end(p, end);
+		const char* b = p;
+		p = e < end ? e + 1 : end;
+		text_trim(b, e);
+		if (b == e)
+		{
+			continue;
+		}
+		const char *f0, *f1;
+		text_fields fields(b, e, delimiter);
+		while (fields.next(f0, f1))
+		{
+			if (f0 == f1 && std::numeric_limits<T>::has_quiet_NaN)
+			{
+				*out++ = std::numeric_limits<T>::quiet_NaN();
+			}
+			else if (!text_parse(f0, f1, *out++))
+			{
+				throw text_error(where, path, line, "invalid number '" + std::string(f0, f1 - f0) + "'");
+			}
+		}
+	}
+}
+
+// It reads the CSV file path into a matrix, one record per row, skipping
+// its first skip lines (a header). The records must all have the same
+// number of fields; blank lines are ignored.
+template <class T>
+Mat<T> read_csv(const std::string& path, char delimiter = ',', size_t skip = 0)
+{
+	static_assert(std::is_arithmetic<T>::value, "read_csv() reads real or integer matrices");
+	const char* where = "read_csv(const std::string& path, char delimiter, size_t skip)";
+	text_file file(path, where);
+	const char* p = file.begin();
+	size_t line = 1, k;
+	for (; line <= skip && p < file.end(); line++)
+	{
+		const char* e = text_line_end(p, file.end());
+		p = e < file.end() ? e + 1 : file.end();
+	}
+
+	const std::vector<const char*> cuts = text_split(p, file.end());
+	const size_t chunks = cuts.size() - 1;
+	std::vector<text_chunk_info> info(chunks);
+	parallel_for(0, chunks, 1, [&](size_t lo, size_t hi)
+	{
+		for (size_t c = lo; c < hi; c++)
+		{
+			info[c] = csv_scan(cuts[c], cuts[c + 1], delimiter);
+		}
+	});
+
+	// The first line and the first row of every chunk.
+	std::vector<size_t> first_line(chunks), first_row(chunks);
+	size_t rows = 0, cols = 0;
+	bool found = false;
+	for (k = 0; k < chunks; k++)
+	{
+		first_line[k] = line;
+		first_row[k] = rows;
+		if (info[k].records > 0)
+		{
+			if (!found)
+			{
+				cols = info[k].fields;
+				found = true;
+			}
+			if (info[k].fields != cols)
+			{
+				throw text_error(where, path, line + info[k].first, "expected " + std::to_string(cols) + " fields");
+			}
+			if (info[k].bad != std::numeric_limits<size_t>::max())
+			{
+				throw text_error(where, path, line + info[k].bad, "expected " + std::to_string(cols) + " fields");
+			}
+		}
+		line += info[k].lines;
+		rows += info[k].records;
+	}
+	if (rows == 0)
+	{
+		return Mat<T>();
+	}
+
+	Mat<T> m(rows, cols);
+	parallel_for(0, chunks, 1, [&](size_t lo, size_t hi)
+	{
+		for (size_t c = lo; c < hi; c++)
+		{
+			csv_parse(cuts[c], cuts[c + 1], delimiter, m.data() + first_row[c]*cols, first_line[c], path, where);
+		}
+	});
+	return m;
+}
+
+// ##################################################################################################
+// ############################################# WRITING ############################################
+
+// It appends the shortest of the %.15g and %.17g forms of v that reads
+// back as v.
+inline void text_format(std::string& s, double v)
+{
+	char buffer[32];
+	int n = snprintf(buffer, sizeof(buffer), "%.15g", v);
+	if (strtod(buffer, nullptr) != v)
+	{
+		n = snprintf(buffer, sizeof(buffer), "%.17g", v);
+	}
+	s.append(buffer, n);
+}
+
+// It appends u, preceded by a minus sign when negative is set.
+inline void text_format_integer(std::string& s, unsigned long long u, bool negative)
+{
+	char buffer[24];
+	char* p = buffer + sizeof(buffer);
+	do
+	{
+		*--p = (char) ('0' + u % 10);
+		u /= 10;
+	} while (u);
+	if (negative)
+	{
+		*--p = '-';
+	}
+	s.append(p, buffer + sizeof(buffer) - p);
+}
+
+inline void text_format(std::string& s, int v)
+{
+	text_format_integer(s, v < 0 ? 0ull - (unsigned long long) v : (unsigned long long) v, v < 0);
+}
+
+inline void text_format(std::string& s, size_t v)
+{
+	text_format_integer(s, v, false);
+}
+
+inline void text_format(std::string& s, const std::complex<double>& v)
+{
+	text_format(s, v.real());
+	s += ' ';
+	text_format(s, v.imag());
+}
+
+// A file written in blocks formatted in parallel.
+class text_writer {
+public:
+	text_writer(const std::string& path, const char* where) :
+		path_(path), where_(where), fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644))
+	{
+		if (fd_ < 0)
+		{
+			throw array_io_error(where_, path_);
+		}
+	}
+	text_writer(const text_writer&) = delete;
+	text_writer& operator=(const text_writer&) = delete;
+	~text_writer()
+	{
+		if (fd_ >= 0)
+		{
+			::close(fd_);
+		}
+	}
+
+	void write(const std::string& s)
+	{
+		if (!array_write_all(fd_, s.data(), s.size()))
+		{
+			throw array_io_error(where_, path_);
+		}
+	}
+
+	// It writes the items [0, n): format(i0, i1, s) appends the text of
+	// the items [i0, i1) to s. Blocks of block items are formatted in
+	// parallel, a batch of them at a time, and written in order.
+	template <class F>
+	void write_blocks(size_t n, size_t block, const F& format)
+	{
+		const size_t batch = block*std::max((size_t) 1, 2*get_num_threads());
+		std::vector<std::string> text;
+		size_t b0, k;
+		for (b0 = 0; b0 < n; b0 += batch)
+		{
+			const size_t b1 = std::min(n, b0 + batch), blocks = (b1 - b0 + block - 1)/block;
+			text.resize(blocks);
+			parallel_for(0, blocks, 1, [&](size_t lo, size_t hi)
+			{
+				for (size_t t = lo; t < hi; t++)
+				{
+					text[t].clear();
+					format(b0 + t*block, std::min(b1, b0 + (t + 1)*block), text[t]);
+				}
+			});
+			for (k = 0; k < blocks; k++)
+			{
+				write(text[k]);
+			}
+		}
+	}
+
+	void close()
+	{
+		const int fd = fd_;
+		fd_ = -1;
+		if (::close(fd) != 0)
+		{
+			throw array_io_error(where_, path_);
+		}
+	}
+
+private:
+	std::string path_;
+	const char* where_;
+	int fd_;
+};
+
+// It returns the items of a block of the writers for items of size
+// elements.
+inline size_t text_block(size_t size)
+{
+	return std::max((size_t) 1, (size_t) TEXT_WRITE_BLOCK/std::max((size_t) 1, size));
+}
+
+// It writes the matrix m to the CSV file path, one row per line.
+template <class T>
+void write_csv(const std::string& path, const Mat<T>& m, char delimiter = ',')
+{
+	static_assert(std::is_arithmetic<T>::value, "write_csv() writes real or integer matrices");
+	text_writer out(path, "write_csv(const std::string& path, const mat& m, char delimiter)");
+	const size_t cols = m.cols();
+	const T* data = m.data();
+	out.write_blocks(m.rows(), text_block(cols), [=](size_t r0, size_t r1, std::string& s)
+	{
+		size_t i, j;
+		for (i = r0; i < r1; i++)
+		{
+			for (j = 0; j < cols; j++)
+			{
+				if (j)
+				{
+					s += delimiter;
+				}
+				text_format(s, data[i*cols + j]);
+			}
+			s += '\n';
+		}
+	});
+	out.close();
+}
+
+// ##################################################################################################
+// ########################################## MATRIX MARKET #########################################
+
+// A sparse rows x cols matrix in coordinate form: entry k is the value
+// value[k] at (row[k], col[k]), zero-based.
+template <class T>
+struct CooMat {
+	size_t rows;
+	size_t cols;
+	std::vector<size_t> row;
+	std::vector<size_t> col;
+	std::vector<T> value;
+
+	CooMat() : rows(0), cols(0) {}
+	CooMat(size_t r, size_t c) : rows(r), cols(c) {}
+
+	size_t nnz() const noexcept { return value.size(); }
+	// It returns the dense matrix; repeated entries are summed.
+	Mat<T> to_mat() const;
+};
+
+template <class T>
+Mat<T> CooMat<T>::to_mat() const
+{
+	Mat<T> m(rows, cols);
+	size_t k;
+	for (k = 0; k < value.size(); k++)
+	{
+		m.data()[row[k]*cols + col[k]] += value[k];
+	}
+	return m;
+}
+
+enum mtx_field { MTX_REAL, MTX_INTEGER, MTX_COMPLEX, MTX_PATTERN };
+enum mtx_symmetry { MTX_GENERAL, MTX_SYMMETRIC, MTX_SKEW_SYMMETRIC, MTX_HERMITIAN };
+
+template <class T>
+struct mtx_type;
+
+template <>
+struct mtx_type<int> { static const char* name() { return "integer"; } };
+template <>
+struct mtx_type<double> { static const char* name() { return "real"; } };
+template <>
+struct mtx_type< std::complex<double> > { static const char* name() { return "complex"; } };
+
+// The banner and the size line of a Matrix Market file.
+struct mtx_header {
+	bool coordinate;
+	mtx_field field;
+	mtx_symmetry symmetry;
+	size_t rows;
+	size_t cols;
+	size_t entries;     // of the file, before the symmetric expansion
+	size_t line;        // of the first entry
+	const char* data;   // the first entry
+};
+
+inline bool mtx_word(const char* b, const char* f, const char* word)
+{
+	const size_t n = strlen(word);
+	return (size_t) (f - b) == n && strncasecmp(b, word, n) == 0;
+}
+
+// It reads the header of a Matrix Market file for elements of type T.
+template <class T>
+mtx_header mtx_read_header(const text_file& file, const std::string& path, const char* where)
+{
+	mtx_header h;
+	const char* p = file.begin();
+	const char* end = file.end();
+	const char* e = p ? text_line_end(p, end) : p;
+	const char* b[5];
+	const char* f[5];
+	text_fields banner(p, e, ' ');
+	size_t n = 0;
+	while (n < 5 && banner.next(b[n], f[n]))
+	{
+		n++;
+	}
+	if (n < 5 || !mtx_word(b[0], f[0], "%%MatrixMarket") || !mtx_word(b[1], f[1], "matrix"))
+	{
+		throw text_error(where, path, 1, "not a Matrix Market matrix file");
+	}
+	if (mtx_word(b[2], f[2], "coordinate"))
+	{
+		h.coordinate = true;
+	}
+	else if (mtx_word(b[2], f[2], "array"))
+	{
+		h.coordinate = false;
+	}
+	else
+	{
+		throw text_error(where, path, 1, "unknown format '" + std::string(b[2], f[2] - b[2]) + "'");
+	}
+	if (mtx_word(b[3], f[3], "real") || mtx_word(b[3], f[3], "double"))
+	{
+		h.field = MTX_REAL;
+	}
+	else if (mtx_word(b[3], f[3], "integer"))
+	{
+		h.field = MTX_INTEGER;
+	}
+	else if (mtx_word(b[3], f[3], "complex"))
+	{
+		h.field = MTX_COMPLEX;
+	}
+	else if (mtx_word(b[3], f[3], "pattern") && h.coordinate)
+	{
+		h.field = MTX_PATTERN;
+	}
+	else
+	{
+		throw text_error(where, path, 1, "unknown field '" + std::string(b[3], f[3] - b[3]) + "'");
+	}
+	if (mtx_word(b[4], f[4], "general"))
+	{
+		h.symmetry = MTX_GENERAL;
+	}
+	else if (mtx_word(b[4], f[4], "symmetric"))
+	{
+		h.symmetry = MTX_SYMMETRIC;
+	}
+	else if (mtx_word(b[4], f[4], "skew-symmetric"))
+	{
+		h.symmetry = MTX_SKEW_SYMMETRIC;
+	}
+	else if (mtx_word(b[4], f[4], "hermitian") && h.field == MTX_COMPLEX)
+	{
+		h.symmetry = MTX_HERMITIAN;
+	}
+	else
+	{
+		throw text_error(where, path, 1, "unknown symmetry '" + std::string(b[4], f[4] - b[4]) + "'");
+	}
+	if (h.field == MTX_COMPLEX && std::is_arithmetic<T>::value)
+	{
+		throw text_error(where, path, 1, "complex entries cannot be read into a real matrix");
+	}
+	if (h.field == MTX_REAL && std::is_integral<T>::value)
+	{
+		throw text_error(where, path, 1, "real entries cannot be read into an integer matrix");
+	}
+
+	// The comments, then the size line.
+	size_t line = 1;
+	p = e < end ? e + 1 : end;
+	for (;;)
+	{
+		line++;
+		if (p == end)
+		{
+			throw text_error(where, path, line, "missing size line");
+		}
+		e = text_line_end(p, end);
+		const char* s0 = p;
+		const char* s1 = e;
+		p = e < end ? e + 1 : end;
+		text_trim(s0, s1);
+		if (s0 == s1 || *s0 == '%')
+		{
+			continue;
+		}
+		size_t size[3] = { 0, 0, 0 }, k = 0;
+		const char *t0, *t1;
+		text_fields fields(s0, s1, ' ');
+		bool valid = true;
+		while (fields.next(t0, t1))
+		{
+			valid = valid && k < 3 && text_parse(t0, t1, size[k]);
+			k++;
+		}
+		if (!valid || k != (h.coordinate ? 3u : 2u))
+		{
+			throw text_error(where, path, line, "invalid size line");
+		}
+		h.rows = size[0];
+		h.cols = size[1];
+		if (h.symmetry != MTX_GENERAL && h.rows != h.cols)
+		{
+			throw text_error(where, path, line, "a symmetric matrix must be square");
+		}
+		if (h.coordinate)
+		{
+			h.entries = size[2];
+		}
+		else if (h.symmetry == MTX_GENERAL)
+		{
+			h.entries = h.rows*h.cols;
+		}
+		else
+		{
+			// The lower triangle, with the diagonal unless skew-symmetric.
+			h.entries = h.symmetry == MTX_SKEW_SYMMETRIC ? h.rows*(h.rows - (h.rows > 0))/2 : h.rows*(h.rows + 1)/2;
+		}
+		h.line = line + 1;
+		h.data = p;
+		return h;
+	}
+}
+
+// It parses the value of an entry of a file of the given field.
+template <class T>
+bool mtx_parse_value(text_fields& fields, mtx_field field, T& v)
+{
+	if (field == MTX_PATTERN)
+	{
+		v = T(1);
+		return true;
+	}
+	const char *b, *f;
+	return fields.next(b, f) && text_parse(b, f, v);
+}
+
+inline bool mtx_parse_value(text_fields& fields, mtx_field field, std::complex<double>& v)
+{
+	double re = 1, im = 0;
+	const char *b, *f;
+	if (field != MTX_PATTERN && !(fields.next(b, f) && text_parse(b, f, re)))
+	{
+		return false;
+	}
+	if (field == MTX_COMPLEX && !(fields.next(b, f) && text_parse(b, f, im)))
+	{
+		return false;
+	}
+	v = std::complex<double>(re, im);
+	return true;
+}
+
+// It returns the mirror of the value v of an entry below the diagonal.
+template <class T>
+inline T mtx_mirror(mtx_symmetry symmetry, const T& v)
+{
+	if (symmetry == MTX_SKEW_SYMMETRIC)
+	{
+		return -v;
+	}
+	return symmetry == MTX_HERMITIAN ? scalar_conj(v) : v;
+}
+
+// It scans the entries [p, end) of a Matrix Market file: every line that
+// is neither blank nor a comment is a record.
+inline text_chunk_info mtx_scan(const char* p, const char* end)
+{
+	const size_t npos = std::numeric_limits<size_t>::max();
+	text_chunk_info info = { 0, 0, 0, npos, npos };
+	while (p < end)
+	{
+		const char* e = text_line_end(p, end);
+		const char* b = p;
+		p = e < end ? e + 1 : end;
+		info.lines++;
+		text_trim(b, e);
+		if (b < e && *b != '%')
+		{
+			info.records++;
+		}
+	}
+	return info;
+}
+
+// It splits the entries of the file h in chunks, scans them and returns
+// the first line and the first entry of every chunk.
+inline std::vector<const char*> mtx_split(const text_file& file, const mtx_header& h,
+		std::vector<size_t>& first_line, std::vector<size_t>& first_entry, const std::string& path, const char* where)
+{
+	const std::vector<const char*> cuts = text_split(h.data, file.end());
+	const size_t chunks = cuts.size() - 1;
+	std::vector<text_chunk_info> info(chunks);
+	parallel_for(0, chunks, 1, [&](size_t lo, size_t hi)
+	{
+		for (size_t c = lo; c < hi; c++)
+		{
+			info[c] = mtx_scan(cuts[c], cuts[c + 1]);
+		}
+	});
+	first_line.resize(chunks);
+	first_entry.resize(chunks);
+	size_t line = h.line, entries = 0, k;
+	for (k = 0; k < chunks; k++)
+	{
+		first_line[k] = line;
+		first_entry[k] = entries;
+		line += info[k].lines;
+		entries += info[k].records;
+	}
+	if (entries != h.entries)
+	{
+		throw text_error(where, path, line, "expected " + std::to_string(h.entries) + " entries, found " + std::to_string(entries));
+	}
+	return cuts;
+}
+
+// It reads the entries of the coordinate file h into a sparse matrix.
+template <class T>
+CooMat<T> mtx_read_coordinate(const text_file& file, const mtx_header& h, const std::string& path, const char* where)
+{
+	std::vector<size_t> first_line, first_entry;
+	const std::vector<const char*> cuts = mtx_split(file, h, first_line, first_entry, path, where);
+
+	CooMat<T> a(h.rows, h.cols);
+	a.row.resize(h.entries);
+	a.col.resize(h.entries);
+	a.value.resize(h.entries);
+	parallel_for(0, cuts.size() - 1, 1, [&](size_t lo, size_t hi)
+	{
+		for (size_t c = lo; c < hi; c++)
+		{
+			const char* p = cuts[c];
+			size_t line = first_line[c], k = first_entry[c];
+			for (; p < cuts[c + 1]; line++)
+			{
+				const char* e = text_line_end(p, cuts[c + 1]);
+				const char* b = p;
+				p = e < cuts[c + 1] ? e + 1 : cuts[c + 1];
+				text_trim(b, e);
+				if (b == e || *b == '%')
+				{
+					continue;
+				}
+				text_fields fields(b, e, ' ');
+				const char *i0, *i1, *j0, *j1, *x0, *x1;
+				size_t i = 0, j = 0;
+				if (!fields.next(i0, i1) || !fields.next(j0, j1) || !text_parse(i0, i1, i)
+						|| !text_parse(j0, j1, j) || !mtx_parse_value(fields, h.field, a.value[k]) || fields.next(x0, x1))
+				{
+					throw text_error(where, path, line, "invalid entry");
+				}
+				if (i == 0 || i > h.rows || j == 0 || j > h.cols || (h.symmetry != MTX_GENERAL && j > i))
+				{
+					throw text_error(where, path, line, "entry out of range");
+				}
+				a.row[k] = i - 1;
+				a.col[k] = j - 1;
+				k++;
+			}
+		}
+	});
+
+	if (h.symmetry != MTX_GENERAL)
+	{
+		size_t k, n = h.entries;
+		for (k = 0; k < n; k++)
+		{
+			if (a.row[k] != a.col[k])
+			{
+				a.row.push_back(a.col[k]);
+				a.col.push_back(a.row[k]);
+				a.value.push_back(mtx_mirror(h.symmetry, a.value[k]));
+			}
+		}
+	}
+	return a;
+}
+
+// It reads the coordinate Matrix Market file path into a sparse matrix.
+template <class T>
+CooMat<T> read_mtx_coordinate(const std::string& path)
+{
+	const char* where = "read_mtx_coordinate(const std::string& path)";
+	text_file file(path, where);
+	const mtx_header h = mtx_read_header<T>(file, path, where);
+	if (!h.coordinate)
+	{
+		throw text_error(where, path, 1, "not a coordinate file");
+	}
+	return mtx_read_coordinate<T>(file, h, path, where);
+}
+
+// It reads the Matrix Market file path, array or coordinate, into a
+// dense matrix.
+template <class T>
+Mat<T> read_mtx(const std::string& path)
+{
+	const char* where = "read_mtx(const std::string& path)";
+	text_file file(path, where);
+	const mtx_header h = mtx_read_header<T>(file, path, where);
+	if (h.coordinate)
+	{
+		return mtx_read_coordinate<T>(file, h, path, where).to_mat();
+	}
+	std::vector<size_t> first_line, first_entry;
+	const std::vector<const char*> cuts = mtx_split(file, h, first_line, first_entry, path, where);
+
+	// The entries run down the columns, from the diagonal (or the entry
+	// below it) of a symmetric matrix.
+	const size_t n = h.rows, cols = h.cols;
+	const size_t skip = h.symmetry == MTX_SKEW_SYMMETRIC ? 1 : 0;
+	const bool lower = h.symmetry != MTX_GENERAL;
+	Mat<T> m(n, cols);
+	if (m.size() == 0)
+	{
+		return m;
+	}
+	T* data = m.data();
+	parallel_for(0, cuts.size() - 1, 1, [&](size_t lo, size_t hi)
+	{
+		for (size_t c = lo; c < hi; c++)
+		{
+			// The position of the first entry of the chunk.
+			size_t k = first_entry[c], i = 0, j = 0;
+			if (k == h.entries)
+			{
+				continue;
+			}
+			if (!lower)
+			{
+				i = k % n;
+				j = k/n;
+			}
+			else
+			{
+				for (j = 0; k >= n - j - skip; j++)
+				{
+					k -= n - j - skip;
+				}
+				i = j + skip + k;
+			}
+			const char* p = cuts[c];
+			size_t line = first_line[c];
+			for (; p < cuts[c + 1]; line++)
+			{
+				const char* e = text_line_end(p, cuts[c + 1]);
+				const char* b = p;
+				p = e < cuts[c + 1] ? e + 1 : cuts[c + 1];
+				text_trim(b, e);
+				if (b == e || *b == '%')
+				{
+					continue;
+				}
+				text_fields fields(b, e, ' ');
+				const char *x0, *x1;
+				T v;
+				if (!mtx_parse_value(fields, h.field, v) || fields.next(x0, x1))
+				{
+					throw text_error(where, path, line, "invalid entry");
+				}
+				data[i*cols + j] = v;
+				if (lower && i != j)
+				{
+					data[j*cols + i] = mtx_mirror(h.symmetry, v);
+				}
+				if (++i == n)
+				{
+					j++;
+					i = lower ? j + skip : 0;
+				}
+			}
+		}
+	});
+	return m;
+}
+
+// It writes the matrix m to the Matrix Market file path in array format.
+template <class T>
+void write_mtx(const std::string& path, const Mat<T>& m)
+{
+	text_writer out(path, "write_mtx(const std::string& path, const mat& m)");
+	const size_t rows = m.rows(), cols = m.cols();
+	const T* data = m.data();
+	out.write(std::string("%%MatrixMarket matrix array ") + mtx_type<T>::name() + " general\n"
+			+ std::to_string(rows) + " " + std::to_string(cols) + "\n");
+	// The entries run down the columns.
+	out.write_blocks(cols, text_block(rows), [=](size_t j0, size_t j1, std::string& s)
+	{
+		size_t i, j;
+		for (j = j0; j < j1; j++)
+		{
+			for (i = 0; i < rows; i++)
+			{
+				text_format(s, data[i*cols + j]);
+				s += '\n';
+			}
+		}
+	});
+	out.close();
+}
+
+// It writes the sparse matrix a to the Matrix Market file path in
+// coordinate format.
+template <class T>
+void write_mtx(const std::string& path, const CooMat<T>& a)
+{
+	text_writer out(path, "write_mtx(const std::string& path, const coo_mat& a)");
+	out.write(std::string("%%MatrixMarket matrix coordinate ") + mtx_type<T>::name() + " general\n"
+			+ std::to_string(a.rows) + " " + std::to_string(a.cols) + " " + std::to_string(a.nnz()) + "\n");
+	out.write_blocks(a.nnz(), TEXT_WRITE_BLOCK, [&a](size_t k0, size_t k1, std::string& s)
+	{
+		size_t k;
+		for (k = k0; k < k1; k++)
+		{
+			text_format(s, a.row[k] + 1);
+			s += ' ';
+			text_format(s, a.col[k] + 1);
+			s += ' ';
+			text_format(s, a.value[k]);
+			s += '\n';
+		}
+	});
+	out.close();
+}
+
+} /* namespace algebra */
+
+#endif /* TEXT_IO_H_ */
@@ -0,0 +1,287 @@
+/*============================================================================
+ * Name         : aligned_allocator.h implements an STL-compatible allocator
+ *                returning memory aligned to a cache line, so that the
+ *                contiguous buffers of Vec and Mat can be streamed by
+ *                vectorized kernels without split loads. The memory comes
+ *                from a pluggable memory_resource: the heap by default, or
+ *                transparent huge pages, or any resource of the user; it
+ *                is counted against a configurable memory budget.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+#ifndef ALIGNED_ALLOCATOR_H_
+#define ALIGNED_ALLOCATOR_H_
+
+#include <stdlib.h>     // posix_memalign, free
+#include <stddef.h>     // size_t
+#include <new>          // std::bad_alloc
+#include <limits>       // numeric limits
+#include <atomic>
+#include <type_traits>  // std::true_type
+#include <unistd.h>     // sysconf
+#ifdef __linux__
+#include <sys/mman.h>   // madvise
+#endif
+
+// Alignment (in Bytes) of every buffer allocated by the library.
+// 64 Bytes is a cache line on x86 and ARM and covers AVX-512 loads.
+#define MEMORY_ALIGNMENT 64
+// Size (in Bytes) of a transparent huge page on x86-64 and ARM64.
+#define HUGE_PAGE_SIZE (2*1024*1024)
+
+namespace algebra {
+
+// A source of raw memory. Every container remembers the resource its
+// buffer came from and returns it there, so a resource has to outlive
+// the containers allocated from it.
+class memory_resource {
+public:
+	virtual ~memory_resource() {}
+	virtual void* allocate(size_t bytes, size_t alignment) = 0;
+	virtual void deallocate(void* p, size_t bytes, size_t alignment) noexcept = 0;
+};
+
+// posix_memalign() and free().
+class heap_resource : public memory_resource {
+public:
+	void* allocate(size_t bytes, size_t alignment) override
+	{
+		void* p = nullptr;
+		if (posix_memalign(&p, alignment, bytes) != 0)
+		{
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+
+	void deallocate(void* p, size_t, size_t) noexcept override { free(p); }
+};
+
+// Buffers of HUGE_PAGE_SIZE and more are aligned to a huge page and
+// marked for transparent huge pages, which cuts the TLB misses of large
+// matrices; smaller ones come from the heap.
+class huge_page_resource : public memory_resource {
+public:
+	void* allocate(size_t bytes, size_t alignment) override
+	{
+		if (bytes < HUGE_PAGE_SIZE)
+		{
+			return heap_.allocate(bytes, alignment);
+		}
+		bytes = (bytes + HUGE_PAGE_SIZE - 1)/HUGE_PAGE_SIZE*HUGE_PAGE_SIZE;
+		void* p = heap_.allocate(bytes, HUGE_PAGE_SIZE);
+#ifdef MADV_HUGEPAGE
+		madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+		return p;
+	}
+
+	void deallocate(void* p, size_t bytes, size_t alignment) noexcept override
+	{
+		heap_.deallocate(p, bytes, alignment);
+	}
+
+private:
+	heap_resource heap_;
+};
+
+inline heap_resource* heap_memory_resource()
+{
+	static heap_resource heap;
+	return &heap;
+}
+
+inline huge_page_resource* huge_page_memory_resource()
+{
+	static huge_page_resource huge;
+	return &huge;
+}
+
+inline std::atomic<memory_resource*>& default_resource_slot()
+{
+	static std::atomic<memory_resource*> slot(heap_memory_resource());
+	return slot;
+}
+
+// The resource used by the containers constructed from now on.
+inline memory_resource* get_default_resource() noexcept { return default_resource_slot().load(); }
+
+// It makes r the default resource (the heap when r is NULL) and returns
+// the previous one. Existing containers keep their resource.
+inline memory_resource* set_default_resource(memory_resource* r) noexcept
+{
+	return default_resource_slot().exchange(r ? r : heap_memory_resource());
+}
+
+// ##################################################################################################
+// ########################################## MEMORY BUDGET #########################################
+// The buffers of Vec and Mat are counted against a budget, the physical
+// memory of the machine unless set_memory_budget() says otherwise. An
+// allocation beyond it fails with memory_budget_error instead of pushing
+// the machine into swap or the OOM killer.
+
+class memory_budget_error : public std::bad_alloc {
+public:
+	const char* what() const noexcept override { return "memory budget exceeded"; }
+};
+
+// It returns the physical memory of the machine in Bytes.
+inline size_t physical_memory() noexcept
+{
+	const long pages = sysconf(_SC_PHYS_PAGES), page_size = sysconf(_SC_PAGE_SIZE);
+	if (pages <= 0 || page_size <= 0)
+	{
+		return std::numeric_limits<size_t>::max();
+	}
+	return (size_t) pages*(size_t) page_size;
+}
+
+inline std::atomic<size_t>& memory_budget_slot()
+{
+	static std::atomic<size_t> budget(physical_memory());
+	return budget;
+}
+
+inline std::atomic<size_t>& memory_in_use_slot()
+{
+	static std::atomic<size_t> in_use(0);
+	return in_use;
+}
+
+inline size_t get_memory_budget() noexcept { return memory_budget_slot().load(std::memory_order_relaxed); }
+
+// It sets the budget to bytes Bytes; 0 restores the physical memory.
+inline void set_memory_budget(size_t bytes) noexcept
+{
+	memory_budget_slot().store(bytes ? bytes : physical_memory(), std::memory_order_relaxed);
+}
+
+// The Bytes held by the buffers of Vec and Mat.
+inline size_t memory_in_use() noexcept { return memory_in_use_slot().load(std::memory_order_relaxed); }
+
+// The Bytes that can still be allocated.
+inline size_t memory_available() noexcept
+{
+	const size_t budget = get_memory_budget(), in_use = memory_in_use();
+	return in_use < budget ? budget - in_use : 0;
+}
+
+// It charges bytes Bytes to the budget; false if they do not fit.
+inline bool memory_reserve(size_t bytes) noexcept
+{
+	std::atomic<size_t>& in_use = memory_in_use_slot();
+	const size_t before = in_use.fetch_add(bytes, std::memory_order_relaxed);
+	if (before + bytes < before || before + bytes > get_memory_budget())
+	{
+		in_use.fetch_sub(bytes, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+inline void memory_release(size_t bytes) noexcept
+{
+	memory_in_use_slot().fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+template <class T>
+class aligned_allocator {
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+	// A buffer travels with the resource that owns it when a container
+	// is moved or swapped.
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	template <class U>
+	struct rebind { typedef aligned_allocator<U> other; };
+
+	aligned_allocator() noexcept : resource_(get_default_resource()) {}
+	explicit aligned_allocator(memory_resource* r) noexcept : resource_(r) {}
+	template <class U>
+	aligned_allocator(const aligned_allocator<U>& a) noexcept : resource_(a.resource()) {}
+
+	T* allocate(size_t n)
+	{
+		if (n == 0)
+		{
+			return nullptr;
+		}
+		if (n > std::numeric_limits<size_t>::max()/sizeof(T))
+		{
+			throw std::bad_alloc();
+		}
+		if (!memory_reserve(n*sizeof(T)))
+		{
+			throw memory_budget_error();
+		}
+		try
+		{
+			return static_cast<T*>(resource_->allocate(n*sizeof(T), MEMORY_ALIGNMENT));
+		}
+		catch (...)
+		{
+			memory_release(n*sizeof(T));
+			throw;
+		}
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		if (p)
+		{
+			resource_->deallocate(p, n*sizeof(T), MEMORY_ALIGNMENT);
+			memory_release(n*sizeof(T));
+		}
+	}
+
+	size_t max_size() const noexcept { return std::numeric_limits<size_t>::max()/sizeof(T); }
+
+	memory_resource* resource() const noexcept { return resource_; }
+
+private:
+	memory_resource* resource_;
+};
+
+template <class T, class U>
+inline bool operator==(const aligned_allocator<T>& a, const aligned_allocator<U>& b) noexcept
+{
+	return a.resource() == b.resource();
+}
+
+template <class T, class U>
+inline bool operator!=(const aligned_allocator<T>& a, const aligned_allocator<U>& b) noexcept
+{
+	return !(a == b);
+}
+
+} /* namespace algebra */
+
+#endif /* ALIGNED_ALLOCATOR_H_ */
@@ -1,6 +1,9 @@
 /*============================================================================
  * Name         : mylog.h is a logger for storing exceptions
- *                thrown from myLinearAlgebra library.
+ *                thrown from myLinearAlgebra library. The messages are
+ *                queued in a lock-free ring buffer and written by a
+ *                background thread to files that stay open, so that
+ *                logging costs a copy and never blocks on I/O.
  * Version      : 1.0.0, 11 Sep 2017
  *
  * Copyright (c) 2017 Ioannis Karagiannis
@@ -25,16 +28,40 @@
  * 				ioanniskaragiannis1987@gmail.com
 ================================================================================*/
 
+/* There are three severities, each with its own file:
+ *
+ *     log(msg)        LOG_LEVEL_INFO      LOG_FILE
+ *     warning(msg)    LOG_LEVEL_WARNING   WARNING_FILE
+ *     log_error(msg)  LOG_LEVEL_ERROR     LOG_ERROR_FILE
+ *
+ * The messages below LOG_MIN_LEVEL are removed at compile time, e.g.
+ * -DLOG_MIN_LEVEL=LOG_LEVEL_ERROR keeps the errors only, and those below
+ * set_log_level() are dropped at run time. The macros LOG_INFO, LOG_WARNING
+ * and LOG_ERROR build their message only when it is going to be written.
+ * At most LOG_RATE_LIMIT messages per second are kept for each severity;
+ * the number of the dropped ones is written once the rate falls.
+ *
+ * log_flush() waits until every message queued so far is in its file.
+ */
+
 #ifndef MYLOG_H_
 #define MYLOG_H_
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <stdexcept>    // for exception, runtime_error, out_of_range
+#include <string>
+#include <iostream>     // std::cerr
 #include <time.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 // This logger will only work for Linux OS
 // If you're working on Windows you should
@@ -47,6 +74,28 @@
 #define WARNING_FILE "/tmp/LinearAlgebra/warning.txt"
 #endif
 
+#define LOG_LEVEL_INFO 0
+#define LOG_LEVEL_WARNING 1
+#define LOG_LEVEL_ERROR 2
+#define LOG_LEVEL_NONE 3
+
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Messages kept per severity and per second.
+#ifndef LOG_RATE_LIMIT
+#define LOG_RATE_LIMIT 100
+#endif
+
+// Slots of the ring buffer (a power of 2) and their size in Bytes;
+// longer messages are truncated.
+#define LOG_RING_SIZE 1024
+#define LOG_MESSAGE_SIZE 480
+
+// How often (in milliseconds) the background thread wakes up on its own.
+#define LOG_DRAIN_PERIOD 20
+
 
 inline void create_directory(const std::string& folder_name)
 {
@@ -70,107 +119,326 @@ inline bool file_exists (const std::string& name)
 	}
 }
 
-inline void clear_file(const std::string& file)
-{
-	if (file_exists(file.c_str()) )
-	{
-		if ( remove( file.c_str() ) != 0 )
-		{
-			std::cerr << "Error deleting error-log file file" << std::endl;
-		}
-	}
-}
-
 // Get current date/time, format is YYYY-MM-DD.HH:mm:ss
 inline const std::string my_currentDateTime()
 {
 	time_t     now = time(0);
 	struct tm  tstruct;
 	char       buf[80];
-	tstruct = *localtime(&now);
+	localtime_r(&now, &tstruct);
 	strftime(buf, sizeof(buf), "%Y-%m-%d.%X", &tstruct);
 	return buf;
 }
 
-inline void log_error(const char* message)
-{
-
-	// Create directory if it doesn't exist.
-	static uint16_t c = 0;
-	if ( c == 0 )
+// The queue of messages and the thread writing them. Producers claim a
+// slot of the ring with a compare-and-swap and publish it through its
+// sequence number (a bounded multi-producer queue); when the ring is full
+// the message is dropped rather than waited for.
+class log_backend {
+public:
+	static log_backend& instance()
 	{
-		create_directory(LOG_FOLDER);
-		c++;
+		static log_backend backend;
+		return backend;
 	}
 
-	// Concatenate time with error message
-	std::string complete_message = std::string("[") + my_currentDateTime() + std::string("]") + std::string(message) + std::string("\n");
-	message = complete_message.c_str();
+	// It queues message; false if the ring is full.
+	bool push(int level, const char* message) noexcept;
+	// It waits until every message queued before the call is written.
+	void flush();
+	// It closes the files; the next message opens them again.
+	void close_files();
+
+	int level() const noexcept { return level_.load(std::memory_order_relaxed); }
+	void set_level(int level) noexcept { level_.store(level, std::memory_order_relaxed); }
+
+	// It counts a message of the given severity against the rate limit.
+	bool admit(int level) noexcept;
+
+private:
+	struct record {
+		std::atomic<size_t> sequence;
+		int level;
+		time_t time;
+		char text[LOG_MESSAGE_SIZE];
+	};
+
+	log_backend();
+	~log_backend();
+	log_backend(const log_backend&) = delete;
+	log_backend& operator=(const log_backend&) = delete;
+
+	void run();
+	size_t drain();
+	void write(int level, time_t t, const char* text);
+
+	record ring_[LOG_RING_SIZE];
+	std::atomic<size_t> enqueue_;
+	size_t dequeue_;                     // read by the background thread only
 
-	FILE * pFile;
-	pFile = fopen(LOG_ERROR_FILE, "a+");
-	if ( pFile != NULL )
+	std::atomic<int> level_;
+	std::atomic<int64_t> window_[3];     // second of the rate-limit window
+	std::atomic<uint32_t> count_[3];     // messages admitted in the window
+	std::atomic<uint64_t> dropped_[3];   // messages dropped since last reported
+
+	FILE* files_[3];
+	time_t stamp_time_;
+	char stamp_[32];
+
+	std::mutex mutex_;                   // held while writing the files
+	std::condition_variable wake_, done_;
+	std::atomic<bool> stop_;
+	std::atomic<size_t> written_;
+	std::thread thread_;
+};
+
+inline log_backend::log_backend() : enqueue_(0), dequeue_(0), level_(LOG_MIN_LEVEL),
+		stamp_time_(0), stop_(false), written_(0)
+{
+	size_t i;
+	for (i = 0; i < LOG_RING_SIZE; i++)
 	{
-		fputs (message, pFile);
-		fclose (pFile);
+		ring_[i].sequence.store(i, std::memory_order_relaxed);
 	}
-	else
+	for (i = 0; i < 3; i++)
 	{
-		std::cerr << "Failed to open error file." << std::endl;
+		window_[i].store(-1);
+		count_[i].store(0);
+		dropped_[i].store(0);
+		files_[i] = NULL;
 	}
+	stamp_[0] = '\0';
+	create_directory(LOG_FOLDER);
+	thread_ = std::thread([this]() { run(); });
 }
 
-inline void log(const char* message)
+inline log_backend::~log_backend()
 {
-	// Create directory if it doesn't exist.
-	static uint16_t c = 0;
-	if(c == 0){
-		create_directory(LOG_FOLDER);
-		c++;
+	stop_.store(true);
+	wake_.notify_one();
+	if (thread_.joinable())
+	{
+		thread_.join();
 	}
+	close_files();
+}
 
-	// Concatenate time with error message
-	std::string complete_message = std::string("[") + my_currentDateTime() + std::string("]") + std::string(message) + std::string("\n");
-	message = complete_message.c_str();
+inline bool log_backend::admit(int level) noexcept
+{
+	if (level < level_.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+	const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	int64_t window = window_[level].load(std::memory_order_relaxed);
+	if (window != now && window_[level].compare_exchange_strong(window, now))
+	{
+		count_[level].store(0, std::memory_order_relaxed);
+	}
+	if (count_[level].fetch_add(1, std::memory_order_relaxed) < LOG_RATE_LIMIT)
+	{
+		return true;
+	}
+	dropped_[level].fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
 
-	FILE * pFile;
-	pFile = fopen(LOG_FILE, "a+");
-	if ( pFile != NULL )
+inline bool log_backend::push(int level, const char* message) noexcept
+{
+	size_t pos = enqueue_.load(std::memory_order_relaxed);
+	record* r;
+	for (;;)
 	{
-		fputs (message, pFile);
-		fclose (pFile);
+		r = &ring_[pos & (LOG_RING_SIZE - 1)];
+		const size_t seq = r->sequence.load(std::memory_order_acquire);
+		const intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+		if (diff == 0)
+		{
+			if (enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			dropped_[level].fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			pos = enqueue_.load(std::memory_order_relaxed);
+		}
 	}
-	else
+	r->level = level;
+	r->time = time(0);
+	const size_t length = strnlen(message, LOG_MESSAGE_SIZE - 1);
+	memcpy(r->text, message, length);
+	r->text[length] = '\0';
+	r->sequence.store(pos + 1, std::memory_order_release);
+	if (pos - written_.load(std::memory_order_relaxed) >= LOG_RING_SIZE/2)
 	{
-		std::cerr << "Failed to open log file." << std::endl;
+		wake_.notify_one();
 	}
+	return true;
 }
 
-inline void warning(const char* message)
+inline void log_backend::flush()
+{
+	const size_t target = enqueue_.load();
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (written_.load() < target && !stop_.load())
+	{
+		wake_.notify_one();
+		done_.wait_for(lock, std::chrono::milliseconds(LOG_DRAIN_PERIOD));
+	}
+}
+
+inline void log_backend::close_files()
 {
-	// Create directory if it doesn't exist.
-	static uint16_t c = 0;
-	if ( c == 0 )
+	std::lock_guard<std::mutex> lock(mutex_);
+	int i;
+	for (i = 0; i < 3; i++)
 	{
-		create_directory(LOG_FOLDER);
-		c++;
+		if (files_[i] != NULL)
+		{
+			fclose(files_[i]);
+			files_[i] = NULL;
+		}
 	}
+}
 
-	// Concatenate time with error message
-	std::string complete_message = std::string("[") + my_currentDateTime() + std::string("]") + std::string(message) + std::string("\n");
-	message = complete_message.c_str();
+inline void log_backend::run()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;)
+	{
+		const bool stopping = stop_.load();
+		drain();
+		done_.notify_all();
+		if (stopping)
+		{
+			break;
+		}
+		wake_.wait_for(lock, std::chrono::milliseconds(LOG_DRAIN_PERIOD));
+	}
+}
 
-	FILE * pFile;
-	pFile = fopen(WARNING_FILE, "a+");
-	if ( pFile != NULL )
+// It writes the published messages and the counts of the dropped ones,
+// then flushes the files. It runs on the background thread with mutex_.
+inline size_t log_backend::drain()
+{
+	size_t n = 0;
+	for (;;)
 	{
-		fputs (message, pFile);
-		fclose (pFile);
+		record& r = ring_[dequeue_ & (LOG_RING_SIZE - 1)];
+		if (r.sequence.load(std::memory_order_acquire) != dequeue_ + 1)
+		{
+			break;
+		}
+		write(r.level, r.time, r.text);
+		r.sequence.store(dequeue_ + LOG_RING_SIZE, std::memory_order_release);
+		dequeue_++;
+		n++;
 	}
-	else
+	int level;
+	for (level = 0; level < 3; level++)
 	{
-		std::cerr << "Failed to open warning file." << std::endl;
+		const uint64_t dropped = dropped_[level].exchange(0, std::memory_order_relaxed);
+		if (dropped > 0)
+		{
+			const std::string msg = " " + std::to_string(dropped) + " messages dropped (rate limit or full buffer).";
+			write(level, time(0), msg.c_str());
+		}
+		if (files_[level] != NULL)
+		{
+			fflush(files_[level]);
+		}
 	}
+	written_.store(dequeue_);
+	return n;
+}
+
+inline void log_backend::write(int level, time_t t, const char* text)
+{
+	static const char* const names[3] = { LOG_FILE, WARNING_FILE, LOG_ERROR_FILE };
+	if (files_[level] == NULL)
+	{
+		files_[level] = fopen(names[level], "a");
+		if (files_[level] == NULL)
+		{
+			create_directory(LOG_FOLDER);
+			files_[level] = fopen(names[level], "a");
+		}
+		if (files_[level] == NULL)
+		{
+			std::cerr << "Failed to open " << names[level] << std::endl;
+			return;
+		}
+	}
+	if (t != stamp_time_ || stamp_[0] == '\0')
+	{
+		struct tm tstruct;
+		localtime_r(&t, &tstruct);
+		strftime(stamp_, sizeof(stamp_), "[%Y-%m-%d.%X]", &tstruct);
+		stamp_time_ = t;
+	}
+	fputs(stamp_, files_[level]);
+	fputs(text, files_[level]);
+	fputc('\n', files_[level]);
+}
+
+// It sets the lowest severity written at run time.
+inline void set_log_level(int level) { log_backend::instance().set_level(level); }
+
+inline int get_log_level() { return log_backend::instance().level(); }
+
+// It is true if a message of the given severity would be written; it is
+// a compile-time false below LOG_MIN_LEVEL.
+inline bool log_admit(int level)
+{
+	return level >= LOG_MIN_LEVEL && log_backend::instance().admit(level);
+}
+
+inline void log_write(int level, const char* message) { log_backend::instance().push(level, message); }
+inline void log_write(int level, const std::string& message) { log_write(level, message.c_str()); }
+
+inline void log_flush() { log_backend::instance().flush(); }
+
+#define LOG_MESSAGE(level, message) \
+	do { if (log_admit(level)) { log_write(level, message); } } while (0)
+#define LOG_INFO(message) LOG_MESSAGE(LOG_LEVEL_INFO, message)
+#define LOG_WARNING(message) LOG_MESSAGE(LOG_LEVEL_WARNING, message)
+#define LOG_ERROR(message) LOG_MESSAGE(LOG_LEVEL_ERROR, message)
+
+inline void clear_file(const std::string& file)
+{
+	// The backend keeps the files open; write what is queued and close
+	// them so that the next message creates the file again.
+	log_flush();
+	log_backend::instance().close_files();
+	if (file_exists(file.c_str()) )
+	{
+		if ( remove( file.c_str() ) != 0 )
+		{
+			std::cerr << "Error deleting error-log file file" << std::endl;
+		}
+	}
+}
+
+inline void log_error(const char* message)
+{
+	LOG_ERROR(message);
+}
+
+inline void log(const char* message)
+{
+	LOG_INFO(message);
+}
+
+inline void warning(const char* message)
+{
+	LOG_WARNING(message);
 }
 
 
@@ -0,0 +1,192 @@
+/*============================================================================
+ * Name         : parser.h implements literal_parser, the linear-time parser
+ *                behind the string assignments of Vec and Mat, e.g.
+ *                v = "[1 2 3]" and m = "[1 2;3 4]".
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* A literal is a list of numbers separated by blanks or commas, in rows
+ * separated by semicolons, optionally in brackets:
+ *
+ *     "[1 2 3]"   "1, -2.5, 3e-4"   "[1 2;3 4]"   "[]"
+ *
+ * The parser walks the text twice, never copying it: the constructor
+ * checks the characters and counts the rows and columns, so that the
+ * container is allocated once at its final size, and parse() converts
+ * the numbers straight into it. An error names its position in the text.
+ */
+
+#ifndef PARSER_H_
+#define PARSER_H_
+
+#include <stddef.h>     // size_t
+#include <stdlib.h>     // strtod
+#include <string.h>     // strlen
+#include <string>
+#include <stdexcept>
+
+#include "mylog.h"
+
+namespace algebra {
+
+class literal_parser {
+public:
+	// It checks text and counts its rows and columns; semicolons are only
+	// accepted when allow_rows is set. function names the caller in the
+	// error messages.
+	literal_parser(const char* text, bool allow_rows, const char* function);
+
+	size_t rows() const noexcept { return rows_; }
+	size_t cols() const noexcept { return cols_; }
+	size_t size() const noexcept { return rows_*cols_; }
+
+	// It writes the size() numbers, row by row, to out.
+	template <class T>
+	void parse(T* out) const;
+
+private:
+	static bool is_blank(char c) noexcept
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',';
+	}
+	static bool is_number(char c) noexcept
+	{
+		return (c >= '0' && c <= '9') || c == '.' || c == '+' || c == '-' || c == 'e' || c == 'E';
+	}
+
+	template <class E>
+	E error(size_t pos, const std::string& what) const;
+
+	const char* text_;
+	size_t begin_;      // the numbers lie in text_[begin_, end_)
+	size_t end_;
+	size_t rows_;
+	size_t cols_;
+	const char* function_;
+};
+
+template <class E>
+E literal_parser::error(size_t pos, const std::string& what) const
+{
+	std::string msg = FILE_LINE_ERROR + " exception in " + function_ + ": " + what + " at position " + std::to_string(pos);
+	log_error(msg.c_str());
+	return E(msg);
+}
+
+inline literal_parser::literal_parser(const char* text, bool allow_rows, const char* function) :
+	text_(text), begin_(0), end_(strlen(text)), rows_(0), cols_(0), function_(function)
+{
+	while (begin_ < end_ && is_blank(text_[begin_]))
+	{
+		begin_++;
+	}
+	while (end_ > begin_ && is_blank(text_[end_ - 1]))
+	{
+		end_--;
+	}
+	if (begin_ < end_ && text_[begin_] == '[')
+	{
+		if (end_ - begin_ < 2 || text_[end_ - 1] != ']')
+		{
+			throw error<std::invalid_argument>(end_, "expected ']'");
+		}
+		begin_++;
+		end_--;
+	}
+
+	size_t i = begin_, rows = 0, count = 0;
+	for (;;)
+	{
+		if (i == end_ || text_[i] == ';')
+		{
+			// A row ends; all of them must be as long as the first.
+			if (rows == 0)
+			{
+				cols_ = count;
+			}
+			else if (count != cols_)
+			{
+				throw error<std::out_of_range>(i, "rows must be of same length, row " + std::to_string(rows + 1)
+						+ " has " + std::to_string(count) + " elements instead of " + std::to_string(cols_));
+			}
+			rows++;
+			count = 0;
+			if (i == end_)
+			{
+				break;
+			}
+			if (!allow_rows)
+			{
+				throw error<std::invalid_argument>(i, "unexpected ';' in a vector");
+			}
+			i++;
+		}
+		else if (is_blank(text_[i]))
+		{
+			i++;
+		}
+		else if (is_number(text_[i]))
+		{
+			while (i < end_ && is_number(text_[i]))
+			{
+				i++;
+			}
+			count++;
+		}
+		else
+		{
+			throw error<std::invalid_argument>(i, std::string("unexpected character '") + text_[i] + "'");
+		}
+	}
+	// Rows without numbers ("", "[]", "[;]") make an empty container.
+	rows_ = cols_ ? rows : 0;
+}
+
+template <class T>
+void literal_parser::parse(T* out) const
+{
+	size_t i = begin_, j;
+	while (i < end_)
+	{
+		if (!is_number(text_[i]))
+		{
+			i++;
+			continue;
+		}
+		for (j = i; j < end_ && is_number(text_[j]); j++) {}
+		// The token is followed by a separator, where strtod() stops too.
+		char* stop;
+		double value = strtod(text_ + i, &stop);
+		if (stop != text_ + j)
+		{
+			throw error<std::invalid_argument>(i, "invalid number '" + std::string(text_ + i, j - i) + "'");
+		}
+		*out++ = (T) value;
+		i = j;
+	}
+}
+
+} /* namespace algebra */
+
+#endif /* PARSER_H_ */
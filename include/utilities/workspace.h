@@ -0,0 +1,320 @@
+/*============================================================================
+ * Name         : workspace.h implements the scratch memory of the kernels:
+ *                every thread owns a bump-allocated arena from which the
+ *                packing buffers, panels and temporaries of a computation
+ *                are taken and returned in LIFO order, so that repeated
+ *                products and factorizations stop calling malloc/free.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* A kernel declares its scratch buffers as
+ *
+ *     std::vector<T, workspace_allocator<T> > buffer(n);
+ *
+ * which takes them from thread_workspace(), the arena of the calling
+ * thread. The arena grows until it holds the largest working set of the
+ * thread and is reused from then on. A caller who knows the size of a
+ * computation can reserve it up front and give the memory back at the end:
+ *
+ *     {
+ *         workspace_scope scope(64 << 20);  // 64 MiB on this thread
+ *         x = solve(a, b);
+ *     }                                     // released here
+ *
+ * The worker threads of the pool own their own arenas.
+ */
+
+#ifndef WORKSPACE_H_
+#define WORKSPACE_H_
+
+#include <stddef.h>     // size_t
+#include <vector>
+#include <algorithm>    // std::max
+#include <new>          // std::bad_alloc
+#include <limits>       // numeric limits
+
+#include "aligned_allocator.h"
+
+// Smallest region (in Bytes) a workspace asks its resource for.
+#define WORKSPACE_MIN_CHUNK (256*1024)
+
+namespace algebra {
+
+// A bump allocator over a list of regions. Buffers are released in any
+// order, but their space is only reused once every buffer allocated after
+// them has been released too, which is the case for the nested temporaries
+// of the kernels. It is not thread-safe: every thread uses its own.
+class workspace {
+public:
+	explicit workspace(memory_resource* r = nullptr) :
+		resource_(r ? r : get_default_resource()), current_(0), used_(0), in_use_(0), scopes_(0) {}
+	workspace(const workspace&) = delete;
+	workspace& operator=(const workspace&) = delete;
+	~workspace() { release(); }
+
+	void* allocate(size_t bytes);
+	void deallocate(void* p) noexcept;
+
+	// It makes sure that the next bytes Bytes are taken from one region.
+	void reserve(size_t bytes);
+	// It returns the regions to the resource when no buffer is in use.
+	void trim() noexcept;
+
+	size_t capacity() const noexcept;
+	size_t in_use() const noexcept { return in_use_; }
+	size_t regions() const noexcept { return chunks_.size(); }
+
+private:
+	struct chunk { char* data; size_t size; };
+	struct block { void* p; size_t bytes, chunk, used; bool released; };
+
+	void add_chunk(size_t bytes);
+	void release() noexcept;
+
+	memory_resource* resource_;
+	std::vector<chunk> chunks_;
+	std::vector<block> live_;
+	size_t current_;    // region the next buffer is cut from
+	size_t used_;       // Bytes used in that region
+	size_t in_use_;     // Bytes handed out and not yet released
+	int scopes_;
+
+	friend class workspace_scope;
+};
+
+// It returns a buffer of at least bytes Bytes aligned to MEMORY_ALIGNMENT.
+inline void* workspace::allocate(size_t bytes)
+{
+	if (bytes > std::numeric_limits<size_t>::max() - MEMORY_ALIGNMENT)
+	{
+		throw std::bad_alloc();
+	}
+	bytes = (bytes + MEMORY_ALIGNMENT - 1)/MEMORY_ALIGNMENT*MEMORY_ALIGNMENT;
+	if (chunks_.empty() || used_ + bytes > chunks_[current_].size)
+	{
+		// The regions after current_ are empty; use the next one if it
+		// is large enough, otherwise replace them by a larger region.
+		if (!chunks_.empty() && current_ + 1 < chunks_.size() && bytes <= chunks_[current_ + 1].size)
+		{
+			current_++;
+		}
+		else
+		{
+			const size_t grown = std::max(bytes, 2*capacity());
+			if (live_.empty())
+			{
+				release();
+			}
+			add_chunk(grown);
+		}
+		used_ = 0;
+	}
+	block b = { chunks_[current_].data + used_, bytes, current_, used_, false };
+	live_.push_back(b);
+	used_ += bytes;
+	in_use_ += bytes;
+	return b.p;
+}
+
+// It releases the buffer p. The space of the buffers released at the top
+// of the stack is reclaimed at once; once nothing is in use, the regions
+// are merged into one, so that the next computation fits in a single one.
+inline void workspace::deallocate(void* p) noexcept
+{
+	size_t k = live_.size();
+	while (k-- > 0)
+	{
+		if (live_[k].p == p && !live_[k].released)
+		{
+			live_[k].released = true;
+			in_use_ -= live_[k].bytes;
+			break;
+		}
+	}
+	while (!live_.empty() && live_.back().released)
+	{
+		current_ = live_.back().chunk;
+		used_ = live_.back().used;
+		live_.pop_back();
+	}
+	if (live_.empty())
+	{
+		if (chunks_.size() > 1)
+		{
+			const size_t total = capacity();
+			release();
+			try
+			{
+				add_chunk(total);
+			}
+			catch (...) {}
+		}
+		current_ = 0;
+		used_ = 0;
+	}
+}
+
+inline void workspace::reserve(size_t bytes)
+{
+	if (bytes == 0 || (!chunks_.empty() && used_ + bytes <= chunks_[current_].size))
+	{
+		return;
+	}
+	if (live_.empty())
+	{
+		const size_t total = std::max(bytes, capacity());
+		release();
+		add_chunk(total);
+	}
+	else if (current_ + 1 >= chunks_.size() || chunks_[current_ + 1].size < bytes)
+	{
+		add_chunk(bytes);
+		current_--;
+	}
+}
+
+inline void workspace::trim() noexcept
+{
+	if (live_.empty())
+	{
+		release();
+	}
+}
+
+inline size_t workspace::capacity() const noexcept
+{
+	size_t total = 0;
+	for (const chunk& c : chunks_)
+	{
+		total += c.size;
+	}
+	return total;
+}
+
+// It drops the (empty) regions after current_ and appends a new region of
+// bytes Bytes, which becomes the current one.
+inline void workspace::add_chunk(size_t bytes)
+{
+	bytes = std::max(bytes, (size_t) WORKSPACE_MIN_CHUNK);
+	if (!chunks_.empty())
+	{
+		while (chunks_.size() > current_ + 1)
+		{
+			resource_->deallocate(chunks_.back().data, chunks_.back().size, MEMORY_ALIGNMENT);
+			chunks_.pop_back();
+		}
+	}
+	chunk c = { static_cast<char*>(resource_->allocate(bytes, MEMORY_ALIGNMENT)), bytes };
+	chunks_.push_back(c);
+	current_ = chunks_.size() - 1;
+}
+
+inline void workspace::release() noexcept
+{
+	for (const chunk& c : chunks_)
+	{
+		resource_->deallocate(c.data, c.size, MEMORY_ALIGNMENT);
+	}
+	chunks_.clear();
+	current_ = 0;
+	used_ = 0;
+}
+
+// It returns the workspace of the calling thread.
+inline workspace& thread_workspace()
+{
+	static thread_local workspace ws;
+	return ws;
+}
+
+// It reserves bytes Bytes of the workspace of the calling thread for the
+// computation in its scope. The regions are kept together until the
+// outermost scope ends, which gives them back to the resource.
+class workspace_scope {
+public:
+	explicit workspace_scope(size_t bytes = 0) : ws_(thread_workspace())
+	{
+		ws_.reserve(bytes);
+		ws_.scopes_++;
+	}
+	workspace_scope(const workspace_scope&) = delete;
+	workspace_scope& operator=(const workspace_scope&) = delete;
+	~workspace_scope()
+	{
+		if (--ws_.scopes_ == 0)
+		{
+			ws_.trim();
+		}
+	}
+
+private:
+	workspace& ws_;
+};
+
+// STL-compatible allocator drawing from the workspace of the thread that
+// constructed it; meant for the scratch buffers local to a kernel.
+template <class T>
+class workspace_allocator {
+public:
+	typedef T value_type;
+
+	template <class U>
+	struct rebind { typedef workspace_allocator<U> other; };
+
+	workspace_allocator() noexcept : ws_(&thread_workspace()) {}
+	template <class U>
+	workspace_allocator(const workspace_allocator<U>& a) noexcept : ws_(a.get_workspace()) {}
+
+	T* allocate(size_t n)
+	{
+		if (n > std::numeric_limits<size_t>::max()/sizeof(T))
+		{
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(ws_->allocate(n*sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t) noexcept { ws_->deallocate(p); }
+
+	workspace* get_workspace() const noexcept { return ws_; }
+
+private:
+	workspace* ws_;
+};
+
+template <class T, class U>
+inline bool operator==(const workspace_allocator<T>& a, const workspace_allocator<U>& b) noexcept
+{
+	return a.get_workspace() == b.get_workspace();
+}
+
+template <class T, class U>
+inline bool operator!=(const workspace_allocator<T>& a, const workspace_allocator<U>& b) noexcept
+{
+	return !(a == b);
+}
+
+} /* namespace algebra */
+
+#endif /* WORKSPACE_H_ */
@@ -42,8 +42,11 @@
 #include <iostream>     // for cout
 #include <sstream>      // for peek
 #include <algorithm>    // std::min, std::sort()
+#include <utility>      // std::move
 
 #include "utilities/mylog.h"
+#include "utilities/aligned_allocator.h"
+#include "utilities/workspace.h"
 
 #include <typeinfo>
 #include <memory>       // for smart pointer: unique_ptr
@@ -56,9 +59,6 @@
 // At the matrix inversion function we have: size_t P[size + 1];
 #define SIZE_T_MAX std::numeric_limits<size_t>::max()-1
 
-// Don't increase that unless you have lots of RAM available.
-#define MAX_ACCEPTABLE_VECTOR_SIZE 16000
-
 #define MAX(a) ( std::numeric_limits<a>::max() )
 #define NaN(a) ( std::numeric_limits<a>::quiet_NaN() )
 #define Inf(a) ( std::numeric_limits<a>::infinity() )
@@ -70,6 +70,10 @@
 
 using namespace std::complex_literals;
 
+#include "expr.h"
+#include "view.h"
+#include "utilities/parser.h"
+
 namespace algebra {
 
 // Declaration of Vec
@@ -78,23 +82,74 @@ template<class T> class Vec;
 template<class T> class Mat;
 
 template <class T>
-Mat<T> lup_invert(Mat<T>&, const Vec<int>&);
+Mat<T> lup_invert(const Mat<T>&, const Vec<int>&);
+
+// ========= Sizes of new vectors and matrices ===========
+// There is no fixed maximum size: a new Vec or Mat has to fit in what is
+// left of the memory budget (see utilities/aligned_allocator.h), and the
+// number of its Bytes must not overflow size_t.
+
+// It is true if n elements of type T can be allocated.
+template <class T>
+inline bool allocation_fits(size_t n) noexcept
+{
+	return n <= std::numeric_limits<size_t>::max()/sizeof(T) && n*sizeof(T) <= memory_available();
+}
+
+// It is true if an r x c matrix of type T can be allocated.
+template <class T>
+inline bool allocation_fits(size_t r, size_t c) noexcept
+{
+	return (r == 0 || c <= std::numeric_limits<size_t>::max()/r) && allocation_fits<T>(r*c);
+}
+
+// It describes why n elements of type T cannot be allocated.
+template <class T>
+inline std::string allocation_error(size_t n)
+{
+	if (n > std::numeric_limits<size_t>::max()/sizeof(T))
+	{
+		return std::to_string(n) + " elements overflow the size in Bytes";
+	}
+	return std::to_string(n) + " elements (" + std::to_string(n*sizeof(T)) + " Bytes) exceed the " +
+			std::to_string(memory_available()) + " Bytes left of the memory budget (" +
+			std::to_string(get_memory_budget()) + " Bytes), see set_memory_budget()";
+}
+
+template <class T>
+inline std::string allocation_error(size_t r, size_t c)
+{
+	if (r != 0 && c > std::numeric_limits<size_t>::max()/r)
+	{
+		return std::to_string(r) + "x" + std::to_string(c) + " elements overflow size_t";
+	}
+	return allocation_error<T>(r*c);
+}
 
 template <class T>
-class Vec {
+class Vec : public VecExpr< Vec<T> > {
 public:
+	typedef T value_type;
 
 	explicit Vec();
 	Vec(size_t);
+	Vec(const Vec<T>&);
+	Vec(Vec<T>&&) noexcept;
+	template <class E>
+	Vec(const VecExpr<E>&);
 	~Vec();
 
 	size_t size() const noexcept;
 	size_t max_size() const noexcept;
 	size_t size_in_memory() const noexcept; // For debugging purposes
 	size_t capacity() const noexcept;
+	T* data() noexcept;
+	const T* data() const noexcept;
 	void set(size_t, T);
 	T get(size_t) const;
 	Vec<T> get(size_t, size_t) const;
+	VecView<T> view(size_t, size_t);
+	VecView<const T> view(size_t, size_t) const;
 	void set_size(size_t);
 	void set_subvector(size_t, const Vec<T>&);
 	void zeros();
@@ -113,25 +168,36 @@ public:
 
 	void operator=(const char*);
 
-	Vec<T> operator+(const Vec<T>&);
-	Vec<T> operator+(T);
+	Vec<T>& operator=(const Vec<T>&);
+	Vec<T>& operator=(Vec<T>&&) noexcept;
 
-	Vec<T> operator-(const Vec<T>&);
-	Vec<T> operator-(T);
+	// Evaluates a vector expression (e.g. a + b*2.0) in a single pass.
+	template <class E>
+	Vec<T>& operator=(const VecExpr<E>&);
 
-	T operator*(const Vec<T>&);
-	Vec<T> operator*(T);
-	Vec<T> operator/(T);
+	// In-place compound assignments; they never reallocate.
+	template <class E>
+	Vec<T>& operator+=(const VecExpr<E>&);
+	template <class E>
+	Vec<T>& operator-=(const VecExpr<E>&);
+	Vec<T>& operator+=(T);
+	Vec<T>& operator-=(T);
+	Vec<T>& operator*=(T);
+	Vec<T>& operator/=(T);
 
 	T& operator()(size_t k);
 	T& operator[](size_t k);
 
+	// Unchecked element access used by the expression templates.
+	T coeff(size_t k) const { return data_[k]; }
+	bool aliases(const T*) const noexcept { return false; }
+
 protected:
 
 private:
 	// Since we are not using pointers the destructor will
 	// destroy the allocated memory for the object.
-	std::vector<T> data_;
+	std::vector<T, aligned_allocator<T> > data_;
 	size_t length_ = NaN(size_t);
 };
 
@@ -147,23 +213,50 @@ Vec<T>::Vec()
 template <class T>
 Vec<T>::Vec(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<T>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in vec(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in vec(size_t n): " + allocation_error<T>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
+		// The new elements are value-initialized, i.e. zero.
 		data_.resize(n);
 		length_ = data_.size();
-		for (size_t i = 0; i < n; i++)
-		{
-			data_[i] = T(0);
-		}
 	}
 }
 
+// COPY CONSTRUCTOR
+template <class T>
+Vec<T>::Vec(const Vec<T>& v) : data_(v.data_), length_(v.length_) {}
+
+// MOVE CONSTRUCTOR
+// It steals the buffer of v and leaves v as a NULL vector.
+template <class T>
+Vec<T>::Vec(Vec<T>&& v) noexcept : data_(std::move(v.data_)), length_(v.length_)
+{
+	v.data_.clear();
+	v.length_ = 0;
+}
+
+// It evaluates the expression e element by element.
+template <class T>
+template <class E>
+Vec<T>::Vec(const VecExpr<E>& e)
+{
+	const E& expr = e.derived();
+	if ( !allocation_fits<T>(expr.size()) )
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in vec(const VecExpr<E>& e): " + allocation_error<T>(expr.size());
+		log_error(msg.c_str());
+		throw std::length_error(msg);
+	}
+	data_.resize(expr.size());
+	length_ = expr.size();
+	eval_into(data_.data(), expr);
+}
+
 // Destructor
 template <class T>
 Vec<T>::~Vec() {}
@@ -197,6 +290,13 @@ size_t Vec<T>::max_size() const noexcept{ return data_.max_size(); }
 template <class T>
 size_t Vec<T>::capacity() const noexcept{ return data_.capacity(); }
 
+// It returns a pointer to the first element. The elements are contiguous.
+template <class T>
+T* Vec<T>::data() noexcept { return data_.data(); }
+
+template <class T>
+const T* Vec<T>::data() const noexcept { return data_.data(); }
+
 // It assigns the i^th element of the vector the value k
 template <class T>
 void Vec<T>::set(size_t i, T k)
@@ -259,15 +359,53 @@ Vec<T> Vec<T>::get(size_t i, size_t j) const
 	}
 }
 
+// It returns a view of the elements from i to j of the current
+// vector; nothing is copied and writing to the view writes the vector.
+template <class T>
+VecView<T> Vec<T>::view(size_t i, size_t j)
+{
+	if (i >= length_ || j >= length_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in view(size_t i, size_t j)";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if(j < i)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in view(size_t i, size_t j) ==> j < i";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	return VecView<T>(data_.data() + i, j - i + 1, 1, data_.data());
+}
+
+template <class T>
+VecView<const T> Vec<T>::view(size_t i, size_t j) const
+{
+	if (i >= length_ || j >= length_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in view(size_t i, size_t j)";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	else if(j < i)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in view(size_t i, size_t j) ==> j < i";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	return VecView<const T>(data_.data() + i, j - i + 1, 1, data_.data());
+}
+
 // It sets the size of the vector
 template <class T>
 void Vec<T>::set_size(size_t new_size)
 {
-	if ( new_size > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<T>(new_size) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in set_size(size_t new_size): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in set_size(size_t new_size): " + allocation_error<T>(new_size);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else if(length_ == new_size){
 		return;
@@ -337,11 +475,7 @@ Vec<T> Vec<T>::add(const Vec<T>& v1)
 	else
 	{
 		Vec<T> result(v1.length_);
-		size_t i, size = result.size();
-		for (i = size; i--;)
-		{
-			result.data_[i] = data_[i] + v1.data_[i];
-		}
+		simd_add(length_, data_.data(), v1.data_.data(), result.data_.data());
 		return result;
 	}
 }
@@ -359,11 +493,7 @@ Vec<T> Vec<T>::sub(const Vec<T>& v1)
 	else
 	{
 		Vec<T> result(v1.length_);
-		size_t i, size = result.size();
-		for (i = size; i--;)
-		{
-			result.data_[i] = data_[i] - v1.data_[i];
-		}
+		simd_sub(length_, data_.data(), v1.data_.data(), result.data_.data());
 		return result;
 	}
 }
@@ -380,13 +510,7 @@ T Vec<T>::dot(const Vec<T>& v1)
 	}
 	else
 	{
-		T result = 0;
-		size_t i = 0, length = v1.length_;
-		for (i = length; i--;)
-		{
-			result += data_[i] * v1.data_[i];
-		}
-		return result;
+		return simd_dot(length_, data_.data(), v1.data_.data());
 	}
 }
 
@@ -439,220 +563,175 @@ void Vec<T>::swap(size_t i, size_t j)
 /********** OVERLOAD OPERATORS ***********/
 
 // It pass the values of the string in a vector.
-// The input must be of the form "1 2 3" or "[1 2 3]".
+// The input must be of the form "1 2 3" or "[1 2 3]"; commas may separate
+// the numbers too. The vector is left unchanged when the input is invalid.
 template <class T>
 void Vec<T>::operator=(const char* a)
 {
-	// Clear vector from any previous values
-	if ( (*this).size() != 0 )
+	literal_parser parser(a, false, "vec::operator=(const char* a)");
+	Vec<T> tmp(parser.size());
+	parser.parse(tmp.data());
+	*this = std::move(tmp);
+}
+
+// It evaluates the expression e into the current vector. The element-wise
+// expressions read element i only to produce element i, so the current
+// vector may safely appear on the right-hand side (v = v + w). A view of
+// the current vector may read other elements (v = v.view(1, 3)); such an
+// expression is evaluated into a new buffer first.
+template <class T>
+template <class E>
+Vec<T>& Vec<T>::operator=(const VecExpr<E>& e)
+{
+	const E& expr = e.derived();
+	if ( expr.aliases(data_.data()) )
 	{
-		data_.resize(0);
-		length_ = 0;
+		return *this = Vec<T>(expr);
 	}
-
-	//Convert input to string
-	std::string str = std::string(a);
-
-	// Remove brackets if there are any.
-	if (str.size() >= 1)
+	size_t size = expr.size();
+	if (size != length_)
 	{
-		std::string start = str.substr(0,1);
-		std::string end = str.substr(str.size()-1, str.size());
-		if ( start.compare("[") == 0 && end.compare("]") == 0)
+		if ( !allocation_fits<T>(size) )
 		{
-			str.erase(0,1);
-			str.erase(str.size()-1, str.size());
+			std::string msg = FILE_LINE_ERROR + " exception in vec::operator=(const VecExpr<E>& e): " + allocation_error<T>(size);
+			log_error(msg.c_str());
+			throw std::length_error(msg);
 		}
+		data_.resize(size);
+		length_ = size;
 	}
+	eval_into(data_.data(), expr);
+	return *this;
+}
 
-	// Check if str has only numbers. If not, an exception should be thrown.
-	std::string acceptable_characters = " 0123456789.+-";
-	if (str.find_first_not_of(acceptable_characters) != std::string::npos)
+// It copies v into the current vector. The current buffer is
+// reused when it is large enough.
+template <class T>
+Vec<T>& Vec<T>::operator=(const Vec<T>& v)
+{
+	if ( v.data_.size() > data_.capacity() && !allocation_fits<T>(v.length_) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in operator =(const char* a): vec can contain only numbers.";
+		std::string msg = FILE_LINE_ERROR + " exception in vec::operator=(const vec& v): " + allocation_error<T>(v.length_);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
-	}
-
-	// Check if it's an empty string (if there is no number in the string, consider it an empty vector)
-	std::string numbers = "0123456789";
-	if ( str.find_first_of(numbers) == std::string::npos )
-	{
-		data_.resize(0);
-		length_ = 0;
-		return;
-	}
-
-	std::string delimiter = " "; // DEFAULT DELIMITER
-	size_t pos = 0;
-	size_t k = 0;
-	std::string tmp_str = str;
-
-	// Determine vector size
-	while ((pos = tmp_str.find(delimiter)) != std::string::npos)
-	{
-		tmp_str.erase(0, pos + delimiter.length());
-		k++;
-	}
-
-	// Initialize vector
-	data_.resize(k+1);
-	length_ = data_.size();
-
-	k = 0;
-	pos = 0;
-	std::string token;
-
-	// Pass each number into the vector
-	while ((pos = str.find(delimiter)) != std::string::npos)
-	{
-		token = str.substr(0, pos);
-		data_[k] = (T) strtod((token).c_str(),0);
-		str.erase(0, pos + delimiter.length());
-		k++;
+		throw std::length_error(msg);
 	}
-	data_[k] = (T) strtod((str).c_str(),0);
+	data_ = v.data_;
+	length_ = v.length_;
+	return *this;
 }
 
-// It adds vectors v to the current vector (Commutative property holds)
+// It takes over the buffer of v and leaves v as a NULL vector.
 template <class T>
-Vec<T> Vec<T>::operator+(const Vec<T>& v)
+Vec<T>& Vec<T>::operator=(Vec<T>&& v) noexcept
 {
-	if (this->length_ != v.length_)
-	{
-		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator+(const vec& v1)";
-		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
-	}
-	else
-	{
-		Vec<T> result = *this;
-		size_t i = 0, size = result.size();
-		for (i = size; i--;)
-		{
-			result.data_[i] += v.data_[i];
-		}
-		return result;
-	}
+	data_.swap(v.data_);
+	length_ = v.length_;
+	v.data_.clear();
+	v.length_ = 0;
+	return *this;
 }
 
-// It adds the value 't' to each and every element of the vector.
+// It adds the vector expression e to the current vector.
 template <class T>
-Vec<T> Vec<T>::operator+(T t)
+template <class E>
+Vec<T>& Vec<T>::operator+=(const VecExpr<E>& e)
 {
-	if ( (*this).size() == 0 )
+	const E& expr = e.derived();
+	if (length_ != expr.size())
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in operator+(double t): NULL VECTOR";
+		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator+=(const vec& v1)";
 		log_error(msg.c_str());
-		throw std::out_of_range(msg);
+		throw std::invalid_argument(msg);
 	}
-	else
+	if ( expr.aliases(data_.data()) )
 	{
-		Vec<T> result = *this;
-		size_t i = 0, size = result.size();
-		for (i = size; i--;)
-		{
-			result.data_[i] += t;
-		}
-		return result;
+		return *this += Vec<T>(expr);
 	}
+	eval_into(data_.data(), VecBinaryExpr<Vec<T>, E, add_op>(*this, expr));
+	return *this;
 }
 
-// It subtracts vector v from the current vector
+// It subtracts the vector expression e from the current vector.
 template <class T>
-Vec<T> Vec<T>::operator-(const Vec<T>& v)
+template <class E>
+Vec<T>& Vec<T>::operator-=(const VecExpr<E>& e)
 {
-	if (this->length_ != v.length_)
+	const E& expr = e.derived();
+	if (length_ != expr.size())
 	{
-		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator-(const vec& v1)";
+		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator-=(const vec& v1)";
 		log_error(msg.c_str());
 		throw std::invalid_argument(msg);
 	}
-	else
+	if ( expr.aliases(data_.data()) )
 	{
-		Vec<T> result = *this;
-		size_t i = 0, size = result.size();
-		for (i = size; i--;)
-		{
-			result.data_[i] -= v.data_[i];
-		}
-		return result;
+		return *this -= Vec<T>(expr);
 	}
+	eval_into(data_.data(), VecBinaryExpr<Vec<T>, E, sub_op>(*this, expr));
+	return *this;
 }
 
-// It subtracts the value 't' from each and every element of the vector.
+// It adds the value 't' to each and every element of the current vector.
 template <class T>
-Vec<T> Vec<T>::operator-(T t)
+Vec<T>& Vec<T>::operator+=(T t)
 {
-	if ( (*this).size() == 0 )
+	if (length_ == 0)
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in operator-(double t): NULL VECTOR";
+		std::string msg = FILE_LINE_ERROR + " exception in operator+=(double t): NULL VECTOR";
 		log_error(msg.c_str());
 		throw std::out_of_range(msg);
 	}
-	else
+	size_t i;
+	for (i = length_; i--;)
 	{
-		Vec<T> result = *this;
-		size_t i = 0, size = result.size();
-		for (i = size; i--;)
-		{
-			result.data_[i] -= t;
-		}
-		return result;
+		data_[i] += t;
 	}
+	return *this;
 }
 
-// It returns the inner product of the vectors
+// It subtracts the value 't' from each and every element of the current vector.
 template <class T>
-T Vec<T>::operator*(const Vec<T>& v)
+Vec<T>& Vec<T>::operator-=(T t)
 {
-	if (length_ != v.length_)
+	if (length_ == 0)
 	{
-		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator*(const vec& v1)";
+		std::string msg = FILE_LINE_ERROR + " exception in operator-=(double t): NULL VECTOR";
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
-
+		throw std::out_of_range(msg);
 	}
-	else
+	size_t i;
+	for (i = length_; i--;)
 	{
-		return this->dot(v);
+		data_[i] -= t;
 	}
+	return *this;
 }
 
-// It multiplies each elements of the vector with x
+// It multiplies each element of the current vector with t.
 template <class T>
-Vec<T> Vec<T>::operator*(T x)
+Vec<T>& Vec<T>::operator*=(T t)
 {
-	Vec<T> result = *this;
-	size_t i = 0, size = result.size();
-	for (i = size; i--;)
-	{
-		result.data_[i] *= x;
-	}
-	return result;
+	simd_scale(length_, data_.data(), t, data_.data());
+	return *this;
 }
 
-// It devides each element of the vector with t.
+// It devides each element of the current vector with t.
 // I throw exception if t = 0 (undefined behavior in some cases)
 template <class T>
-Vec<T> Vec<T>::operator/(T t)
+Vec<T>& Vec<T>::operator/=(T t)
 {
 	if (t == T(0))
 	{
-		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in operator/(T t): DIVISION BY ZERO ";
+		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in operator/=(T t): DIVISION BY ZERO ";
 		log_error(msg.c_str());
 		throw std::invalid_argument(msg);
 	}
-	else
+	size_t i;
+	for (i = length_; i--;)
 	{
-		Vec<T> result = *this;
-		size_t i = 0, size = result.size();
-		for (i = size; i--;)
-		{
-			result.data_[i] /= t;
-		}
-		return result;
+		data_[i] /= t;
 	}
+	return *this;
 }
 
 // It returns the k^th element of the vector.
@@ -699,6 +778,183 @@ T& Vec<T>::operator[](size_t k)
 	}
 }
 
+// ========= Element-wise operators (see expr.h) ===========
+// They check the operands and return an unevaluated expression.
+
+// It adds vectors l and r (Commutative property holds)
+template <class L, class R>
+inline VecBinaryExpr<L, R, add_op> operator+(const VecExpr<L>& l, const VecExpr<R>& r)
+{
+	if (l.derived().size() != r.derived().size())
+	{
+		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator+(const vec& v1)";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	return VecBinaryExpr<L, R, add_op>(l.derived(), r.derived());
+}
+
+// It adds the value 't' to each and every element of the vector.
+template <class E>
+inline VecScalarExpr<E, add_op> operator+(const VecExpr<E>& e, const typename E::value_type& t)
+{
+	if (e.derived().size() == 0)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in operator+(double t): NULL VECTOR";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecScalarExpr<E, add_op>(e.derived(), t);
+}
+
+// It subtracts vector r from vector l
+template <class L, class R>
+inline VecBinaryExpr<L, R, sub_op> operator-(const VecExpr<L>& l, const VecExpr<R>& r)
+{
+	if (l.derived().size() != r.derived().size())
+	{
+		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator-(const vec& v1)";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	return VecBinaryExpr<L, R, sub_op>(l.derived(), r.derived());
+}
+
+// It subtracts the value 't' from each and every element of the vector.
+template <class E>
+inline VecScalarExpr<E, sub_op> operator-(const VecExpr<E>& e, const typename E::value_type& t)
+{
+	if (e.derived().size() == 0)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in operator-(double t): NULL VECTOR";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecScalarExpr<E, sub_op>(e.derived(), t);
+}
+
+// It returns the inner product of the vectors
+template <class L, class R>
+inline typename L::value_type operator*(const VecExpr<L>& l, const VecExpr<R>& r)
+{
+	const L& v1 = l.derived();
+	const R& v2 = r.derived();
+	if (v1.size() != v2.size())
+	{
+		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator*(const vec& v1)";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	typename L::value_type result = 0;
+	size_t i, size = v1.size();
+	for (i = size; i--;)
+	{
+		result += v1.coeff(i) * v2.coeff(i);
+	}
+	return result;
+}
+
+// It returns the inner product of the vectors (vectorized for containers).
+template <class T>
+inline T operator*(const Vec<T>& v1, const Vec<T>& v2)
+{
+	if (v1.size() != v2.size())
+	{
+		std::string msg = FILE_LINE_ERROR + " Dimension mismatch for operator*(const vec& v1)";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	return simd_dot(v1.size(), v1.data(), v2.data());
+}
+
+// It multiplies each elements of the vector with x
+template <class E>
+inline VecScalarExpr<E, mul_op> operator*(const VecExpr<E>& e, const typename E::value_type& x)
+{
+	return VecScalarExpr<E, mul_op>(e.derived(), x);
+}
+
+// It devides each element of the vector with t.
+// I throw exception if t = 0 (undefined behavior in some cases)
+template <class E>
+inline VecScalarExpr<E, div_op> operator/(const VecExpr<E>& e, const typename E::value_type& t)
+{
+	if (t == typename E::value_type(0))
+	{
+		std::string msg = FILE_LINE_ERROR + " 'std::invalid_argument' thrown in operator/(T t): DIVISION BY ZERO ";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	return VecScalarExpr<E, div_op>(e.derived(), t);
+}
+
+// ========= Operators on temporaries ===========
+// When an operand is a temporary vector (e.g. the result of a function)
+// its buffer is reused for the result instead of allocating a new one.
+
+template <class T, class R>
+inline Vec<T> operator+(Vec<T>&& l, const VecExpr<R>& r)
+{
+	l += r;
+	return std::move(l);
+}
+
+template <class L, class T>
+inline Vec<T> operator+(const VecExpr<L>& l, Vec<T>&& r)
+{
+	r += l;
+	return std::move(r);
+}
+
+template <class T>
+inline Vec<T> operator+(Vec<T>&& l, Vec<T>&& r)
+{
+	l += r;
+	return std::move(l);
+}
+
+template <class T, class R>
+inline Vec<T> operator-(Vec<T>&& l, const VecExpr<R>& r)
+{
+	l -= r;
+	return std::move(l);
+}
+
+template <class T>
+inline Vec<T> operator+(Vec<T>&& v, const typename Vec<T>::value_type& t)
+{
+	v += t;
+	return std::move(v);
+}
+
+template <class T>
+inline Vec<T> operator-(Vec<T>&& v, const typename Vec<T>::value_type& t)
+{
+	v -= t;
+	return std::move(v);
+}
+
+template <class T>
+inline Vec<T> operator*(Vec<T>&& v, const typename Vec<T>::value_type& t)
+{
+	v *= t;
+	return std::move(v);
+}
+
+template <class T>
+inline Vec<T> operator/(Vec<T>&& v, const typename Vec<T>::value_type& t)
+{
+	v /= t;
+	return std::move(v);
+}
+
+// It evaluates the vector expression e into a new vector.
+template <class E>
+inline Vec<typename E::value_type> eval(const VecExpr<E>& e)
+{
+	return Vec<typename E::value_type>(e);
+}
+
 // ##################################################################################################
 // ############################ MISCELLANEOUS OPERATIONS AND FUNCTIONS ##############################
 
@@ -706,11 +962,11 @@ T& Vec<T>::operator[](size_t k)
 // It returns a 'double'-vector of size n with all elements equal to 0.
 inline vec zeros(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<double>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in vec::zeros(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in vec::zeros(size_t n): " + allocation_error<double>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -727,11 +983,11 @@ inline vec zeros(size_t n)
 // It returns an 'integer'-vector of size n with all elements equal to 0.
 inline ivec zeros_i(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<int>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in vec::zeros(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in vec::zeros_i(size_t n): " + allocation_error<int>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -748,11 +1004,11 @@ inline ivec zeros_i(size_t n)
 // It returns a 'double'-vector of size n with all elements equal to 1.
 inline vec ones(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<double>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in ones(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in ones(size_t n): " + allocation_error<double>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -769,11 +1025,11 @@ inline vec ones(size_t n)
 // It returns a 'integer'-vector of size n with all elements equal to 1.
 inline ivec ones_i(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<int>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in ones(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in ones(size_t n): " + allocation_error<int>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -833,11 +1089,11 @@ inline ivec find_zero(const Vec<T>& v)
 // random values within the range [-10, 10].
 inline vec rand(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<double>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in rand(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in rand(size_t n): " + allocation_error<double>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -866,11 +1122,11 @@ inline vec rand(size_t n)
 // random values within the range [-10, 10].
 inline ivec rand_i(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<int>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in rand_i(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in rand_i(size_t n): " + allocation_error<int>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -899,7 +1155,11 @@ inline ivec rand_i(size_t n)
 template <class T>
 inline T dot(const Vec<T>& v1, const Vec<T>& v2)
 {
-	if ( v1.size() != v1.size() )
+	if ( v1.size() == 0 || v2.size() == 0 )
+	{
+		return T(0); // dot product with at least one null vector is 0.
+	}
+	else if ( v1.size() != v2.size() )
 	{
 		std::string msg = FILE_LINE_ERROR + " dimension mismatch in dot(const vec& v1, const vec& v2)";
 		log_error(msg.c_str());
@@ -907,13 +1167,7 @@ inline T dot(const Vec<T>& v1, const Vec<T>& v2)
 	}
 	else
 	{
-		T result = 0;
-		size_t i = 0, size = v1.size();
-		for (i = size; i--;)
-		{
-			result += v1.get(i)*v2.get(i);
-		}
-		return result;
+		return simd_dot(v1.size(), v1.data(), v2.data());
 	}
 }
 
@@ -1074,11 +1328,11 @@ inline Vec<T> concat(const Vec<T>& v, T t)
 		result.set(0, t);
 		return result;
 	}
-	else if ( v.size() == MAX_ACCEPTABLE_VECTOR_SIZE )
+	else if ( !allocation_fits<T>(v.size() + 1) )
 	{
-		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in concat(const vec& v, double t)";
+		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in concat(const vec& v, double t): " + allocation_error<T>(v.size() + 1);
 		log_error(msg.c_str());
-		throw std::out_of_range(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1103,11 +1357,11 @@ inline Vec<T> concat(T t, const Vec<T>& v)
 		result.set(0, t);
 		return result;
 	}
-	else if ( v.size() == MAX_ACCEPTABLE_VECTOR_SIZE )
+	else if ( !allocation_fits<T>(v.size() + 1) )
 	{
-		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in concat(double t, const vec& v)";
+		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in concat(double t, const vec& v): " + allocation_error<T>(v.size() + 1);
 		log_error(msg.c_str());
-		throw std::out_of_range(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1131,11 +1385,11 @@ inline Vec<T> concat(const Vec<T>& v1, const Vec<T>& v2)
 		// Concatenation of null vectors should yield back a null vector
 		return Vec<T>(0);
 	}
-	else if (v1.size() + v2.size() > MAX_ACCEPTABLE_VECTOR_SIZE)
+	else if ( !allocation_fits<T>(v1.size() + v2.size()) )
 	{
-		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in concat(const vec& v1, const vec& v2)";
+		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in concat(const vec& v1, const vec& v2): " + allocation_error<T>(v1.size() + v2.size());
 		log_error(msg.c_str());
-		throw std::out_of_range(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1169,11 +1423,11 @@ inline Vec<T> linspace(T from, T to, size_t step)
 		log_error(msg.c_str());
 		throw std::invalid_argument(msg);
 	}
-	else if (size > MAX_ACCEPTABLE_VECTOR_SIZE)
+	else if ( !allocation_fits<T>(size) )
 	{
-		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in linspace(double from, double to, size_t step)";
+		std::string msg = FILE_LINE_ERROR + " Inputs define out of range vector in linspace(double from, double to, size_t step): " + allocation_error<T>(size);
 		log_error(msg.c_str());
-		throw std::out_of_range(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1200,11 +1454,7 @@ inline Vec<T> elem_mult(const Vec<T>& v1, const Vec<T>& v2)
 	else
 	{
 		Vec<T> result(v1.size());
-		size_t i = 0, size = result.size();
-		for (i = size; i--;)
-		{
-			result.set(i, v1.get(i)*v2.get(i));
-		}
+		simd_mul(v1.size(), v1.data(), v2.data(), result.data());
 		return result;
 	}
 }
@@ -1213,13 +1463,7 @@ inline Vec<T> elem_mult(const Vec<T>& v1, const Vec<T>& v2)
 template <class T>
 inline T sum(const Vec<T>& v)
 {
-	T result = 0;
-	size_t i = 0, size = v.size();
-	for (i = size; i--;)
-	{
-		result += v.get(i);
-	}
-	return result;
+	return simd_sum(v.size(), v.data());
 }
 
 // It computes the cumulative sum of v1
@@ -1256,17 +1500,19 @@ inline double norm(const Vec<T>& v)
 	return std::sqrt(result);
 }
 
+// It computes the 2-norm for Euclidean space
+inline double norm(const vec& v)
+{
+	return std::sqrt(simd_dot(v.size(), v.data(), v.data()));
+}
+
 // It returns a vector whose i^th element equals
 // to the absolute value of i^th element of vector v
 template <class T>
 inline Vec<T> abs(const Vec<T>& v)
 {
 	Vec<T> result(v.size());
-	size_t i = 0, size = v.size();
-	for (i = size; i--;)
-	{
-		result(i) = std::abs(v.get(i));
-	}
+	simd_abs(v.size(), v.data(), result.data());
 	return result;
 }
 
@@ -1291,17 +1537,24 @@ inline void print(const Vec<T>& v)
 	}
 }
 
+// It prints the elements of the vector expression e.
+template <class E>
+inline void print(const VecExpr<E>& e)
+{
+	print(eval(e));
+}
+
 // ##################################################################################################
 // ########################### COMPLEX NUMBER OPERATIONS AND FUNCTIONS ##############################
 
 // It returns an 'complex'-vector of size n with all elements equal to 0.
 inline cvec zeros_c(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<std::complex<double>>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in vec::zeros(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in vec::zeros_c(size_t n): " + allocation_error<std::complex<double>>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
@@ -1320,11 +1573,11 @@ inline cvec zeros_c(size_t n)
 // random values within the range [-10, 10].
 inline cvec rand_c(size_t n)
 {
-	if ( n > MAX_ACCEPTABLE_VECTOR_SIZE )
+	if ( !allocation_fits<std::complex<double>>(n) )
 	{
-		std::string msg = FILE_LINE_ERROR + " exception in rand_c(size_t n): n should lie in [0," + std::to_string(MAX_ACCEPTABLE_VECTOR_SIZE) +"]";
+		std::string msg = FILE_LINE_ERROR + " exception in rand_c(size_t n): " + allocation_error<std::complex<double>>(n);
 		log_error(msg.c_str());
-		throw std::invalid_argument(msg);
+		throw std::length_error(msg);
 	}
 	else
 	{
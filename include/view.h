@@ -0,0 +1,458 @@
+/*============================================================================
+ * Name         : view.h implements VecView and MatView, non-owning strided
+ *                views of the storage of a Vec or a Mat (sub-vectors, rows,
+ *                columns and sub-blocks). They are read by the arithmetic
+ *                operators like any other expression, and they can be
+ *                written through.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of the LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+================================================================================*/
+
+/* A view copies nothing: it is a pointer, its dimensions and a stride.
+ *
+ *     mat P(6, 6);
+ *     P.view(0, 2, 3, 5) = A*B;         // writes the block rows 0..2, cols 3..5
+ *     P.row_view(1) *= 2.0;             // scales a row in place
+ *     vec c = P.col_view(4);            // copies a column (stride 6)
+ *     double s = x.view(k, k + 9)*w;    // a sliding window of 10 elements
+ *
+ * A view of a const container is a VecView<const T> or a MatView<const T>,
+ * which cannot be written. Assigning to a view writes its elements; it
+ * does not rebind it.
+ *
+ * ATTENTION: like an expression, a view is only valid as long as its
+ * container exists and is not resized.
+ */
+
+#ifndef VIEW_H_
+#define VIEW_H_
+
+#include <stddef.h>     // size_t
+#include <type_traits>  // std::remove_const
+
+#include "expr.h"
+
+namespace algebra {
+
+// ##################################################################################################
+// ############################################ VECTOR VIEW #########################################
+
+// size() elements of a buffer, stride() elements apart.
+template <class T>
+class VecView : public VecExpr< VecView<T> > {
+public:
+	typedef typename std::remove_const<T>::type value_type;
+
+	// base is the start of the buffer the view points into; it
+	// identifies the storage for the aliasing checks.
+	VecView(T* data, size_t size, size_t stride, const value_type* base) :
+		data_(data), size_(size), stride_(stride), base_(base) {}
+	VecView(const VecView<T>&) = default;
+
+	size_t size() const noexcept { return size_; }
+	size_t stride() const noexcept { return stride_; }
+	T* data() const noexcept { return data_; }
+
+	value_type coeff(size_t i) const { return data_[i*stride_]; }
+	bool aliases(const value_type* p) const noexcept { return base_ == p; }
+
+	T& operator[](size_t i) const { return data_[i*stride_]; }
+	T& operator()(size_t i) const;
+
+	VecView<T>& operator=(const VecView<T>&);
+	template <class E>
+	VecView<T>& operator=(const VecExpr<E>&);
+	template <class E>
+	VecView<T>& operator+=(const VecExpr<E>&);
+	template <class E>
+	VecView<T>& operator-=(const VecExpr<E>&);
+	VecView<T>& operator=(value_type);
+	VecView<T>& operator+=(value_type);
+	VecView<T>& operator-=(value_type);
+	VecView<T>& operator*=(value_type);
+	VecView<T>& operator/=(value_type);
+
+private:
+	template <class E, class F>
+	void assign(const E& expr, const F& f);
+
+	T* data_;
+	size_t size_;
+	size_t stride_;
+	const value_type* base_;
+};
+
+template <class T>
+T& VecView<T>::operator()(size_t i) const
+{
+	if (i >= size_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in vec_view::operator()(size_t i): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return data_[i*stride_];
+}
+
+// It runs f(data_[i*stride], expr.coeff(i)) for every element. An
+// expression reading the same buffer is evaluated into a Vec first,
+// since the view may overlap what it reads.
+template <class T>
+template <class E, class F>
+void VecView<T>::assign(const E& expr, const F& f)
+{
+	if (expr.size() != size_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in vec_view::operator=(const vec& v): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	if ( expr.aliases(base_) )
+	{
+		const Vec<value_type> tmp(expr);
+		assign(tmp, f);
+		return;
+	}
+	T* d = data_;
+	const size_t s = stride_;
+	parallel_for(0, size_, PARALLEL_GRAIN, [&](size_t lo, size_t hi)
+	{
+		size_t i;
+		for (i = lo; i < hi; i++)
+		{
+			f(d[i*s], expr.coeff(i));
+		}
+	});
+}
+
+// It copies the elements of v into the elements of the view.
+template <class T>
+VecView<T>& VecView<T>::operator=(const VecView<T>& v)
+{
+	assign(v, [](value_type& x, const value_type& y) { x = y; });
+	return *this;
+}
+
+// It evaluates the expression e into the elements of the view.
+template <class T>
+template <class E>
+VecView<T>& VecView<T>::operator=(const VecExpr<E>& e)
+{
+	assign(e.derived(), [](value_type& x, const value_type& y) { x = y; });
+	return *this;
+}
+
+template <class T>
+template <class E>
+VecView<T>& VecView<T>::operator+=(const VecExpr<E>& e)
+{
+	assign(e.derived(), [](value_type& x, const value_type& y) { x += y; });
+	return *this;
+}
+
+template <class T>
+template <class E>
+VecView<T>& VecView<T>::operator-=(const VecExpr<E>& e)
+{
+	assign(e.derived(), [](value_type& x, const value_type& y) { x -= y; });
+	return *this;
+}
+
+// It sets every element of the view to t.
+template <class T>
+VecView<T>& VecView<T>::operator=(value_type t)
+{
+	size_t i;
+	for (i = 0; i < size_; i++)
+	{
+		data_[i*stride_] = t;
+	}
+	return *this;
+}
+
+template <class T>
+VecView<T>& VecView<T>::operator+=(value_type t)
+{
+	size_t i;
+	for (i = 0; i < size_; i++)
+	{
+		data_[i*stride_] += t;
+	}
+	return *this;
+}
+
+template <class T>
+VecView<T>& VecView<T>::operator-=(value_type t)
+{
+	size_t i;
+	for (i = 0; i < size_; i++)
+	{
+		data_[i*stride_] -= t;
+	}
+	return *this;
+}
+
+template <class T>
+VecView<T>& VecView<T>::operator*=(value_type t)
+{
+	size_t i;
+	for (i = 0; i < size_; i++)
+	{
+		data_[i*stride_] *= t;
+	}
+	return *this;
+}
+
+template <class T>
+VecView<T>& VecView<T>::operator/=(value_type t)
+{
+	size_t i;
+	for (i = 0; i < size_; i++)
+	{
+		data_[i*stride_] /= t;
+	}
+	return *this;
+}
+
+
+// ##################################################################################################
+// ############################################ MATRIX VIEW #########################################
+
+// A rows() x cols() block of a row-major buffer whose rows are ld()
+// elements apart.
+template <class T>
+class MatView : public MatExpr< MatView<T> > {
+public:
+	typedef typename std::remove_const<T>::type value_type;
+
+	// base is the start of the buffer the view points into; it
+	// identifies the storage for the aliasing checks.
+	MatView(T* data, size_t rows, size_t cols, size_t ld, const value_type* base) :
+		data_(data), rows_(rows), cols_(cols), ld_(ld), base_(base) {}
+	MatView(const MatView<T>&) = default;
+
+	size_t rows() const noexcept { return rows_; }
+	size_t cols() const noexcept { return cols_; }
+	size_t size() const noexcept { return rows_*cols_; }
+	size_t ld() const noexcept { return ld_; }
+	T* data() const noexcept { return data_; }
+
+	value_type coeff(size_t i, size_t j) const { return data_[i*ld_ + j]; }
+	// Any other block of the same buffer may overlap this one.
+	bool aliases(const value_type* p) const noexcept { return base_ == p; }
+	bool depends_on(const value_type* p) const noexcept { return base_ == p; }
+
+	T& operator()(size_t i, size_t j) const;
+	VecView<T> row_view(size_t i) const;
+	VecView<T> col_view(size_t j) const;
+
+	MatView<T>& operator=(const MatView<T>&);
+	template <class E>
+	MatView<T>& operator=(const MatExpr<E>&);
+	template <class E>
+	MatView<T>& operator+=(const MatExpr<E>&);
+	template <class E>
+	MatView<T>& operator-=(const MatExpr<E>&);
+	MatView<T>& operator=(value_type);
+	MatView<T>& operator+=(value_type);
+	MatView<T>& operator-=(value_type);
+	MatView<T>& operator*=(value_type);
+	MatView<T>& operator/=(value_type);
+
+private:
+	template <class E, class F>
+	void assign(const E& expr, const F& f);
+	template <class F>
+	void apply(const F& f);
+
+	T* data_;
+	size_t rows_;
+	size_t cols_;
+	size_t ld_;
+	const value_type* base_;
+};
+
+template <class T>
+T& MatView<T>::operator()(size_t i, size_t j) const
+{
+	if (i >= rows_ || j >= cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mat_view::operator()(size_t i, size_t j): index out of range";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return data_[i*ld_ + j];
+}
+
+// It returns the i^th row of the view.
+template <class T>
+VecView<T> MatView<T>::row_view(size_t i) const
+{
+	if (i >= rows_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mat_view::row_view(size_t i): Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecView<T>(data_ + i*ld_, cols_, 1, base_);
+}
+
+// It returns the j^th column of the view.
+template <class T>
+VecView<T> MatView<T>::col_view(size_t j) const
+{
+	if (j >= cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mat_view::col_view(size_t j): Index exceeds matrix dimensions";
+		log_error(msg.c_str());
+		throw std::out_of_range(msg);
+	}
+	return VecView<T>(data_ + j, rows_, ld_, base_);
+}
+
+// It runs f(element (i,j) of the view, expr.coeff(i,j)) row by row. An
+// expression reading the same buffer is evaluated into a Mat first.
+template <class T>
+template <class E, class F>
+void MatView<T>::assign(const E& expr, const F& f)
+{
+	if (expr.rows() != rows_ || expr.cols() != cols_)
+	{
+		std::string msg = FILE_LINE_ERROR + " exception in mat_view::operator=(const mat& m): dimension mismatch";
+		log_error(msg.c_str());
+		throw std::invalid_argument(msg);
+	}
+	if (cols_ == 0)
+	{
+		return;
+	}
+	if ( expr.depends_on(base_) )
+	{
+		const Mat<value_type> tmp(expr);
+		assign(tmp, f);
+		return;
+	}
+	T* d = data_;
+	const size_t ld = ld_, cols = cols_;
+	parallel_for(0, rows_, PARALLEL_GRAIN/cols, [&](size_t lo, size_t hi)
+	{
+		size_t i, j;
+		for (i = lo; i < hi; i++)
+		{
+			T* row = d + i*ld;
+			for (j = 0; j < cols; j++)
+			{
+				f(row[j], expr.coeff(i, j));
+			}
+		}
+	});
+}
+
+// It runs f on every element of the view.
+template <class T>
+template <class F>
+void MatView<T>::apply(const F& f)
+{
+	size_t i, j;
+	for (i = 0; i < rows_; i++)
+	{
+		T* row = data_ + i*ld_;
+		for (j = 0; j < cols_; j++)
+		{
+			f(row[j]);
+		}
+	}
+}
+
+// It copies the elements of m into the elements of the view.
+template <class T>
+MatView<T>& MatView<T>::operator=(const MatView<T>& m)
+{
+	assign(m, [](value_type& x, const value_type& y) { x = y; });
+	return *this;
+}
+
+// It evaluates the expression e into the elements of the view.
+template <class T>
+template <class E>
+MatView<T>& MatView<T>::operator=(const MatExpr<E>& e)
+{
+	assign(e.derived(), [](value_type& x, const value_type& y) { x = y; });
+	return *this;
+}
+
+template <class T>
+template <class E>
+MatView<T>& MatView<T>::operator+=(const MatExpr<E>& e)
+{
+	assign(e.derived(), [](value_type& x, const value_type& y) { x += y; });
+	return *this;
+}
+
+template <class T>
+template <class E>
+MatView<T>& MatView<T>::operator-=(const MatExpr<E>& e)
+{
+	assign(e.derived(), [](value_type& x, const value_type& y) { x -= y; });
+	return *this;
+}
+
+// It sets every element of the view to t.
+template <class T>
+MatView<T>& MatView<T>::operator=(value_type t)
+{
+	apply([t](value_type& x) { x = t; });
+	return *this;
+}
+
+template <class T>
+MatView<T>& MatView<T>::operator+=(value_type t)
+{
+	apply([t](value_type& x) { x += t; });
+	return *this;
+}
+
+template <class T>
+MatView<T>& MatView<T>::operator-=(value_type t)
+{
+	apply([t](value_type& x) { x -= t; });
+	return *this;
+}
+
+template <class T>
+MatView<T>& MatView<T>::operator*=(value_type t)
+{
+	apply([t](value_type& x) { x *= t; });
+	return *this;
+}
+
+template <class T>
+MatView<T>& MatView<T>::operator/=(value_type t)
+{
+	apply([t](value_type& x) { x /= t; });
+	return *this;
+}
+
+} /* namespace algebra */
+
+#endif /* VIEW_H_ */
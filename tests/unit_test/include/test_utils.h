@@ -0,0 +1,54 @@
+/*====================================================================================================
+ * Name         : test_utils.h implements the helpers shared by the unit-tests
+ *                of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+#ifndef TEST_UTILS_H_
+#define TEST_UTILS_H_
+
+#include <stddef.h>     // size_t
+#include <cmath>        // std::abs
+#include <complex>
+#include <algorithm>    // std::max
+
+namespace algebra {
+
+// It returns the largest element-wise distance between a and b, any two
+// containers of the same size with data() and size(), e.g. vec and mat.
+template <class C>
+double max_abs_diff(const C& a, const C& b)
+{
+	double diff = 0;
+	size_t i;
+	for (i = a.size(); i--;)
+	{
+		diff = std::max(diff, (double) std::abs(a.data()[i] - b.data()[i]));
+	}
+	return diff;
+}
+
+} /* namespace algebra */
+
+#endif /* TEST_UTILS_H_ */
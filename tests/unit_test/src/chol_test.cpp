@@ -0,0 +1,176 @@
+/*====================================================================================================
+ * Name         : chol_test.cpp implements a unit-test for the Cholesky and LDL
+ *                factorizations (include/chol.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+#include "../include/test_utils.h"
+
+namespace algebra {
+
+// It returns a random n x n symmetric positive definite matrix.
+inline mat rand_spd(size_t n)
+{
+	mat a = rand(n, n);
+	return a*transpose(a) + eye(n)*double(n);
+}
+
+TEST_CASE( " Test 'chol(const mat& a)' and 'chol_solve(const mat& l, const vec& b)' " ){
+	SECTION("Test normal conditions."){
+		//		| 4  12 -16|		 | 2 0 0|
+		//  a = | 12 37 -43| ,  l = | 6 1 0|
+		//		|-16 -43 98|		 |-8 5 3|
+		mat a; a = "[4 12 -16;12 37 -43;-16 -43 98]";
+		mat l = chol(a);
+		mat expected; expected = "[2 0 0;6 1 0;-8 5 3]";
+		REQUIRE( max_abs_diff(l, expected) < 1e-12 );
+
+		vec b; b = "[1 2 3]";
+		vec x = chol_solve(l, b), ref = solve(a, b);
+		REQUIRE( x[0] == Approx(ref[0]) );
+		REQUIRE( x[1] == Approx(ref[1]) );
+		REQUIRE( x[2] == Approx(ref[2]) );
+	}
+	SECTION("Test large matrices (several blocks)."){
+		size_t n = 200;
+		mat a = rand_spd(n), l;
+		REQUIRE( chol(a, l) == true );
+		REQUIRE( max_abs_diff(mat(l*transpose(l)), a) < 1e-9 );
+		size_t i, j, non_zero = 0;
+		for(i = n; i--;){
+			for(j = i + 1; j < n; j++){
+				if (l(i, j) != 0) { non_zero++; }
+			}
+		}
+		REQUIRE( non_zero == 0 );
+		mat b = rand(n, 7);
+		mat x = chol_solve(l, b);
+		REQUIRE( max_abs_diff(mat(a*x), b) < 1e-9 );
+	}
+	SECTION("Test complex values."){
+		// Hermitian positive definite: a = |2  i|
+		//                                  |-i 2|
+		cmat a(2,2);
+		a(0,0) = 2.+0i; a(0,1) = 0.+1i;
+		a(1,0) = 0.-1i; a(1,1) = 2.+0i;
+		cmat l = chol(a);
+		cmat back = l*conj_transpose(l);
+		REQUIRE( max_abs_diff(back, a) < 1e-12 );
+		REQUIRE( l(0,1).real() == 0 );
+		REQUIRE( l(0,1).imag() == 0 );
+	}
+	SECTION("Test boundary conditions."){
+		mat a; a = "[1 2 3;4 5 6]";
+		REQUIRE_THROWS( chol(a) );
+		mat empty;
+		REQUIRE_THROWS( chol(empty) );
+		// Not positive definite: NaN and a warning.
+		a = "[1 2;2 1]";
+		mat l;
+		REQUIRE( chol(a, l) == false );
+		l = chol(a);
+		REQUIRE( isnan(l(0,0)) == 1 );
+		vec b; b = "[1 2 3]";
+		a = "[4 0;0 9]";
+		REQUIRE_THROWS( chol_solve(chol(a), b) );
+	}
+}
+
+TEST_CASE( " Test 'chol_update(mat& l, const vec& x)' and 'chol_downdate(mat& l, const vec& x)' " ){
+	SECTION("Test normal conditions."){
+		size_t n = 30;
+		mat a = rand_spd(n), l = chol(a);
+		vec x = rand(n, 1).get_col(0);
+		mat a_up = a + outer_product(x, x);
+
+		chol_update(l, x);
+		REQUIRE( max_abs_diff(mat(l*transpose(l)), a_up) < 1e-9 );
+		REQUIRE( max_abs_diff(l, chol(a_up)) < 1e-9 );
+
+		REQUIRE( chol_downdate(l, x) == true );
+		REQUIRE( max_abs_diff(mat(l*transpose(l)), a) < 1e-9 );
+	}
+	SECTION("Test complex values."){
+		cmat a(2,2);
+		a(0,0) = 2.+0i; a(0,1) = 0.+1i;
+		a(1,0) = 0.-1i; a(1,1) = 2.+0i;
+		cvec x(2);
+		x[0] = 1.+1i; x[1] = 0.5-2i;
+		cmat l = chol(a), a_up(2,2);
+		size_t i, j;
+		for(i = 2; i--;){
+			for(j = 2; j--;){
+				a_up(i,j) = a(i,j) + x[i]*std::conj(x[j]);
+			}
+		}
+		chol_update(l, x);
+		REQUIRE( max_abs_diff(cmat(l*conj_transpose(l)), a_up) < 1e-12 );
+		REQUIRE( chol_downdate(l, x) == true );
+		REQUIRE( max_abs_diff(cmat(l*conj_transpose(l)), a) < 1e-12 );
+	}
+	SECTION("Test boundary conditions."){
+		mat a; a = "[1 0;0 1]";
+		mat l = chol(a), before = l;
+		vec x; x = "[2 0]";
+		// I - x*x' is indefinite: l is left unchanged.
+		REQUIRE( chol_downdate(l, x) == false );
+		REQUIRE( max_abs_diff(l, before) == 0 );
+		vec wrong; wrong = "[1 2 3]";
+		REQUIRE_THROWS( chol_update(l, wrong) );
+	}
+}
+
+TEST_CASE( " Test 'ldl(const mat& a, mat& l, vec& d)' and 'ldl_solve(...)' " ){
+	SECTION("Test normal conditions."){
+		// Symmetric indefinite matrix: chol() fails, ldl() does not.
+		mat a; a = "[4 2 -2;2 -3 1;-2 1 5]";
+		mat l; vec d;
+		ldl(a, l, d);
+		REQUIRE( d[0] == Approx(4) );
+		REQUIRE( d[1] == Approx(-4) );
+		mat back = l*diag(d)*transpose(l);
+		REQUIRE( max_abs_diff(back, a) < 1e-12 );
+		REQUIRE( l(0,0) == 1 ); REQUIRE( l(1,1) == 1 ); REQUIRE( l(2,2) == 1 );
+		REQUIRE( l(0,1) == 0 ); REQUIRE( l(0,2) == 0 ); REQUIRE( l(1,2) == 0 );
+
+		vec b; b = "[1 2 3]";
+		vec x = ldl_solve(l, d, b), ref = solve(a, b);
+		REQUIRE( x[0] == Approx(ref[0]) );
+		REQUIRE( x[1] == Approx(ref[1]) );
+		REQUIRE( x[2] == Approx(ref[2]) );
+	}
+	SECTION("Test boundary conditions."){
+		mat a; a = "[0 1;1 0]"; // singular leading minor
+		mat l; vec d;
+		ldl(a, l, d);
+		REQUIRE( isnan(d[0]) == 1 );
+		a = "[1 2 3;4 5 6]";
+		REQUIRE_THROWS( ldl(a, l, d) );
+	}
+}
+
+} /* namespace algebra */
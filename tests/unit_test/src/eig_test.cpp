@@ -0,0 +1,235 @@
+/*====================================================================================================
+ * Name         : eig_test.cpp implements a unit-test for the symmetric
+ *                eigensolver eig_sym() (include/eig.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+#include "../include/test_utils.h"
+
+
+namespace algebra {
+
+// It returns the largest |a*x(:,j) - lambda(j)*x(:,j)|.
+template <class T>
+double eig_residual(const Mat<T>& a, const vec& lambda, const Mat<T>& x)
+{
+	Mat<T> ax = a*x;
+	size_t n = a.rows(), i, j;
+	double diff = 0;
+	for (i = 0; i < n; i++){
+		for (j = 0; j < n; j++){
+			diff = std::max(diff, (double) std::abs(ax.get(i, j) - T(lambda.get(j))*x.get(i, j)));
+		}
+	}
+	return diff;
+}
+
+TEST_CASE( " Test 'eig_sym(const mat& a, vec& lambda, mat& x)' " ){
+	SECTION("Test normal conditions."){
+		//		|2 1 0|
+		//  a = |1 2 1| , lambda = [2-sqrt(2) 2 2+sqrt(2)]
+		//		|0 1 2|
+		mat a; a = "[2 1 0;1 2 1;0 1 2]";
+		vec lambda;
+		mat x;
+		eig_sym(a, lambda, x);
+		REQUIRE( lambda[0] == Approx(2 - std::sqrt(2.0)) );
+		REQUIRE( lambda[1] == Approx(2) );
+		REQUIRE( lambda[2] == Approx(2 + std::sqrt(2.0)) );
+		REQUIRE( eig_residual(a, lambda, x) < 1e-13 );
+		REQUIRE( max_abs_diff(mat(transpose(x)*x), eye(3)) < 1e-14 );
+
+		vec only = eig_sym(a);
+		REQUIRE( only[0] == Approx(lambda[0]) );
+		REQUIRE( only[2] == Approx(lambda[2]) );
+	}
+	SECTION("Test large matrices (several blocks)."){
+		size_t n = 150, i, unsorted = 0;
+		mat b = rand(n, n);
+		mat a = b + transpose(b);
+		vec lambda;
+		mat x;
+		eig_sym(a, lambda, x);
+		REQUIRE( eig_residual(a, lambda, x) < 1e-10 );
+		REQUIRE( max_abs_diff(mat(transpose(x)*x), eye(n)) < 1e-12 );
+		for (i = 1; i < n; i++){
+			if (lambda[i] < lambda[i - 1]) { unsorted++; }
+		}
+		REQUIRE( unsorted == 0 );
+
+		// The trace is the sum of the eigenvalues.
+		double trace = 0, sum = 0;
+		for (i = 0; i < n; i++){
+			trace += a(i, i);
+			sum += lambda[i];
+		}
+		REQUIRE( sum == Approx(trace) );
+
+		// Only the lower triangle is read.
+		mat lower = a;
+		for (i = 0; i < n; i++){
+			size_t j;
+			for (j = i + 1; j < n; j++){
+				lower(i, j) = 0;
+			}
+		}
+		vec lambda_lower = eig_sym(lower);
+		REQUIRE( lambda_lower[0] == Approx(lambda[0]) );
+		REQUIRE( lambda_lower[n - 1] == Approx(lambda[n - 1]) );
+	}
+	SECTION("Test complex values."){
+		size_t n = 70;
+		cmat b = rand_c(n, n);
+		cmat a = b + conj_transpose(b);
+		vec lambda;
+		cmat x;
+		eig_sym(a, lambda, x);
+		REQUIRE( eig_residual(a, lambda, x) < 1e-10 );
+		REQUIRE( max_abs_diff(cmat(conj_transpose(x)*x), eye_c(n)) < 1e-12 );
+	}
+	SECTION("Test boundary conditions."){
+		mat one; one = "[5]";
+		vec lambda;
+		mat x;
+		eig_sym(one, lambda, x);
+		REQUIRE( lambda[0] == 5 );
+		REQUIRE( x(0, 0) == 1 );
+
+		// Repeated eigenvalues.
+		vec repeated = eig_sym(eye(40));
+		REQUIRE( repeated[0] == Approx(1) );
+		REQUIRE( repeated[39] == Approx(1) );
+
+		mat empty, rect = rand(3, 4);
+		REQUIRE_THROWS( eig_sym(empty) );
+		REQUIRE_THROWS( eig_sym(rect, lambda, x) );
+	}
+}
+
+// It returns the largest |a*x(:,j) - lambda(j)*x(:,j)| for a real a.
+inline double eig_residual(const mat& a, const cvec& lambda, const cmat& x)
+{
+	size_t n = a.rows(), i, j, k;
+	double diff = 0;
+	for (j = 0; j < n; j++){
+		for (i = 0; i < n; i++){
+			std::complex<double> s = 0;
+			for (k = 0; k < n; k++){
+				s += a.get(i, k)*x.get(k, j);
+			}
+			diff = std::max(diff, std::abs(s - lambda.get(j)*x.get(i, j)));
+		}
+	}
+	return diff;
+}
+
+TEST_CASE( " Test 'eig(const mat& a, cvec& lambda, cmat& x)' " ){
+	SECTION("Test normal conditions."){
+		//		|0 -1|
+		//  a = |1  0| , lambda = [i -i] (rotation)
+		mat a; a = "[0 -1;1 0]";
+		cvec lambda;
+		cmat x;
+		eig(a, lambda, x);
+		REQUIRE( std::abs(lambda[0].real()) < 1e-15 );
+		REQUIRE( std::abs(std::abs(lambda[0].imag()) - 1) < 1e-15 );
+		REQUIRE( lambda[1] == std::conj(lambda[0]) );
+		REQUIRE( eig_residual(a, lambda, x) < 1e-14 );
+
+		// Upper triangular: the eigenvalues are on the diagonal.
+		mat t; t = "[1 2 3;0 4 5;0 0 6]";
+		cvec only = eig(t);
+		double sum = 0, prod = 1;
+		size_t i;
+		for (i = 0; i < 3; i++){
+			REQUIRE( std::abs(only[i].imag()) < 1e-14 );
+			sum += only[i].real();
+			prod *= only[i].real();
+		}
+		REQUIRE( sum == Approx(11) );
+		REQUIRE( prod == Approx(24) );
+	}
+	SECTION("Test large matrices."){
+		size_t n = 120, i;
+		mat a = rand(n, n);
+		cvec lambda;
+		cmat x;
+		eig(a, lambda, x);
+		REQUIRE( eig_residual(a, lambda, x) < 1e-9 );
+
+		// The eigenvalues only variant agrees: compare the sums of the
+		// eigenvalues and of their magnitudes with the trace.
+		cvec only = eig(a);
+		std::complex<double> sum = 0, sum_only = 0;
+		double mag = 0, mag_only = 0, trace = 0;
+		for (i = 0; i < n; i++){
+			sum += lambda[i];
+			sum_only += only[i];
+			mag += std::abs(lambda[i]);
+			mag_only += std::abs(only[i]);
+			trace += a(i, i);
+		}
+		REQUIRE( sum.real() == Approx(trace) );
+		REQUIRE( std::abs(sum.imag()) < 1e-9 );
+		REQUIRE( sum_only.real() == Approx(trace) );
+		REQUIRE( mag_only == Approx(mag) );
+	}
+	SECTION("Test badly scaled and defective matrices."){
+		// Balancing keeps the small eigenvalue accurate.
+		mat a; a = "[1 0 0;0 2 0;0 0 3]";
+		a(0, 1) = 1e6; a(1, 2) = 1e6;
+		a(1, 0) = 1e-6; a(2, 1) = 1e-6;
+		cvec lambda;
+		cmat x;
+		eig(a, lambda, x);
+		REQUIRE( eig_residual(a, lambda, x) < 1e-9 );
+
+		// A Jordan block: a single eigenvalue, repeated.
+		mat j; j = "[2 1;0 2]";
+		cvec jordan = eig(j);
+		REQUIRE( jordan[0].real() == Approx(2) );
+		REQUIRE( jordan[1].real() == Approx(2) );
+	}
+	SECTION("Test boundary conditions."){
+		mat one; one = "[-3]";
+		cvec lambda = eig(one);
+		REQUIRE( lambda[0] == std::complex<double>(-3) );
+		REQUIRE( spectral_radius(one) == 3 );
+
+		// A discrete-time constant velocity model is marginally stable.
+		mat f; f = "[1 0.1;0 1]";
+		REQUIRE( spectral_radius(f) == Approx(1) );
+		mat damped; damped = "[0.9 0.1;-0.1 0.9]";
+		REQUIRE( spectral_radius(damped) < 1 );
+
+		mat empty, rect = rand(2, 3);
+		REQUIRE_THROWS( eig(empty) );
+		REQUIRE_THROWS( spectral_radius(rect) );
+	}
+}
+
+} /* namespace algebra */
@@ -0,0 +1,356 @@
+/*====================================================================================================
+ * Name         : kernels_test.cpp implements a unit-test for the low-level
+ *                kernels (include/kernels) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+#include "../include/test_utils.h"
+
+namespace algebra {
+
+// It counts the elements of a and b that differ by more than tol.
+template <class T>
+size_t count_mismatches(size_t n, const T* a, const T* b, double tol)
+{
+	size_t i, mismatches = 0;
+	for (i = n; i--;)
+	{
+		if ( std::abs(a[i] - b[i]) > tol ) { mismatches++; }
+	}
+	return mismatches;
+}
+
+TEST_CASE( " Test SIMD kernels against the portable loops " ){
+	// Every instruction set supported by this CPU is tested. The lengths
+	// cover empty buffers, pure tails and full vectors plus a tail.
+	const size_t lengths[] = {0, 1, 3, 7, 8, 15, 16, 17, 33, 100, 16000};
+	const simd_isa levels[] = {SIMD_GENERIC, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512};
+	const simd_isa initial = simd_level();
+
+	SECTION("Test normal conditions for 'double'."){
+		size_t mismatches = 0;
+		for (simd_isa level : levels){
+			simd_set_level(level);
+			for (size_t n : lengths){
+				vec a = rand(n, 1).get_col(0), b = rand(n, 1).get_col(0);
+				vec c(n), r(n);
+				simd_add(n, a.data(), b.data(), c.data()); generic_add(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_sub(n, a.data(), b.data(), c.data()); generic_sub(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_mul(n, a.data(), b.data(), c.data()); generic_mul(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_scale(n, a.data(), -1.5, c.data()); generic_scale(n, a.data(), -1.5, r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_abs(n, a.data(), c.data()); generic_abs(n, a.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				if ( std::abs(simd_sum(n, a.data()) - generic_sum(n, a.data())) > 1e-9*(n + 1) ) { mismatches++; }
+				if ( std::abs(simd_dot(n, a.data(), b.data()) - generic_dot(n, a.data(), b.data())) > 1e-9*(n + 1) ) { mismatches++; }
+			}
+		}
+		simd_set_level(initial);
+		REQUIRE( mismatches == 0 );
+	}
+	SECTION("Test normal conditions for 'int'."){
+		size_t mismatches = 0;
+		for (simd_isa level : levels){
+			simd_set_level(level);
+			for (size_t n : lengths){
+				imat m = rand_i(2, n);
+				ivec a = m.get_row(0), b = m.get_row(1);
+				ivec c(n), r(n);
+				simd_add(n, a.data(), b.data(), c.data()); generic_add(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_sub(n, a.data(), b.data(), c.data()); generic_sub(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_mul(n, a.data(), b.data(), c.data()); generic_mul(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_scale(n, a.data(), -3, c.data()); generic_scale(n, a.data(), -3, r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_abs(n, a.data(), c.data()); generic_abs(n, a.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				if ( simd_sum(n, a.data()) != generic_sum(n, a.data()) ) { mismatches++; }
+				if ( simd_dot(n, a.data(), b.data()) != generic_dot(n, a.data(), b.data()) ) { mismatches++; }
+			}
+		}
+		simd_set_level(initial);
+		REQUIRE( mismatches == 0 );
+	}
+	SECTION("Test normal conditions for 'complex'."){
+		size_t mismatches = 0;
+		for (simd_isa level : levels){
+			simd_set_level(level);
+			for (size_t n : lengths){
+				cmat m = rand_c(2, n);
+				cvec a = m.get_row(0), b = m.get_row(1);
+				cvec c(n), r(n);
+				simd_add(n, a.data(), b.data(), c.data()); generic_add(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_sub(n, a.data(), b.data(), c.data()); generic_sub(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				simd_mul(n, a.data(), b.data(), c.data()); generic_mul(n, a.data(), b.data(), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 1e-9);
+				simd_scale(n, a.data(), std::complex<double>(2.5, 0), c.data()); generic_scale(n, a.data(), std::complex<double>(2.5, 0), r.data());
+				mismatches += count_mismatches(n, c.data(), r.data(), 0);
+				if ( std::abs(simd_sum(n, a.data()) - generic_sum(n, a.data())) > 1e-9*(n + 1) ) { mismatches++; }
+				if ( std::abs(simd_dot(n, a.data(), b.data()) - generic_dot(n, a.data(), b.data())) > 1e-9*(n + 1) ) { mismatches++; }
+			}
+		}
+		simd_set_level(initial);
+		REQUIRE( mismatches == 0 );
+	}
+	SECTION("Test boundary conditions."){
+		// The kernels run in place.
+		vec a; a = "[1 -2 3 -4 5 -6 7 -8 9]";
+		simd_abs(a.size(), a.data(), a.data());
+		REQUIRE( sum(a) == 45 );
+		simd_add(a.size(), a.data(), a.data(), a.data());
+		REQUIRE( sum(a) == 90 );
+		REQUIRE( simd_level() == initial );
+	}
+}
+
+TEST_CASE( " Test the thread pool and the parallel kernels " ){
+	const size_t initial = get_num_threads();
+	set_num_threads(4);
+
+	SECTION("Test normal conditions."){
+		// Every index is visited exactly once.
+		std::vector<int> visits(100000, 0);
+		parallel_for(0, visits.size(), 1000, [&](size_t lo, size_t hi){
+			for (size_t i = lo; i < hi; i++) { visits[i]++; }
+		});
+		REQUIRE( std::count(visits.begin(), visits.end(), 1) == (long) visits.size() );
+
+		// Nested loops do not deadlock the pool.
+		std::vector<int> nested(64*1000, 0);
+		parallel_for(0, 64, 1, [&](size_t lo, size_t hi){
+			for (size_t i = lo; i < hi; i++)
+			{
+				parallel_for(0, 1000, 10, [&](size_t l, size_t h){
+					for (size_t j = l; j < h; j++) { nested[i*1000 + j]++; }
+				});
+			}
+		});
+		REQUIRE( std::count(nested.begin(), nested.end(), 1) == (long) nested.size() );
+
+		// The kernels give the same results on 1 and on 4 threads.
+		mat a = rand(300, 300), b = rand(300, 300);
+		mat c4 = a*b, t4 = transpose(a), s4 = a + b*2.0, i4 = inv(a), st4 = strassen(a, b);
+		mat e = eye(200) + rand(200, 200)*0.01;
+		double d4 = determinant(e);
+		vec v = a.get_col(0), av4 = a*v;
+		set_num_threads(1);
+		mat c1 = a*b, t1 = transpose(a), s1 = a + b*2.0, i1 = inv(a), st1 = strassen(a, b);
+		double d1 = determinant(e);
+		vec av1 = a*v;
+		set_num_threads(4);
+		REQUIRE( max_abs_diff(c4, c1) < 1e-12 );
+		REQUIRE( max_abs_diff(t4, t1) == 0 );
+		REQUIRE( max_abs_diff(s4, s1) == 0 );
+		REQUIRE( max_abs_diff(i4, i1) < 1e-9 );
+		REQUIRE( max_abs_diff(st4, st1) < 1e-9 );
+		REQUIRE( std::abs(d4 - d1) <= 1e-9*std::abs(d1) );
+		REQUIRE( max_abs_diff(av4, av1) < 1e-12 );
+	}
+	SECTION("Test complex values."){
+		cmat a = rand_c(200, 150), b = rand_c(150, 250);
+		cmat c4 = a*b;
+		set_num_threads(1);
+		cmat c1 = a*b;
+		set_num_threads(4);
+		REQUIRE( max_abs_diff(c4, c1) < 1e-12 );
+	}
+	SECTION("Test boundary conditions."){
+		// Exceptions are passed on to the caller.
+		REQUIRE_THROWS( parallel_for(0, 100, 1, [](size_t lo, size_t){
+			if (lo > 50) { throw std::runtime_error("task failed"); }
+		}) );
+		// Empty ranges do nothing.
+		size_t calls = 0;
+		parallel_for(5, 5, 1, [&](size_t, size_t){ calls++; });
+		REQUIRE( calls == 0 );
+		set_num_threads(0);
+		REQUIRE( get_num_threads() == 1 );
+	}
+	set_num_threads(initial);
+}
+
+// It counts the buffers it hands out.
+class counting_resource : public memory_resource {
+public:
+	void* allocate(size_t bytes, size_t alignment) override
+	{
+		allocations++;
+		live++;
+		return heap_memory_resource()->allocate(bytes, alignment);
+	}
+	void deallocate(void* p, size_t bytes, size_t alignment) noexcept override
+	{
+		live--;
+		heap_memory_resource()->deallocate(p, bytes, alignment);
+	}
+	size_t allocations = 0;
+	long live = 0;
+};
+
+TEST_CASE( " Test the memory resources and the workspace " ){
+	SECTION("Test the memory resources."){
+		counting_resource counter;
+		memory_resource* previous = set_default_resource(&counter);
+		{
+			mat a = ones(10, 10);
+			vec v(100);
+			REQUIRE( counter.allocations == 2 );
+			set_default_resource(previous);
+			// Buffers go back to the resource they came from.
+			mat b = ones(10, 10);
+			b = std::move(a);
+			REQUIRE( counter.live == 2 );
+			REQUIRE( b(9, 9) == 1 );
+		}
+		REQUIRE( counter.live == 0 );
+		REQUIRE( get_default_resource() == previous );
+
+		// Large buffers are aligned to a huge page.
+		huge_page_resource huge;
+		void* p = huge.allocate(3*HUGE_PAGE_SIZE, MEMORY_ALIGNMENT);
+		REQUIRE( reinterpret_cast<uintptr_t>(p) % HUGE_PAGE_SIZE == 0 );
+		huge.deallocate(p, 3*HUGE_PAGE_SIZE, MEMORY_ALIGNMENT);
+		p = huge.allocate(100, MEMORY_ALIGNMENT);
+		REQUIRE( reinterpret_cast<uintptr_t>(p) % MEMORY_ALIGNMENT == 0 );
+		huge.deallocate(p, 100, MEMORY_ALIGNMENT);
+	}
+	SECTION("Test the workspace."){
+		counting_resource counter;
+		workspace ws(&counter);
+		char* a = static_cast<char*>(ws.allocate(100));
+		char* b = static_cast<char*>(ws.allocate(1000));
+		REQUIRE( reinterpret_cast<uintptr_t>(a) % MEMORY_ALIGNMENT == 0 );
+		REQUIRE( reinterpret_cast<uintptr_t>(b) % MEMORY_ALIGNMENT == 0 );
+		REQUIRE( b - a == 128 );
+		REQUIRE( counter.allocations == 1 );
+		// Released out of order, the space is reclaimed with the last one.
+		ws.deallocate(a);
+		REQUIRE( ws.in_use() == 1024 );
+		char* c = static_cast<char*>(ws.allocate(64));
+		REQUIRE( c == b + 1024 );
+		ws.deallocate(c);
+		ws.deallocate(b);
+		REQUIRE( ws.in_use() == 0 );
+		REQUIRE( ws.allocate(10) == a );
+		ws.deallocate(a);
+
+		// A region that overflows is followed by a larger one; they are
+		// merged once the workspace is empty.
+		void* big1 = ws.allocate(WORKSPACE_MIN_CHUNK);
+		void* big2 = ws.allocate(WORKSPACE_MIN_CHUNK);
+		REQUIRE( ws.regions() == 2 );
+		ws.deallocate(big2);
+		ws.deallocate(big1);
+		REQUIRE( ws.regions() == 1 );
+		REQUIRE( ws.capacity() >= 2*WORKSPACE_MIN_CHUNK );
+		const size_t allocations = counter.allocations;
+		big1 = ws.allocate(WORKSPACE_MIN_CHUNK);
+		big2 = ws.allocate(WORKSPACE_MIN_CHUNK);
+		ws.deallocate(big2);
+		ws.deallocate(big1);
+		REQUIRE( counter.allocations == allocations );
+		ws.trim();
+		REQUIRE( ws.capacity() == 0 );
+		REQUIRE( counter.live == 0 );
+	}
+	SECTION("Test the workspace of the kernels."){
+		const size_t initial = get_num_threads();
+		set_num_threads(1);
+		mat a = rand(200, 200), b = rand(200, 200), c;
+		{
+			workspace_scope scope(8 << 20);
+			REQUIRE( thread_workspace().capacity() >= (8 << 20) );
+			c = a*b;
+			c = inv(a);
+			c = strassen(a, b);
+			REQUIRE( thread_workspace().in_use() == 0 );
+			REQUIRE( thread_workspace().regions() == 1 );
+		}
+		REQUIRE( thread_workspace().capacity() == 0 );
+		set_num_threads(initial);
+	}
+}
+
+// It returns the lines of file that contain text.
+static size_t count_lines(const char* file, const char* text)
+{
+	size_t n = 0;
+	char line[1024];
+	if (FILE* f = fopen(file, "r"))
+	{
+		while (fgets(line, sizeof(line), f))
+		{
+			n += (strstr(line, text) != NULL);
+		}
+		fclose(f);
+	}
+	return n;
+}
+
+TEST_CASE( " Test the logging backend " ){
+	const size_t initial = get_num_threads();
+	set_num_threads(4);
+	// Start in a fresh rate-limit window.
+	std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+	clear_file(LOG_FILE);
+
+	SECTION("Test normal conditions."){
+		log("first message");
+		LOG_INFO(std::string("second ") + "message");
+		log_flush();
+		REQUIRE( count_lines(LOG_FILE, "message") == 2 );
+		REQUIRE( count_lines(LOG_FILE, "]first message") == 1 );
+
+		// Below the run-time level nothing is written.
+		set_log_level(LOG_LEVEL_ERROR);
+		log("filtered message");
+		set_log_level(LOG_LEVEL_INFO);
+		log_flush();
+		REQUIRE( count_lines(LOG_FILE, "filtered") == 0 );
+	}
+	SECTION("Test the rate limit from several threads."){
+		const size_t n = 4*LOG_RATE_LIMIT;
+		parallel_for(0, n, 1, [](size_t lo, size_t hi){
+			for (size_t i = lo; i < hi; i++) { log("burst"); }
+		});
+		log_flush();
+		const size_t written = count_lines(LOG_FILE, "burst");
+		REQUIRE( written >= LOG_RATE_LIMIT );
+		REQUIRE( written < n );
+		REQUIRE( count_lines(LOG_FILE, "messages dropped") >= 1 );
+	}
+	clear_file(LOG_FILE);
+	set_num_threads(initial);
+}
+
+} /* namespace algebra */
@@ -0,0 +1,197 @@
+/*====================================================================================================
+ * Name         : lu_test.cpp implements a unit-test for the LU factorization
+ *                (include/lu.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+
+namespace algebra {
+
+TEST_CASE( " Test 'LU<T>' factorization " ){
+	SECTION("Test normal conditions."){
+		mat a; a = "[1 2 0 -8 1;-2 3 4 0 -7;0 0 9 8 0;0 2 17 32 -4;44 0 -5 0 -6]";
+		LU<double> lu(a);
+		REQUIRE( lu.size() == 5 );
+		REQUIRE( lu.is_singular() == false );
+		// P*A = L*U
+		mat lhs = lu.P()*a, rhs = lu.L()*lu.U();
+		size_t i, j;
+		for(i = 5; i--;){
+			for(j = 5; j--;){
+				REQUIRE( lhs(i, j) == Approx(rhs(i, j)) );
+				if (j > i) { REQUIRE( lu.L()(i, j) == 0 ); }
+				if (j < i) { REQUIRE( lu.U()(i, j) == 0 ); }
+			}
+		}
+		// The inverse is the one of inv().
+		mat a_inv = lu.inverse(), ref = inv(a);
+		for(i = 5; i--;){
+			for(j = 5; j--;){
+				REQUIRE( a_inv(i, j) == Approx(ref(i, j)) );
+			}
+		}
+		// The determinant reuses the factors.
+		double sign;
+		REQUIRE( lu.determinant() == Approx(determinant(a)) );
+		REQUIRE( lu.log_determinant(sign) == Approx(std::log(std::abs(determinant(a)))) );
+		REQUIRE( sign*std::exp(lu.log_determinant(sign)) == Approx(lu.determinant()) );
+	}
+	SECTION("Test large matrices (several blocked panels)."){
+		// 300 > LU_BLOCK_SIZE, so panels, triangular solves and
+		// trailing updates are all exercised.
+		size_t n = 300, i, j;
+		mat a = rand(n, n) + eye(n);
+		LU<double> lu(a);
+		mat diff = lu.P()*a - lu.L()*lu.U();
+		double err = 0;
+		for(i = n; i--;){
+			for(j = n; j--;){
+				err = std::max(err, std::abs(diff(i, j)));
+			}
+		}
+		REQUIRE( err < 1e-10 );
+
+		mat confirm = a*inv(a);
+		err = 0;
+		for(i = n; i--;){
+			for(j = n; j--;){
+				err = std::max(err, std::abs(confirm(i, j) - (i == j ? 1.0 : 0.0)));
+			}
+		}
+		REQUIRE( err < 1e-9 );
+
+		// Factorizing an rvalue reuses its buffer.
+		LU<double> moved(std::move(a));
+		REQUIRE( moved.size() == n );
+		REQUIRE( moved.pivot().get(n) == lu.pivot().get(n) );
+	}
+	SECTION("Test complex values."){
+		cmat m1(2,2);
+		m1(0,0) = 0.-1i; m1(0,1) = 1.+0i;
+		m1(1,0) = 2.+0i; m1(1,1) = 0.+0i;
+		LU<std::complex<double>> lu(m1);
+		cmat test = m1*lu.inverse();
+		REQUIRE( test(0,0).real() == Approx(1) ); REQUIRE( test(0,0).imag() == Approx(0) );
+		REQUIRE( test(0,1).real() == Approx(0) ); REQUIRE( test(0,1).imag() == Approx(0) );
+		REQUIRE( test(1,0).real() == Approx(0) ); REQUIRE( test(1,0).imag() == Approx(0) );
+		REQUIRE( test(1,1).real() == Approx(1) ); REQUIRE( test(1,1).imag() == Approx(0) );
+	}
+	SECTION("Test boundary conditions."){
+		mat m;
+		REQUIRE_THROWS( LU<double>(m) );
+		m = "[7 2 1;0 3 -1]"; // non-square
+		REQUIRE_THROWS( LU<double>(m) );
+		LU<double> empty;
+		REQUIRE_THROWS( empty.inverse() );
+		REQUIRE_THROWS( empty.determinant() );
+		// Singular matrix: the inverse is NaN and a warning is logged.
+		m = "[1 0 0;-2 0 0;4 6 1]";
+		LU<double> lu(m);
+		REQUIRE( lu.is_singular() == true );
+		mat m_inv = lu.inverse();
+		REQUIRE( isnan(m_inv(0,0)) == 1 );
+		REQUIRE( lu.determinant() == 0 );
+	}
+}
+
+TEST_CASE( " Test 'solve(const mat& a, const vec& b)' and 'solve(const mat& a, const mat& b)' " ){
+	SECTION("Test normal conditions."){
+		//		|7  2  1|		 |24|			 |2|
+		//  a = |0  3 -1| ,  b = | 5| ==>  x =  |3|
+		//		|-3 4 -2|		 |-2|			 |4|
+		mat a; a = "[7 2 1;0 3 -1;-3 4 -2]";
+		vec b; b = "[24 5 -2]";
+		vec x = solve(a, b);
+		REQUIRE( x.size() == 3 );
+		REQUIRE( x[0] == Approx(2) );
+		REQUIRE( x[1] == Approx(3) );
+		REQUIRE( x[2] == Approx(4) );
+
+		// Every column of B is solved for.
+		mat bb; bb = "[24 7;5 0;-2 -3]";
+		mat xx = solve(a, bb);
+		REQUIRE( xx.rows() == 3 );
+		REQUIRE( xx.cols() == 2 );
+		REQUIRE( xx(0,0) == Approx(2) ); REQUIRE( xx(0,1) == Approx(1) );
+		REQUIRE( xx(1,0) == Approx(3) ); REQUIRE( xx(1,1) + 1 == Approx(1) );
+		REQUIRE( xx(2,0) == Approx(4) ); REQUIRE( xx(2,1) + 1 == Approx(1) );
+
+		// Matrix expressions are accepted as well.
+		mat half = a*0.5;
+		vec y = solve(half + half, b);
+		REQUIRE( y[2] == Approx(4) );
+	}
+	SECTION("Test large systems and reused factorizations."){
+		size_t n = 250, i, j;
+		mat a = rand(n, n) + eye(n)*double(n);
+		mat b = rand(n, 40);
+		mat x = solve(a, b), r = a*x - b;
+		double err = 0;
+		for(i = n; i--;){
+			for(j = 40; j--;){
+				err = std::max(err, std::abs(r(i, j)));
+			}
+		}
+		REQUIRE( err < 1e-10 );
+
+		LU<double> lu(a);
+		for(j = 40; j--;){
+			vec xj = lu.solve(b.get_col(j));
+			vec rj = a*xj - b.get_col(j);
+			REQUIRE( max(abs(rj)) < 1e-10 );
+		}
+	}
+	SECTION("Test complex values."){
+		// |-i 1| x = |1|  ==>  x = | 0.5 |
+		// | 2 0|     |1|           |1+0.5i|
+		cmat a(2,2);
+		a(0,0) = 0.-1i; a(0,1) = 1.+0i;
+		a(1,0) = 2.+0i; a(1,1) = 0.+0i;
+		cvec b(2);
+		b[0] = 1.+0i; b[1] = 1.+0i;
+		cvec x = solve(a, b);
+		REQUIRE( x[0].real() == Approx(0.5) ); REQUIRE( x[0].imag() + 1 == Approx(1) );
+		REQUIRE( x[1].real() == Approx(1) ); REQUIRE( x[1].imag() == Approx(0.5) );
+	}
+	SECTION("Test boundary conditions."){
+		mat a; a = "[7 2 1;0 3 -1]"; // non-square
+		vec b; b = "[1 2]";
+		REQUIRE_THROWS( solve(a, b) );
+		a = "[7 2;0 3]";
+		b = "[1 2 3]"; // dimension mismatch
+		REQUIRE_THROWS( solve(a, b) );
+		LU<double> empty;
+		REQUIRE_THROWS( empty.solve(b) );
+		// Singular matrix: the solution is NaN and a warning is logged.
+		a = "[1 0 0;-2 0 0;4 6 1]";
+		b = "[1 2 3]";
+		vec x = solve(a, b);
+		REQUIRE( isnan(x[0]) == 1 );
+	}
+}
+
+} /* namespace algebra */
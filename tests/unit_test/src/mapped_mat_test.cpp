@@ -0,0 +1,188 @@
+/*====================================================================================================
+ * Name         : mapped_mat_test.cpp implements a unit-test for the memory-mapped
+ *                matrix MappedMat (include/mapped_mat.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+#include "../include/test_utils.h"
+
+#include <cstdio>       // std::remove, fopen
+#include <cstddef>      // offsetof
+
+
+namespace algebra {
+
+#define MAPPED_TEST_A "/tmp/LinearAlgebra_mapped_a.bin"
+#define MAPPED_TEST_B "/tmp/LinearAlgebra_mapped_b.bin"
+#define MAPPED_TEST_C "/tmp/LinearAlgebra_mapped_c.bin"
+
+TEST_CASE( " Test 'mapped_mat' storage " ){
+	SECTION("Test creating, writing and reopening a file."){
+		{
+			mapped_mat a(MAPPED_TEST_A, 10, 7, 4);
+			REQUIRE( a.rows() == 10 );
+			REQUIRE( a.cols() == 7 );
+			REQUIRE( a.row_tiles() == 3 );
+			REQUIRE( a.col_tiles() == 2 );
+			REQUIRE( a(9, 6) == 0 );
+			a.set(9, 6, 2.5);
+			a.set(0, 5, -1.0);
+			a.tile(1, 1)(0, 1) = 4.0;   // element (4, 5)
+			a.flush();
+		}
+		mapped_mat a(MAPPED_TEST_A);
+		REQUIRE( a.rows() == 10 );
+		REQUIRE( a.cols() == 7 );
+		REQUIRE( a.tile() == 4 );
+		REQUIRE( a(9, 6) == 2.5 );
+		REQUIRE( a(0, 5) == -1.0 );
+		REQUIRE( a(4, 5) == 4.0 );
+		REQUIRE( a.ctile(2, 1).rows() == 2 );
+		REQUIRE( a.ctile(2, 1).cols() == 3 );
+		REQUIRE_THROWS_AS( a(10, 0), const std::out_of_range& );
+		REQUIRE_THROWS_AS( a.tile(0, 2), const std::out_of_range& );
+	}
+	SECTION("Test the conversions to and from mat."){
+		mat m = rand(37, 53);
+		mapped_mat a(MAPPED_TEST_A, 37, 53, 16);
+		a.copy_from(m);
+		REQUIRE( max_abs_diff(a.to_mat(), m) == 0 );
+		REQUIRE( a(36, 52) == m(36, 52) );
+		a.fill(3.0);
+		REQUIRE( a(20, 40) == 3.0 );
+		REQUIRE_THROWS_AS( a.copy_from(rand(37, 52)), const std::invalid_argument& );
+	}
+	SECTION("Test opening files that do not match."){
+		{
+			mapped_mat a(MAPPED_TEST_A, 5, 5, 2);
+		}
+		REQUIRE_THROWS_AS( MappedMat<int>(MAPPED_TEST_A), const std::invalid_argument& );
+		REQUIRE_THROWS_AS( mapped_mat("/tmp/LinearAlgebra_no_such_dir/a.bin"), const std::runtime_error& );
+		REQUIRE_THROWS_AS( mapped_mat(MAPPED_TEST_A, 5, 5, 0), const std::invalid_argument& );
+		mapped_mat r(MAPPED_TEST_A, false);
+		REQUIRE( !r.writable() );
+		REQUIRE_THROWS_AS( r.tile(0, 0), const std::logic_error& );
+		REQUIRE_THROWS_AS( r.set(2, 2, 1.0), const std::logic_error& );
+		REQUIRE_THROWS_AS( r.fill(1.0), const std::logic_error& );
+		REQUIRE( r(2, 2) == 0 );
+		REQUIRE( r.ctile(1, 1)(0, 0) == 0 );
+		REQUIRE( r.ctile(2, 2).rows() == 1 );
+		REQUIRE_THROWS_AS( r.ctile(3, 0), const std::out_of_range& );
+	}
+	SECTION("Test opening a file whose header does not fit in memory."){
+		{
+			mapped_mat a(MAPPED_TEST_A, 5, 5, 2);
+		}
+		// A header of 2^32 x 2^32 elements, whose size wraps around.
+		const uint64_t big = (uint64_t) 1 << 32;
+		FILE* f = fopen(MAPPED_TEST_A, "r+b");
+		REQUIRE( f != nullptr );
+		fseek(f, offsetof(mapped_header, rows), SEEK_SET);
+		fwrite(&big, sizeof(big), 1, f);
+		fwrite(&big, sizeof(big), 1, f);
+		fclose(f);
+		REQUIRE_THROWS_AS( mapped_mat(MAPPED_TEST_A), const std::invalid_argument& );
+		REQUIRE_THROWS_AS( mapped_mat(MAPPED_TEST_A, false), const std::invalid_argument& );
+	}
+	SECTION("Test that the tile cache stays within its size."){
+		mapped_mat a(MAPPED_TEST_A, 64, 64, 8);
+		a.set_cache_size(5*8*8*sizeof(double));
+		a.fill(1.0);
+		REQUIRE( a.cached_tiles() == 5 );
+		REQUIRE( a.cache_size() == 5*8*8*sizeof(double) );
+		a.set_cache_size(0);
+		REQUIRE( a.cached_tiles() == 4 );
+		// The dropped tiles are read back from the file.
+		REQUIRE( a(0, 0) == 1.0 );
+		REQUIRE( a.to_mat()(63, 63) == 1.0 );
+	}
+	SECTION("Test a moved-from file."){
+		mapped_mat a(MAPPED_TEST_A, 16, 16, 8);
+		a.fill(2.0);
+		mapped_mat b(std::move(a));
+		REQUIRE( b(15, 15) == 2.0 );
+		REQUIRE( b.cached_tiles() == 4 );
+		REQUIRE( a.rows() == 0 );
+		REQUIRE( a.cache_size() == 0 );
+		REQUIRE( a.cached_tiles() == 0 );
+		a.set_cache_size(0);
+		REQUIRE( a.cached_tiles() == 0 );
+		REQUIRE_THROWS_AS( a.tile(0, 0), const std::out_of_range& );
+		a = std::move(b);
+		REQUIRE( a(0, 0) == 2.0 );
+		REQUIRE( b.cached_tiles() == 0 );
+	}
+	std::remove(MAPPED_TEST_A);
+}
+
+TEST_CASE( " Test the tiled operations of 'mapped_mat' " ){
+	SECTION("Test multiply(a, b, c)."){
+		mat ma = rand(35, 47), mb = rand(47, 29);
+		mapped_mat a(MAPPED_TEST_A, 35, 47, 8), b(MAPPED_TEST_B, 47, 29, 8), c(MAPPED_TEST_C, 35, 29, 8);
+		a.copy_from(ma);
+		b.copy_from(mb);
+		c.fill(7.0);
+		a.set_cache_size(0);
+		multiply(a, b, c);
+		mat mc = ma*mb;
+		REQUIRE( max_abs_diff(c.to_mat(), mc) < 1e-12 );
+		REQUIRE_THROWS_AS( multiply(b, a, c), const std::invalid_argument& );
+		REQUIRE_THROWS_AS( multiply(a, b, a), const std::invalid_argument& );
+		mapped_mat d(MAPPED_TEST_C, 35, 29, 4);
+		REQUIRE_THROWS_AS( multiply(a, b, d), const std::invalid_argument& );
+	}
+	SECTION("Test transpose(a, at)."){
+		mat ma = rand(21, 34);
+		mapped_mat a(MAPPED_TEST_A, 21, 34, 8), at(MAPPED_TEST_B, 34, 21, 8);
+		a.copy_from(ma);
+		transpose(a, at);
+		REQUIRE( max_abs_diff(at.to_mat(), mat(transpose(ma))) == 0 );
+		REQUIRE_THROWS_AS( transpose(a, a), const std::invalid_argument& );
+	}
+	SECTION("Test add, subtract and scale."){
+		mat ma = rand(19, 26), mb = rand(19, 26);
+		mapped_mat a(MAPPED_TEST_A, 19, 26, 8), b(MAPPED_TEST_B, 19, 26, 8), c(MAPPED_TEST_C, 19, 26, 8);
+		a.copy_from(ma);
+		b.copy_from(mb);
+		add(a, b, c);
+		REQUIRE( max_abs_diff(c.to_mat(), mat(ma + mb)) == 0 );
+		subtract(a, b, c);
+		REQUIRE( max_abs_diff(c.to_mat(), mat(ma - mb)) == 0 );
+		scale(a, 2.0, c);
+		REQUIRE( max_abs_diff(c.to_mat(), mat(ma*2.0)) == 0 );
+		// In place
+		add(a, b, a);
+		REQUIRE( max_abs_diff(a.to_mat(), mat(ma + mb)) == 0 );
+		mapped_mat d(MAPPED_TEST_C, 19, 25, 8);
+		REQUIRE_THROWS_AS( add(a, b, d), const std::invalid_argument& );
+	}
+	std::remove(MAPPED_TEST_A);
+	std::remove(MAPPED_TEST_B);
+	std::remove(MAPPED_TEST_C);
+}
+
+} /* namespace algebra */
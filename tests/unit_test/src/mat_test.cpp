@@ -59,7 +59,30 @@ TEST_CASE( " Test mat constructor." ){
 		REQUIRE(m.size() == 4);
 	}
 	SECTION(" Test boundary conditions."){
-		REQUIRE_THROWS(mat(MAX_ACCEPTABLE_VECTOR_SIZE + 1, MAX_ACCEPTABLE_VECTOR_SIZE + 1));
+		REQUIRE_THROWS(mat(physical_memory(), physical_memory()));
+	}
+}
+
+TEST_CASE( " Test 'mat::data()' and 'mat::ld()' functions." ){
+	SECTION(" Test for normal conditions"){
+		// Elements are stored row after row in one contiguous buffer.
+		//     |1 2 3|
+		// m = |4 5 6| ==> data = [1 2 3 4 5 6], ld = 3
+		mat m; m = "[1 2 3;4 5 6]";
+		REQUIRE( m.ld() == 3 );
+		const double* data = m.data();
+		for(size_t i = 0; i < m.rows(); i++){
+			for(size_t j = 0; j < m.cols(); j++){
+				REQUIRE( data[i*m.ld() + j] == m.get(i,j) );
+			}
+		}
+		m.data()[4] = 55;
+		REQUIRE( m(1,1) == 55 );
+	}
+	SECTION(" Test for boundary conditions."){
+		mat m;
+		REQUIRE( m.ld() == 0 );
+		REQUIRE( m.size_in_memory() == 0 );
 	}
 }
 
@@ -76,7 +99,7 @@ TEST_CASE( " Test 'mat::set_size(size_t r, size_t c)' function." ){
 		REQUIRE(m.rows() == 0);
 		REQUIRE(m.cols() == 0);
 		REQUIRE(m.size() == 0);
-		REQUIRE_THROWS( m.set_size(MAX_ACCEPTABLE_VECTOR_SIZE + 1, MAX_ACCEPTABLE_VECTOR_SIZE) );
+		REQUIRE_THROWS( m.set_size(1 << 20, 1 << 20) );
 		REQUIRE_THROWS( m.set_size(4, -5) );
 	}
 }
@@ -328,6 +351,16 @@ TEST_CASE( " Test 'mat::set_submatrix(size_t r0, size_t c0, const mat& m)' funct
 		REQUIRE(m.get(0,0) == 1); REQUIRE(m.get(0,1) == 2); REQUIRE(m.get(0,2) == 0);
 		REQUIRE(m.get(1,0) == 3); REQUIRE(m.get(1,1) == 4); REQUIRE(m.get(1,2) == 0);
 		REQUIRE(m.get(2,0) == 0); REQUIRE(m.get(2,1) == 0); REQUIRE(m.get(2,2) == 0);
+
+		// Example 3:
+		//     |0 0 0|      |1 2|							        |0 0 0|
+		// m = |0 0 0|, k = |3 4|, m.set_submatrix(1, 0, k) =>  m = |1 2 0|
+		//     |0 0 0|		    						            |3 4 0|
+		m.set_size(3,3);
+		m.set_submatrix(1, 0,  k);
+		REQUIRE(m.get(0,0) == 0); REQUIRE(m.get(0,1) == 0); REQUIRE(m.get(0,2) == 0);
+		REQUIRE(m.get(1,0) == 1); REQUIRE(m.get(1,1) == 2); REQUIRE(m.get(1,2) == 0);
+		REQUIRE(m.get(2,0) == 3); REQUIRE(m.get(2,1) == 4); REQUIRE(m.get(2,2) == 0);
 	}
 	SECTION(" Test for normal conditions for complex matrices"){
 		cmat m1(3,3), m2(2,2);
@@ -776,6 +809,43 @@ TEST_CASE( " Test 'mat::operator=(const char* a)' " ){
 		// m = [1 2 3;4 5]	=	exception
 		REQUIRE_THROWS( m = "[1 2 3;4 5]" );
 	}
+	SECTION("Test separators, exponents and error positions."){
+		m = "1, -2.5; 3e2, 4";
+		REQUIRE(m.rows() == 2); REQUIRE(m.cols() == 2);
+		REQUIRE(m(0,1) == Approx(-2.5)); REQUIRE(m(1,0) == Approx(300));
+		imat k; k = "[1 -2;3 4]";
+		REQUIRE(k(0,1) == -2);
+		m = "[;]";
+		REQUIRE(m.size() == 0);
+
+		// An invalid input leaves the matrix unchanged.
+		m = "[7]";
+		REQUIRE_THROWS_AS(m = "[1 2;3]", const std::out_of_range&);
+		REQUIRE_THROWS_AS(m = "[1 2;3 4;]", const std::out_of_range&);
+		REQUIRE_THROWS_AS(m = "[1 2;3 a]", const std::invalid_argument&);
+		REQUIRE(m.size() == 1);
+		try {
+			m = "[1 2;3 4 5]";
+			FAIL("no exception was thrown");
+		}
+		catch (const std::out_of_range& e) {
+			REQUIRE(std::string(e.what()).find("row 2 has 3 elements instead of 2 at position 10") != std::string::npos);
+		}
+	}
+	SECTION("Test a large input."){
+		std::string text;
+		size_t i, j;
+		for (i = 0; i < 300; i++){
+			for (j = 0; j < 300; j++){
+				text += std::to_string((i + j) % 7) + " ";
+			}
+			text += ";";
+		}
+		text.pop_back();
+		m = text.c_str();
+		REQUIRE(m.rows() == 300); REQUIRE(m.cols() == 300);
+		REQUIRE(m(299, 298) == (299 + 298) % 7);
+	}
 }
 
 
@@ -838,6 +908,90 @@ TEST_CASE( " Test 'mat::operator()(size_t r1, size_t r2, size_t c1, size_t c2)'
 	}
 }
 
+TEST_CASE( " Test 'mat::view', 'mat::row_view' and 'mat::col_view' " ){
+	mat m, p;
+	SECTION("Test normal conditions"){
+		//		|1 2 3|
+		//   m =|4 5 6| , m.view(1, 2, 1, 2) = |5 6|
+		//		|7 8 9|                        |8 9|
+		m = "[1 2 3;4 5 6;7 8 9]";
+		p = m.view(1, 2, 1, 2);
+		REQUIRE( p.rows() == 2 ); REQUIRE( p.cols() == 2 );
+		REQUIRE(p(0,0) == 5); REQUIRE(p(0,1) == 6);
+		REQUIRE(p(1,0) == 8); REQUIRE(p(1,1) == 9);
+
+		// Writing through the view writes the matrix
+		m(0, 1, 0, 1) = m.view(1, 2, 1, 2)*2.0;
+		REQUIRE(m(0,0) == 10); REQUIRE(m(0,1) == 12);
+		REQUIRE(m(1,0) == 16); REQUIRE(m(1,1) == 18);
+		REQUIRE(m(0,2) == 3); REQUIRE(m(2,2) == 9);
+
+		// Rows and columns
+		m = "[1 2 3;4 5 6;7 8 9]";
+		vec c = m.col_view(1);
+		REQUIRE( c.size() == 3 );
+		REQUIRE(c(0) == 2); REQUIRE(c(1) == 5); REQUIRE(c(2) == 8);
+		m.row_view(2) *= 2.0;
+		REQUIRE(m(2,0) == 14); REQUIRE(m(2,1) == 16); REQUIRE(m(2,2) == 18);
+		m.col_view(0) = m.col_view(2);
+		REQUIRE(m(0,0) == 3); REQUIRE(m(1,0) == 6); REQUIRE(m(2,0) == 18);
+		REQUIRE( m.row_view(0)*m.col_view(1) == 3*2 + 2*5 + 3*16 );
+		p = m.rows_view(1, 2) - m.rows_view(0, 1);
+		REQUIRE( p.rows() == 2 );
+		REQUIRE(p(0,0) == 3); REQUIRE(p(1,2) == 12);
+		p = m.cols_view(2, 2);
+		REQUIRE( p.cols() == 1 ); REQUIRE(p(1,0) == 6);
+
+		// A view that overlaps the block it is assigned to
+		m = "[1 2 3;4 5 6;7 8 9]";
+		m.view(1, 2, 0, 2) = m.view(0, 1, 0, 2);
+		REQUIRE(m(1,0) == 1); REQUIRE(m(2,2) == 6);
+		m = "[1 2 3;4 5 6;7 8 9]";
+		m = m.view(0, 1, 1, 2);
+		REQUIRE( m.rows() == 2 ); REQUIRE( m.cols() == 2 );
+		REQUIRE(m(0,0) == 2); REQUIRE(m(1,1) == 6);
+	}
+	SECTION("Test products of views"){
+		mat a(40, 50), b(60, 30), r1, r2;
+		for (size_t i = 0; i < a.rows(); i++)
+			for (size_t j = 0; j < a.cols(); j++)
+				a(i,j) = double(i) - 2.0*double(j);
+		for (size_t i = 0; i < b.rows(); i++)
+			for (size_t j = 0; j < b.cols(); j++)
+				b(i,j) = double(i*j % 7) - 3.0;
+		// A 10x20 block of a times a 20x15 block of b, read in place
+		r1 = a.view(5, 14, 10, 29)*b.view(30, 49, 3, 17);
+		r2 = a.get(5, 14, 10, 29)*b.get(30, 49, 3, 17);
+		REQUIRE( r1.rows() == 10 ); REQUIRE( r1.cols() == 15 );
+		for (size_t i = 0; i < r1.rows(); i++)
+			for (size_t j = 0; j < r1.cols(); j++)
+				REQUIRE( r1(i,j) == r2(i,j) );
+		r1 = transpose(a.view(0, 19, 0, 9))*b.view(0, 19, 0, 9);
+		r2 = transpose(a.get(0, 19, 0, 9))*b.get(0, 19, 0, 9);
+		for (size_t i = 0; i < r1.rows(); i++)
+			for (size_t j = 0; j < r1.cols(); j++)
+				REQUIRE( r1(i,j) == r2(i,j) );
+		// Matrix-vector product with a strided column
+		vec y1 = a.view(0, 39, 0, 29)*b.view(0, 29, 4, 4).col_view(0);
+		vec y2 = a.get_cols(0, 29)*b.get_col(4).get(0, 29);
+		REQUIRE( y1.size() == 40 );
+		for (size_t i = 0; i < y1.size(); i++)
+			REQUIRE( y1(i) == y2(i) );
+	}
+	SECTION("Test boundary conditions."){
+		REQUIRE_THROWS( m.view(0, 0, 0, 0) ); // NULL MATRIX
+		m = "[1 2 3;4 5 6]";
+		const mat& cm = m;
+		REQUIRE_THROWS( cm.view(0, 2, 0, 0) );
+		REQUIRE_THROWS( m.view(1, 0, 0, 0) ); // r2 < r1
+		REQUIRE_THROWS( m.row_view(2) );
+		REQUIRE_THROWS( m.col_view(3) );
+		REQUIRE_THROWS( m.view(0, 1, 0, 1) = m.view(0, 0, 0, 2) ); // dimension mismatch
+		REQUIRE_THROWS( m.view(0, 1, 0, 1)(2, 0) );
+		REQUIRE( cm.view(1, 1, 2, 2)(0, 0) == 6 );
+	}
+}
+
 TEST_CASE( " Test 'mat::operator+(const mat& m)' " ){
 	mat m,p,b;
 	SECTION("Test normal conditions"){
@@ -1041,6 +1195,37 @@ TEST_CASE( " Test 'mat::operator*(const mat& m)' " ){
 		REQUIRE( m2(1,0).real() == 34 ); REQUIRE( m2(1,0).imag() == 28 );
 		REQUIRE( m2(1,1).real() == -40 ); REQUIRE( m2(1,1).imag() == -30 );
 	}
+	SECTION(" Test for large matrices (blocked kernel)"){
+		// The sizes are not multiples of the register or cache blocks,
+		// so the edge tiles of the packed kernel are exercised as well.
+		// Every element is checked against the inner product of the
+		// corresponding row and column.
+		size_t i, j, mismatches = 0;
+		imat a1 = rand_i(131, 267), a2 = rand_i(267, 203), a3 = a1 * a2;
+		REQUIRE( a3.rows() == 131 ); REQUIRE( a3.cols() == 203 );
+		for(i = a3.rows(); i--;){
+			for(j = a3.cols(); j--;){
+				if( a3(i,j) != dot(a1.get_row(i), a2.get_col(j)) ){ mismatches++; }
+			}
+		}
+		REQUIRE( mismatches == 0 );
+
+		m = rand(97, 300); p = rand(300, 61); b = m * p;
+		for(i = b.rows(); i--;){
+			for(j = b.cols(); j--;){
+				if( std::abs(b(i,j) - dot(m.get_row(i), p.get_col(j))) > 1e-9 ){ mismatches++; }
+			}
+		}
+		REQUIRE( mismatches == 0 );
+
+		cmat c1 = rand_c(45, 70), c2 = rand_c(70, 53), c3 = c1 * c2;
+		for(i = c3.rows(); i--;){
+			for(j = c3.cols(); j--;){
+				if( std::abs(c3(i,j) - dot(c1.get_row(i), c2.get_col(j))) > 1e-9 ){ mismatches++; }
+			}
+		}
+		REQUIRE( mismatches == 0 );
+	}
 	SECTION("Test boundary conditions."){
 		// Example 1: NULL MATRIX
 		REQUIRE_THROWS( b = m * p );
@@ -1134,6 +1319,67 @@ TEST_CASE( " Test 'mat::operator/(T t)' " ){
 	}
 }
 
+TEST_CASE( " Test 'mat::operator+=', 'operator-=', 'operator*=' and 'operator/=' " ){
+	mat a, b;
+	SECTION("Test normal conditions."){
+		// a = |1 2|, b = |5 6|
+		//     |3 4|      |7 8|
+		a = "[1 2;3 4]"; b = "[5 6;7 8]";
+		const double* buffer = a.data();
+		a += b;
+		REQUIRE( a(0,0) == 6 ); REQUIRE( a(0,1) == 8 ); REQUIRE( a(1,0) == 10 ); REQUIRE( a(1,1) == 12 );
+		a -= b*2.0;
+		REQUIRE( a(0,0) == -4 ); REQUIRE( a(0,1) == -4 ); REQUIRE( a(1,0) == -4 ); REQUIRE( a(1,1) == -4 );
+		a += 1.0; a *= -3.0; a -= 1.0; a /= 2.0;
+		REQUIRE( a(0,0) == 4 ); REQUIRE( a(0,1) == 4 ); REQUIRE( a(1,0) == 4 ); REQUIRE( a(1,1) == 4 );
+		// none of the above reallocated the buffer
+		REQUIRE( a.data() == buffer );
+
+		// the right-hand side may read the matrix through a transpose
+		a = "[1 2;3 4]";
+		a += transpose(a);
+		REQUIRE( a(0,0) == 2 ); REQUIRE( a(0,1) == 5 ); REQUIRE( a(1,0) == 5 ); REQUIRE( a(1,1) == 8 );
+
+		// a*= b is a = a*b
+		a = "[1 2;3 4]";
+		a *= b;
+		REQUIRE( a(0,0) == 19 ); REQUIRE( a(0,1) == 22 ); REQUIRE( a(1,0) == 43 ); REQUIRE( a(1,1) == 50 );
+	}
+	SECTION("Test boundary conditions."){
+		REQUIRE_THROWS( a += b );
+		REQUIRE_THROWS( a *= 2.0 );
+		a = "[1 2;3 4]"; b = "[5 6 7]";
+		REQUIRE_THROWS( a += b );
+		REQUIRE_THROWS( a -= b );
+		REQUIRE_THROWS( a /= 0.0 );
+	}
+}
+
+TEST_CASE( " Test mat move semantics " ){
+	SECTION("Test normal conditions."){
+		mat a = rand(30, 20), b = a;
+		const double* buffer = a.data();
+		mat c = std::move(a);
+		REQUIRE( c.data() == buffer );
+		REQUIRE( c.rows() == 30 ); REQUIRE( c.cols() == 20 );
+		REQUIRE( a.size() == 0 ); REQUIRE( a.rows() == 0 ); REQUIRE( a.cols() == 0 );
+
+		// A temporary operand lends its buffer to the result.
+		mat d = rand(20, 10), e = rand(30, 10);
+		mat f = b*d + e;
+		mat g = b*d;
+		const double* product = g.data();
+		mat h = std::move(g) + e;
+		REQUIRE( h.data() == product );
+		REQUIRE( f.rows() == h.rows() );
+		size_t i, mismatches = 0;
+		for(i = f.size(); i--;){
+			if( f.data()[i] != h.data()[i] ){ mismatches++; }
+		}
+		REQUIRE( mismatches == 0 );
+	}
+}
+
 // *************************** TEST FRIEND FUNCTIONS *************************
 // ***************************************************************************
 
@@ -1179,6 +1425,39 @@ TEST_CASE( " Test 'strassen(const mat& m)' " ){
 			}
 		}
 	}
+	SECTION("Test odd sizes and deep recursion."){
+		// A small cutoff makes every size recurse several levels, and
+		// peels the odd ones on the way down.
+		size_t cutoff = strassen_cutoff(), n, i, j;
+		REQUIRE( cutoff >= 1 );
+		set_strassen_cutoff(8);
+		REQUIRE( strassen_cutoff() == 8 );
+		for (n = 9; n <= 131; n += 61){
+			a = rand(n, n);
+			b = rand(n, n);
+			c = strassen(a, b);
+			c_test = a*b;
+			REQUIRE( c.rows() == n ); REQUIRE( c.cols() == n );
+			double diff = 0, scale = 0;
+			for(i = n; i--;){
+				for(j = n; j--;){
+					diff = std::max(diff, std::abs(c(i, j) - c_test(i, j)));
+					scale = std::max(scale, std::abs(c_test(i, j)));
+				}
+			}
+			REQUIRE( diff < 1e-13*scale );
+		}
+		size_t threads = get_num_threads();
+		set_num_threads(1);
+		a = rand(100, 100);
+		b = rand(100, 100);
+		c = strassen(a, b);
+		c_test = a*b;
+		set_num_threads(threads);
+		REQUIRE( c(99, 99) == Approx(c_test(99, 99)) );
+		REQUIRE( c(0, 57) == Approx(c_test(0, 57)) );
+		set_strassen_cutoff(cutoff);
+	}
 	SECTION("Test boundary conditions."){
 		// Example 1: NON-SQUARE MATRIX
 		a = ones(40, 30);
@@ -1241,10 +1520,59 @@ TEST_CASE( " Test 'transpose(const mat& a)' " ){
 		REQUIRE( m2(1,0).real() == 6 ); REQUIRE( m2(1,0).imag() == -8 );
 		REQUIRE( m2(1,1).real() == 1 ); REQUIRE( m2(1,1).imag() == 7 );
 	}
+	SECTION(" Test transpose inside expressions"){
+		// P = |1 2|  ==>  (P + P')*0.5 = |1   2.5|
+		//     |3 4|                      |2.5 4  |
+		mat p; p = "[1 2;3 4]";
+		p = (p + transpose(p))*0.5; // 'p' is read while it is written
+		REQUIRE( p(0,0) == 1 ); REQUIRE( p(0,1) == 2.5 );
+		REQUIRE( p(1,0) == 2.5 ); REQUIRE( p(1,1) == 4 );
+
+		// Products with transposed operands are computed without copies
+		// and must match the products of the materialized transposes.
+		imat a = rand_i(67, 53), b = rand_i(71, 53), c = rand_i(67, 71);
+		imat b_t = transpose(b), a_t = transpose(a), c_t = transpose(c), d;
+		d = a*transpose(b) - a*b_t;
+		REQUIRE( max(abs(d)) == 0 );
+		d = transpose(a)*c - a_t*c;
+		REQUIRE( max(abs(d)) == 0 );
+		d = transpose(c)*transpose(a_t) - c_t*a;
+		REQUIRE( max(abs(d)) == 0 );
+		d = (a + a)*transpose(b) - a*b_t*2;
+		REQUIRE( max(abs(d)) == 0 );
+	}
+	SECTION(" Test large and in-place transposes"){
+		// Sizes which are not multiples of the tile, square and rectangular.
+		size_t sizes[4][2] = { {300, 300}, {257, 131}, {1, 500}, {67, 1000} };
+		size_t s, i, j;
+		for (s = 0; s < 4; s++){
+			size_t rows = sizes[s][0], cols = sizes[s][1];
+			imat a = rand_i(rows, cols), a_t = transpose(a);
+
+			// a = transpose(a) and inplace_transpose(a) need no copy.
+			imat b = a, c = a;
+			b = transpose(b);
+			inplace_transpose(c);
+			REQUIRE( a_t.rows() == cols ); REQUIRE( a_t.cols() == rows );
+			REQUIRE( b.rows() == cols ); REQUIRE( c.rows() == cols );
+			bool same = true;
+			for (i = 0; i < rows; i++){
+				for (j = 0; j < cols; j++){
+					same = same && a_t(j, i) == a(i, j) && b(j, i) == a(i, j) && c(j, i) == a(i, j);
+				}
+			}
+			REQUIRE( same );
+			inplace_transpose(c);
+			REQUIRE( c.rows() == rows );
+			REQUIRE( std::equal(c.data(), c.data() + c.size(), a.data()) );
+		}
+	}
 	SECTION("Test boundary conditions."){
 		m.set_size(0,0);
 		m_t = transpose(m);
 		REQUIRE(m_t.size() == 0);
+		inplace_transpose(m);
+		REQUIRE(m.size() == 0);
 	}
 }
 
@@ -1385,8 +1713,19 @@ TEST_CASE( " Test 'pinv(const mat& a)' " ){
 	}
 
 	SECTION("Test boundary conditions."){
+		//		|1 0 1 0|					  |0.25 0.25|
+		//  m = |1 0 1 0| , m_inv = pinv(m) = |0    0   | (rank 1)
+		//									  |0.25 0.25|
+		//									  |0    0   |
 		m = "[1 0 1 0;1 0 1 0]"; // neither full row rank, nor full column rank
 		m_pinv = pinv(m);
+		REQUIRE( m_pinv.rows() == 4 );
+		REQUIRE( m_pinv(0, 0) == Approx(0.25) ); REQUIRE( m_pinv(0, 1) == Approx(0.25) );
+		REQUIRE( std::abs(m_pinv(1, 0)) < 1e-15 ); REQUIRE( std::abs(m_pinv(1, 1)) < 1e-15 );
+		REQUIRE( m_pinv(2, 0) == Approx(0.25) ); REQUIRE( m_pinv(2, 1) == Approx(0.25) );
+		REQUIRE( std::abs(m_pinv(3, 0)) < 1e-15 ); REQUIRE( std::abs(m_pinv(3, 1)) < 1e-15 );
+		mat empty;
+		REQUIRE_THROWS( pinv(empty) );
 	}
 }
 
@@ -1570,7 +1909,7 @@ TEST_CASE( " Test 'mat<int>::rand_symmetric(size_t n)' " ){
 		}
 	}
 	SECTION("Test boundary conditions."){
-		REQUIRE_THROWS( m = rand_symmetric_i(MAX_ACCEPTABLE_VECTOR_SIZE + 1) );
+		REQUIRE_THROWS( m = rand_symmetric_i(1 << 20) );
 	}
 }
 
@@ -1588,7 +1927,7 @@ TEST_CASE( " Test 'mat<double>::rand_symmetric(size_t n)' " ){
 		}
 	}
 	SECTION("Test boundary conditions."){
-		REQUIRE_THROWS( m = rand_symmetric(MAX_ACCEPTABLE_VECTOR_SIZE + 1) );
+		REQUIRE_THROWS( m = rand_symmetric(1 << 20) );
 	}
 }
 
@@ -1622,7 +1961,7 @@ TEST_CASE( " Test 'mat::zeros(size_t n, size_t m)' " ){
 		// Example 1: NULL MATRIX
 		REQUIRE_THROWS( m = zeros(-3,1) );
 		REQUIRE_THROWS( m = zeros(3,-1) );
-		REQUIRE_THROWS( m = zeros(MAX_ACCEPTABLE_VECTOR_SIZE, MAX_ACCEPTABLE_VECTOR_SIZE + 1) );
+		REQUIRE_THROWS( m = zeros(1 << 20, 1 << 20) );
 	}
 }
 
@@ -1643,7 +1982,7 @@ TEST_CASE( " Test 'mat::ones(size_t n, size_t m)' " ){
 		// Example 1: NULL MATRIX
 		REQUIRE_THROWS( m = ones(-3,1) );
 		REQUIRE_THROWS( m = ones(3,-1) );
-		REQUIRE_THROWS( m = ones(MAX_ACCEPTABLE_VECTOR_SIZE, MAX_ACCEPTABLE_VECTOR_SIZE + 1) );
+		REQUIRE_THROWS( m = ones(1 << 20, 1 << 20) );
 	}
 }
 
@@ -1671,7 +2010,7 @@ TEST_CASE( " Test 'mat::eye(size_t k)' " ){
 	SECTION("Test boundary conditions."){
 		// Example 1: NULL MATRIX
 		REQUIRE_THROWS( m = eye(-3) );
-		REQUIRE_THROWS( m = eye(MAX_ACCEPTABLE_VECTOR_SIZE + 1) );
+		REQUIRE_THROWS( m = eye(1 << 20) );
 	}
 }
 
@@ -1866,10 +2205,48 @@ TEST_CASE( " Test 'mat::determinant(const mat& m)' " ){
 
 		m = "[3 2 -1 4;2 1 5 7;0 5 2 -6;-1 2 1 0]";
 		REQUIRE( determinant(m) == Approx(-418) );
+
+		// Example 2: a zero leading pivot needs a row interchange.
+		m = "[0 1;1 0]";
+		REQUIRE( determinant(m) == -1 );
+		m = "[0 2 1;3 0 1;1 1 0]";
+		REQUIRE( determinant(m) == Approx(5) );
+
+		// Example 3: an exactly singular matrix.
+		m = "[1 2 3;2 4 6;1 0 1]";
+		REQUIRE( determinant(m) == 0 );
+	}
+	SECTION("Test 'log_determinant'."){
+		double sign;
+		m = "[3 2 -1 4;2 1 5 7;0 5 2 -6;-1 2 1 0]";
+		REQUIRE( log_determinant(m, sign) == Approx(std::log(418)) );
+		REQUIRE( sign == -1 );
+
+		// det(1e3*I) = 1e600 overflows, its logarithm does not.
+		mat big = eye(200)*1e3;
+		REQUIRE( std::isinf(determinant(big)) );
+		REQUIRE( log_determinant(big, sign) == Approx(200*std::log(1e3)) );
+		REQUIRE( sign == 1 );
+
+		m = "[1 2;2 4]";
+		REQUIRE( std::isinf(log_determinant(m, sign)) );
+		REQUIRE( sign == 0 );
+
+		cmat c(2,2);
+		c(0,0) = 0.+1i; c(1,1) = 0.+1i;
+		std::complex<double> csign;
+		REQUIRE( std::abs(log_determinant(c, csign)) < 1e-15 );
+		REQUIRE( csign == std::complex<double>(-1) );
 	}
 	SECTION("Test boundary conditions."){
 		// Example 1: NULL MATRIX
+		double sign;
+		REQUIRE_THROWS( determinant(m) );
+		REQUIRE_THROWS( log_determinant(m, sign) );
+		// Example 2: NON-SQUARE MATRIX
+		m = "[1 2 3;4 5 6]";
 		REQUIRE_THROWS( determinant(m) );
+		REQUIRE_THROWS( log_determinant(m, sign) );
 	}
 }
 
@@ -1897,7 +2274,7 @@ TEST_CASE( " Test 'mat::magic_square(int n)' " ){
 	SECTION("Test boundary conditions."){
 		REQUIRE_THROWS( magic_square(-1) );
 		REQUIRE_THROWS( magic_square(4) );
-		REQUIRE_THROWS( magic_square(MAX_ACCEPTABLE_VECTOR_SIZE + 1) );
+		REQUIRE_THROWS( magic_square(1 << 20) );
 	}
 }
 
@@ -0,0 +1,170 @@
+/*====================================================================================================
+ * Name         : qr_test.cpp implements a unit-test for the Householder QR
+ *                factorization and lstsq() (include/qr.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+#include "../include/test_utils.h"
+
+namespace algebra {
+
+TEST_CASE( " Test 'qr(const mat& a, mat& q, mat& r)' " ){
+	SECTION("Test normal conditions."){
+		mat a; a = "[12 -51 4;6 167 -68;-4 24 -41]";
+		mat q, r;
+		qr(a, q, r);
+		REQUIRE( q.rows() == 3 );
+		REQUIRE( r.rows() == 3 );
+		REQUIRE( std::abs(r(0, 0)) == Approx(14) );
+		REQUIRE( std::abs(r(1, 1)) == Approx(175) );
+		REQUIRE( std::abs(r(2, 2)) == Approx(35) );
+		REQUIRE( r(1, 0) == 0 );
+		REQUIRE( r(2, 0) == 0 );
+		REQUIRE( r(2, 1) == 0 );
+		REQUIRE( max_abs_diff(mat(q*r), a) < 1e-12 );
+		REQUIRE( max_abs_diff(mat(transpose(q)*q), eye(3)) < 1e-14 );
+	}
+	SECTION("Test tall and wide matrices (several blocks)."){
+		mat a = rand(300, 70), q, r;
+		qr(a, q, r);
+		REQUIRE( q.rows() == 300 );
+		REQUIRE( q.cols() == 70 );
+		REQUIRE( r.rows() == 70 );
+		REQUIRE( max_abs_diff(mat(q*r), a) < 1e-12 );
+		REQUIRE( max_abs_diff(mat(transpose(q)*q), eye(70)) < 1e-12 );
+
+		mat w = rand(40, 100);
+		qr(w, q, r);
+		REQUIRE( q.cols() == 40 );
+		REQUIRE( r.cols() == 100 );
+		REQUIRE( max_abs_diff(mat(q*r), w) < 1e-12 );
+	}
+	SECTION("Test complex values."){
+		cmat a = rand_c(80, 50), q, r;
+		qr(a, q, r);
+		REQUIRE( max_abs_diff(cmat(q*r), a) < 1e-12 );
+		REQUIRE( max_abs_diff(cmat(conj_transpose(q)*q), cmat(eye_c(50))) < 1e-12 );
+		REQUIRE( r(10, 3) == std::complex<double>(0) );
+	}
+	SECTION("Test boundary conditions."){
+		mat empty, q, r;
+		REQUIRE_THROWS( qr(empty, q, r) );
+	}
+}
+
+TEST_CASE( " Test 'QR::apply_q(const mat& b)' and 'QR::apply_qt(const mat& b)' " ){
+	SECTION("Test normal conditions."){
+		mat a = rand(150, 60), b = rand(150, 7);
+		QR<double> f(a);
+		mat q = f.Q();
+		// Q^H*b splits into the part in the range of a and its complement.
+		mat c = f.apply_qt(b);
+		mat c_top(60, 7);
+		size_t i, j;
+		for(i = 0; i < 60; i++){
+			for(j = 0; j < 7; j++){
+				c_top(i, j) = c(i, j);
+			}
+		}
+		REQUIRE( max_abs_diff(c_top, mat(transpose(q)*b)) < 1e-12 );
+		REQUIRE( max_abs_diff(f.apply_q(c), b) < 1e-12 );
+
+		vec v = rand(150);
+		vec back = f.apply_q(f.apply_qt(v));
+		double diff = 0;
+		for(i = 0; i < 150; i++){
+			diff = std::max(diff, std::abs(back[i] - v[i]));
+		}
+		REQUIRE( diff < 1e-12 );
+	}
+	SECTION("Test boundary conditions."){
+		QR<double> f;
+		mat b(3, 1);
+		REQUIRE_THROWS( f.apply_q(b) );
+		mat a = rand(5, 3);
+		f.compute(a);
+		REQUIRE_THROWS( f.apply_qt(b) );
+	}
+}
+
+TEST_CASE( " Test 'lstsq(const mat& a, const vec& b)' " ){
+	SECTION("Test normal conditions."){
+		// Line fit of y = 1 + 2*t through 4 points.
+		mat a; a = "[1 0;1 1;1 2;1 3]";
+		vec b; b = "[1 3 5 7]";
+		vec x = lstsq(a, b);
+		REQUIRE( x[0] == Approx(1) );
+		REQUIRE( x[1] == Approx(2) );
+
+		// It matches the normal equations a'*a*x = a'*b.
+		mat big = rand(200, 45);
+		vec y = rand(200);
+		vec z = lstsq(big, y);
+		mat big_t = transpose(big);
+		vec ref = solve(mat(big_t*big), vec(big_t*y));
+		size_t i;
+		double diff = 0;
+		for(i = 0; i < 45; i++){
+			diff = std::max(diff, std::abs(z[i] - ref[i]));
+		}
+		REQUIRE( diff < 1e-8 );
+	}
+	SECTION("Test underdetermined systems (minimum norm)."){
+		mat a; a = "[1 1]";
+		vec b; b = "[2]";
+		vec x = lstsq(a, b);
+		REQUIRE( x[0] == Approx(1) );
+		REQUIRE( x[1] == Approx(1) );
+
+		mat w = rand(30, 90), rhs = rand(30, 4);
+		mat xw = lstsq(w, rhs);
+		REQUIRE( max_abs_diff(mat(w*xw), rhs) < 1e-10 );
+	}
+	SECTION("Test complex values."){
+		cmat a = rand_c(60, 20);
+		cvec b = a*rand_c(20, 1).get_col(0);
+		cvec x = lstsq(a, b);
+		cvec r = a*x;
+		size_t i;
+		double diff = 0;
+		for(i = 0; i < 60; i++){
+			diff = std::max(diff, std::abs(r[i] - b[i]));
+		}
+		REQUIRE( diff < 1e-10 );
+	}
+	SECTION("Test boundary conditions."){
+		mat a = rand(5, 3);
+		vec b(4);
+		REQUIRE_THROWS( lstsq(a, b) );
+		mat rank_deficient; rank_deficient = "[1 2;2 4;3 6]";
+		vec c; c = "[1 2 3]";
+		vec x = lstsq(rank_deficient, c);
+		REQUIRE( std::isnan(x[0]) );
+	}
+}
+
+} /* namespace algebra */
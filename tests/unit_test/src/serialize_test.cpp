@@ -0,0 +1,146 @@
+/*====================================================================================================
+ * Name         : serialize_test.cpp implements a unit-test for the binary file format
+ *                (include/serialize.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+
+#include <cstdio>       // std::fopen, std::remove
+
+
+
+
+namespace algebra {
+
+#define SERIALIZE_TEST_FILE "/tmp/LinearAlgebra_serialize.bin"
+
+// It flips one bit of the byte at offset of the file path.
+inline void serialize_flip_bit(const char* path, long offset)
+{
+	FILE* f = std::fopen(path, "r+b");
+	std::fseek(f, offset, SEEK_SET);
+	int c = std::fgetc(f);
+	std::fseek(f, offset, SEEK_SET);
+	std::fputc(c ^ 0x10, f);
+	std::fclose(f);
+}
+
+TEST_CASE( " Test 'save(path, x)' and 'load(path, x)' " ){
+	SECTION("Test vectors and matrices of every element type."){
+		mat a = rand(37, 53), a2;
+		save(SERIALIZE_TEST_FILE, a);
+		load(SERIALIZE_TEST_FILE, a2);
+		REQUIRE( a2.rows() == 37 );
+		REQUIRE( a2.cols() == 53 );
+		REQUIRE( std::equal(a.data(), a.data() + a.size(), a2.data()) );
+
+		vec v = rand(1001), v2;
+		save(SERIALIZE_TEST_FILE, v);
+		load(SERIALIZE_TEST_FILE, v2);
+		REQUIRE( v2.size() == 1001 );
+		REQUIRE( std::equal(v.data(), v.data() + v.size(), v2.data()) );
+
+		imat b; b = "[1 -2 3;4 5 -6]";
+		imat b2;
+		save(SERIALIZE_TEST_FILE, b);
+		load(SERIALIZE_TEST_FILE, b2);
+		REQUIRE( b2(1, 2) == -6 );
+		REQUIRE( b2(0, 1) == -2 );
+
+		cmat c(2, 2), c2;
+		c(0, 1) = std::complex<double>(1.5, -2.5);
+		save(SERIALIZE_TEST_FILE, c);
+		load(SERIALIZE_TEST_FILE, c2);
+		REQUIRE( c2(0, 1) == std::complex<double>(1.5, -2.5) );
+
+		vec e, e2 = rand(3);
+		save(SERIALIZE_TEST_FILE, e);
+		load(SERIALIZE_TEST_FILE, e2);
+		REQUIRE( e2.size() == 0 );
+	}
+	SECTION("Test files that do not match."){
+		mat a = rand(4, 5), a2 = a;
+		vec v;
+		imat b;
+		save(SERIALIZE_TEST_FILE, a);
+		REQUIRE_THROWS_AS( load(SERIALIZE_TEST_FILE, v), const std::invalid_argument& );
+		REQUIRE_THROWS_AS( load(SERIALIZE_TEST_FILE, b), const std::invalid_argument& );
+		REQUIRE_THROWS_AS( load("/tmp/LinearAlgebra_no_such_file.bin", a2), const std::runtime_error& );
+		// A corrupted element is caught by the checksum; a2 is unchanged.
+		serialize_flip_bit(SERIALIZE_TEST_FILE, ARRAY_ALIGNMENT + 17);
+		REQUIRE_THROWS_AS( load(SERIALIZE_TEST_FILE, a2), const std::invalid_argument& );
+		REQUIRE( std::equal(a.data(), a.data() + a.size(), a2.data()) );
+		// So is a corrupted header.
+		save(SERIALIZE_TEST_FILE, a);
+		serialize_flip_bit(SERIALIZE_TEST_FILE, 2);
+		REQUIRE_THROWS_AS( load(SERIALIZE_TEST_FILE, a2), const std::invalid_argument& );
+	}
+	std::remove(SERIALIZE_TEST_FILE);
+}
+
+TEST_CASE( " Test 'mapped_array' " ){
+	SECTION("Test that the elements are used in place."){
+		mat a = rand(30, 20), b = rand(20, 10);
+		save(SERIALIZE_TEST_FILE, a);
+		MappedArray<double> m(SERIALIZE_TEST_FILE, true);
+		REQUIRE( m.rank() == 2 );
+		REQUIRE( m.rows() == 30 );
+		REQUIRE( m.cols() == 20 );
+		REQUIRE( (reinterpret_cast<size_t>(m.data()) % ARRAY_ALIGNMENT) == 0 );
+		REQUIRE( m.mat()(29, 19) == a(29, 19) );
+		mat p = m.mat()*b, ref = a*b;
+		REQUIRE( std::equal(p.data(), p.data() + p.size(), ref.data()) );
+		mat copy = m.mat();
+		REQUIRE( std::equal(a.data(), a.data() + a.size(), copy.data()) );
+
+		// The mapping survives the file being saved over.
+		save(SERIALIZE_TEST_FILE, b);
+		MappedArray<double> moved(std::move(m));
+		REQUIRE( moved.mat()(29, 19) == a(29, 19) );
+	}
+	SECTION("Test a mapped vector."){
+		vec v = rand(100);
+		save(SERIALIZE_TEST_FILE, v);
+		MappedArray<double> m(SERIALIZE_TEST_FILE);
+		REQUIRE( m.rank() == 1 );
+		REQUIRE( m.vec().size() == 100 );
+		REQUIRE( m.vec()*v == Approx(v*v) );
+		REQUIRE( m.mat().cols() == 1 );
+	}
+	SECTION("Test the checks of the loader."){
+		mat a = rand(8, 8);
+		save(SERIALIZE_TEST_FILE, a);
+		REQUIRE_THROWS_AS( MappedArray<int>(SERIALIZE_TEST_FILE), const std::invalid_argument& );
+		serialize_flip_bit(SERIALIZE_TEST_FILE, ARRAY_ALIGNMENT + 100);
+		MappedArray<double> unchecked(SERIALIZE_TEST_FILE);
+		REQUIRE( unchecked.size() == 64 );
+		REQUIRE_THROWS_AS( MappedArray<double>(SERIALIZE_TEST_FILE, true), const std::invalid_argument& );
+	}
+	std::remove(SERIALIZE_TEST_FILE);
+}
+
+} /* namespace algebra */
@@ -0,0 +1,229 @@
+/*====================================================================================================
+ * Name         : smat_test.cpp implements a unit-test for the fixed-size
+ *                'svec' and 'smat' classes of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+
+namespace algebra {
+
+TEST_CASE( " Test svec constructors and conversions." ){
+	SECTION("Test normal conditions."){
+		svec<3> a;
+		REQUIRE( a.size() == 3 );
+		REQUIRE( a(0) == 0 ); REQUIRE( a(1) == 0 ); REQUIRE( a(2) == 0 );
+
+		svec<3> b = {1, -2, 3};
+		REQUIRE( b(0) == 1 ); REQUIRE( b(1) == -2 ); REQUIRE( b(2) == 3 );
+
+		vec v = b;
+		REQUIRE( v.size() == 3 );
+		REQUIRE( v(0) == 1 ); REQUIRE( v(1) == -2 ); REQUIRE( v(2) == 3 );
+
+		svec<3> c(v);
+		REQUIRE( c.get(1) == -2 );
+	}
+	SECTION("Test boundary conditions."){
+		vec v = zeros(4);
+		REQUIRE_THROWS( svec<3>(v) );
+		REQUIRE_THROWS( svec<3>({1, 2}) );
+		svec<3> a;
+		REQUIRE_THROWS( a.get(3) );
+		REQUIRE_THROWS( a.set(3, 1.0) );
+	}
+}
+
+TEST_CASE( " Test svec operators." ){
+	SECTION("Test normal conditions."){
+		svec<3> a = {1, 2, 3}, b = {4, 5, 6}, c;
+		c = a + b;
+		REQUIRE( c(0) == 5 ); REQUIRE( c(1) == 7 ); REQUIRE( c(2) == 9 );
+		c = b - a*2.0;
+		REQUIRE( c(0) == 2 ); REQUIRE( c(1) == 1 ); REQUIRE( c(2) == 0 );
+		c = (a + 1.0)/2.0;
+		REQUIRE( c(0) == 1 ); REQUIRE( c(1) == 1.5 ); REQUIRE( c(2) == 2 );
+		REQUIRE( a*b == 32 );
+	}
+	SECTION("Test boundary conditions."){
+		svec<3> a = {1, 2, 3};
+		REQUIRE_THROWS( a/0.0 );
+	}
+}
+
+TEST_CASE( " Test smat constructors and conversions." ){
+	SECTION("Test normal conditions."){
+		smat<2,3> a;
+		REQUIRE( a.rows() == 2 ); REQUIRE( a.cols() == 3 ); REQUIRE( a.size() == 6 );
+		REQUIRE( a(1,2) == 0 );
+
+		// m = |1 2 3|
+		//     |4 5 6|
+		smat<2,3> m = {1, 2, 3, 4, 5, 6};
+		REQUIRE( m(0,0) == 1 ); REQUIRE( m(0,2) == 3 ); REQUIRE( m(1,0) == 4 ); REQUIRE( m(1,2) == 6 );
+
+		mat d = m;
+		REQUIRE( d.rows() == 2 ); REQUIRE( d.cols() == 3 );
+		REQUIRE( d(1,1) == 5 );
+
+		smat<2,3> s(d);
+		REQUIRE( s.get(1,2) == 6 );
+		REQUIRE( s.get_row(1)(0) == 4 );
+		REQUIRE( s.get_col(2)(1) == 6 );
+	}
+	SECTION("Test boundary conditions."){
+		mat d = zeros(3,2);
+		REQUIRE_THROWS( (smat<2,3>(d)) );
+		REQUIRE_THROWS( (smat<2,2>({1, 2, 3})) );
+		smat<2,2> a;
+		REQUIRE_THROWS( a.get(2,0) );
+		REQUIRE_THROWS( a.get_row(2) );
+		REQUIRE_THROWS( a.get_col(2) );
+	}
+}
+
+TEST_CASE( " Test smat operators." ){
+	SECTION("Test normal conditions."){
+		// a = |1 2|, b = |5 6|
+		//     |3 4|      |7 8|
+		smat<2,2> a = {1, 2, 3, 4}, b = {5, 6, 7, 8}, c;
+		c = a + b*2.0 - 1.0;
+		REQUIRE( c(0,0) == 10 ); REQUIRE( c(0,1) == 13 ); REQUIRE( c(1,0) == 16 ); REQUIRE( c(1,1) == 19 );
+
+		c = a*b;
+		REQUIRE( c(0,0) == 19 ); REQUIRE( c(0,1) == 22 ); REQUIRE( c(1,0) == 43 ); REQUIRE( c(1,1) == 50 );
+
+		// Non-square product: (2x3)*(3x1) = 2x1
+		smat<2,3> m = {1, 2, 3, 4, 5, 6};
+		smat<3,1> n = {1, 0, -1};
+		smat<2,1> p = m*n;
+		REQUIRE( p(0,0) == -2 ); REQUIRE( p(1,0) == -2 );
+
+		svec<3> x = {1, 0, -1};
+		svec<2> y = m*x;
+		REQUIRE( y(0) == -2 ); REQUIRE( y(1) == -2 );
+
+		// The products agree with the dynamic matrices.
+		smat<5,4> r = smat<5,4>(rand(5,4));
+		smat<4,3> q = smat<4,3>(rand(4,3));
+		mat rq = mat(r)*mat(q);
+		smat<5,3> s = r*q;
+		size_t i, j, mismatches = 0;
+		for (i = 0; i < 5; i++){
+			for (j = 0; j < 3; j++){
+				if( std::abs(s(i,j) - rq(i,j)) > 1e-12 ){ mismatches++; }
+			}
+		}
+		REQUIRE( mismatches == 0 );
+	}
+	SECTION("Test boundary conditions."){
+		smat<2,2> a = {1, 2, 3, 4};
+		REQUIRE_THROWS( a/0.0 );
+	}
+}
+
+TEST_CASE( " Test 'transpose', 'diag', 'eye' for smat." ){
+	SECTION("Test normal conditions."){
+		smat<2,3> m = {1, 2, 3, 4, 5, 6};
+		smat<3,2> t = transpose(m);
+		REQUIRE( t(0,0) == 1 ); REQUIRE( t(0,1) == 4 );
+		REQUIRE( t(1,0) == 2 ); REQUIRE( t(1,1) == 5 );
+		REQUIRE( t(2,0) == 3 ); REQUIRE( t(2,1) == 6 );
+
+		smat<3,3> e = eye<double,3>();
+		svec<3> d = diag(e);
+		REQUIRE( d(0) == 1 ); REQUIRE( d(1) == 1 ); REQUIRE( d(2) == 1 );
+		REQUIRE( e(0,1) == 0 );
+
+		svec<2> v = {3, -1};
+		smat<2,2> dv = diag(v);
+		REQUIRE( dv(0,0) == 3 ); REQUIRE( dv(1,1) == -1 ); REQUIRE( dv(0,1) == 0 ); REQUIRE( dv(1,0) == 0 );
+	}
+}
+
+TEST_CASE( " Test 'determinant' and 'inv' for smat." ){
+	SECTION("Test normal conditions."){
+		smat<1,1> a1 = {4};
+		REQUIRE( determinant(a1) == 4 );
+		REQUIRE( inv(a1)(0,0) == 0.25 );
+
+		smat<2,2> a2 = {4, 7, 2, 6};
+		REQUIRE( determinant(a2) == Approx(10) );
+		smat<2,2> i2 = a2*inv(a2);
+		REQUIRE( i2(0,0) == Approx(1) ); REQUIRE( std::abs(i2(0,1)) < 1e-12 );
+		REQUIRE( std::abs(i2(1,0)) < 1e-12 ); REQUIRE( i2(1,1) == Approx(1) );
+
+		// The closed forms (N <= 3) and the elimination (N > 3)
+		// agree with the dynamic matrices.
+		smat<3,3> a3 = smat<3,3>(rand(3,3));
+		smat<5,5> a5 = smat<5,5>(rand(5,5));
+		REQUIRE( determinant(a3) == Approx(determinant(mat(a3))) );
+		REQUIRE( determinant(a5) == Approx(determinant(mat(a5))) );
+		mat i3 = inv(a3), i5 = inv(a5), j3 = inv(mat(a3)), j5 = inv(mat(a5));
+		size_t i, mismatches = 0;
+		for (i = 9; i--;){
+			if( std::abs(i3.data()[i] - j3.data()[i]) > 1e-6 ){ mismatches++; }
+		}
+		for (i = 25; i--;){
+			if( std::abs(i5.data()[i] - j5.data()[i]) > 1e-6 ){ mismatches++; }
+		}
+		REQUIRE( mismatches == 0 );
+	}
+	SECTION("Test boundary conditions."){
+		// Singular matrices
+		smat<2,2> a2 = {1, 2, 2, 4};
+		REQUIRE( determinant(a2) == 0 );
+		REQUIRE( std::isnan(inv(a2)(0,0)) );
+		smat<4,4> a4 = {1, 2, 3, 4, 2, 4, 6, 8, 0, 1, 0, 1, 1, 0, 0, 1};
+		REQUIRE( determinant(a4) == 0 );
+		REQUIRE( std::isnan(inv(a4)(0,0)) );
+	}
+	SECTION("Test small but regular matrices."){
+		// The determinants are below SINGULARITY_THRESHOLD, the pivots are
+		// not: the closed forms invert them as mat does.
+		smat<2,2> d2 = {1e-5, 0, 0, 1e-5};
+		smat<2,2> a2 = smat<2,2>{4, 1, 1, 3}*1e-5;
+		smat<3,3> a3 = smat<3,3>{4, 1, 0, 1, 3, 1, 0, 1, 2}*1e-4;
+		mat i2 = inv(d2), j2 = inv(mat(d2));
+		REQUIRE( i2(0,0) == Approx(1e5) );
+		REQUIRE( j2(0,0) == Approx(1e5) );
+		mat k2 = inv(a2), l2 = inv(mat(a2)), i3 = inv(a3), j3 = inv(mat(a3));
+		size_t i, mismatches = 0;
+		for (i = 4; i--;){
+			if( std::abs(k2.data()[i] - l2.data()[i]) > 1e-6*std::abs(l2.data()[i]) ){ mismatches++; }
+		}
+		for (i = 9; i--;){
+			if( std::abs(i3.data()[i] - j3.data()[i]) > 1e-6*std::abs(j3.data()[i]) ){ mismatches++; }
+		}
+		REQUIRE( mismatches == 0 );
+		// A pivot below the threshold is singular for both.
+		smat<2,2> s2 = {1e-10, 0, 0, 1};
+		REQUIRE( std::isnan(inv(s2)(0,0)) );
+		smat<3,3> s3 = {1, 0, 0, 0, 1, 0, 0, 0, 1e-10};
+		REQUIRE( std::isnan(inv(s3)(0,0)) );
+	}
+}
+
+} /* namespace algebra */
@@ -0,0 +1,154 @@
+/*====================================================================================================
+ * Name         : svd_test.cpp implements a unit-test for the singular value
+ *                decomposition, rank() and pinv() (include/svd.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+#include "../include/test_utils.h"
+
+
+namespace algebra {
+
+// It returns u*diag(s)*v'.
+template <class T>
+Mat<T> svd_product(const Mat<T>& u, const vec& s, const Mat<T>& v)
+{
+	Mat<T> us = u, v_h(v.cols(), v.rows());
+	size_t i, j;
+	for (i = 0; i < u.rows(); i++){
+		for (j = 0; j < u.cols(); j++){
+			us(i, j) *= T(s.get(j));
+		}
+	}
+	for (i = 0; i < v.rows(); i++){
+		for (j = 0; j < v.cols(); j++){
+			v_h(j, i) = scalar_conj(v.get(i, j));
+		}
+	}
+	return us*v_h;
+}
+
+TEST_CASE( " Test 'svd(const mat& a, mat& u, vec& s, mat& v)' " ){
+	SECTION("Test normal conditions."){
+		//		|3  2  2|
+		//  a = |2  3 -2| , s = [5 3]
+		mat a; a = "[3 2 2;2 3 -2]";
+		mat u, v;
+		vec s;
+		svd(a, u, s, v);
+		REQUIRE( s.size() == 2 );
+		REQUIRE( s[0] == Approx(5) );
+		REQUIRE( s[1] == Approx(3) );
+		REQUIRE( u.rows() == 2 );
+		REQUIRE( v.rows() == 3 );
+		REQUIRE( v.cols() == 2 );
+		REQUIRE( max_abs_diff(svd_product(u, s, v), a) < 1e-13 );
+	}
+	SECTION("Test tall, square and wide matrices."){
+		size_t shapes[3][2] = {{200, 60}, {90, 90}, {30, 110}}, t, i;
+		for (t = 0; t < 3; t++){
+			size_t m = shapes[t][0], n = shapes[t][1], k = std::min(m, n);
+			mat a = rand(m, n), u, v;
+			vec s;
+			svd(a, u, s, v);
+			REQUIRE( max_abs_diff(svd_product(u, s, v), a) < 1e-10 );
+			REQUIRE( max_abs_diff(mat(transpose(u)*u), eye(k)) < 1e-12 );
+			REQUIRE( max_abs_diff(mat(transpose(v)*v), eye(k)) < 1e-12 );
+			size_t unsorted = 0;
+			for (i = 1; i < k; i++){
+				if (s[i] > s[i - 1]) { unsorted++; }
+			}
+			REQUIRE( unsorted == 0 );
+			vec s_only = svd(a);
+			REQUIRE( s_only[0] == Approx(s[0]) );
+			REQUIRE( s_only[k - 1] == Approx(s[k - 1]) );
+		}
+	}
+	SECTION("Test complex values."){
+		cmat a = rand_c(50, 30), u, v;
+		vec s;
+		svd(a, u, s, v);
+		REQUIRE( max_abs_diff(svd_product(u, s, v), a) < 1e-10 );
+		REQUIRE( max_abs_diff(cmat(conj_transpose(u)*u), eye_c(30)) < 1e-12 );
+		REQUIRE( max_abs_diff(cmat(conj_transpose(v)*v), eye_c(30)) < 1e-12 );
+	}
+	SECTION("Test boundary conditions."){
+		// A rank deficient matrix still has an orthonormal u.
+		mat a; a = "[1 2;2 4;3 6]";
+		mat u, v;
+		vec s;
+		svd(a, u, s, v);
+		REQUIRE( s[0] == Approx(std::sqrt(70.0)) );
+		REQUIRE( s[1] < 1e-14 );
+		REQUIRE( max_abs_diff(mat(transpose(u)*u), eye(2)) < 1e-12 );
+		REQUIRE( max_abs_diff(svd_product(u, s, v), a) < 1e-13 );
+
+		mat empty;
+		REQUIRE_THROWS( svd(empty, u, s, v) );
+		REQUIRE_THROWS( svd(empty) );
+	}
+}
+
+TEST_CASE( " Test 'rank(const mat& a)' and 'pinv(const mat& a)' " ){
+	SECTION("Test normal conditions."){
+		mat a = rand(40, 6), b = rand(6, 30);
+		mat low_rank = a*b;
+		REQUIRE( rank(low_rank) == 6 );
+		REQUIRE( rank(a) == 6 );
+		REQUIRE( rank(low_rank, 1e20) == 0 );
+
+		// The four Moore-Penrose conditions hold for the rank 6 matrix.
+		mat x = pinv(low_rank);
+		REQUIRE( x.rows() == 30 );
+		REQUIRE( x.cols() == 40 );
+		double scale = max(abs(low_rank));
+		REQUIRE( max_abs_diff(mat(low_rank*x*low_rank), low_rank) < 1e-10*scale );
+		REQUIRE( max_abs_diff(mat(x*low_rank*x), x) < 1e-10 );
+		mat ax = low_rank*x, xa = x*low_rank;
+		REQUIRE( max_abs_diff(ax, mat(transpose(ax))) < 1e-10 );
+		REQUIRE( max_abs_diff(xa, mat(transpose(xa))) < 1e-10 );
+
+		// A non-singular square matrix gives its inverse.
+		mat sq = eye(50) + rand(50, 50)*0.01;
+		REQUIRE( max_abs_diff(pinv(sq), inv(sq)) < 1e-10 );
+	}
+	SECTION("Test complex values."){
+		cmat a = rand_c(20, 4)*rand_c(4, 15);
+		REQUIRE( rank(a) == 4 );
+		cmat x = pinv(a);
+		REQUIRE( max_abs_diff(cmat(a*x*a), a) < 1e-8 );
+	}
+	SECTION("Test boundary conditions."){
+		mat zero(3, 4);
+		REQUIRE( rank(zero) == 0 );
+		mat x = pinv(zero);
+		REQUIRE( x.rows() == 4 );
+		REQUIRE( max(abs(x)) == 0 );
+	}
+}
+
+} /* namespace algebra */
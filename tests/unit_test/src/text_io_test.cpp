@@ -0,0 +1,195 @@
+/*====================================================================================================
+ * Name         : text_io_test.cpp implements a unit-test for the CSV and Matrix Market
+ *                readers and writers (include/text_io.h) of the LinearAlgebra library.
+ * Version      : 1.0.0, 16 Oct 2026
+ *
+ * Copyright (c) 2017 Ioannis Karagiannis
+ * All rights reserved
+
+ * This file is part of LinearAlgebra library.
+
+ * LinearAlgebra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * You are free to use this library under the terms of the GNU General
+ * Public License, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with LinearAlgebra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact info: https://www.linkedin.com/in/ioannis-karagiannis-7129394a/
+ * 				ioanniskaragiannis1987@gmail.com
+=====================================================================================================*/
+
+
+#include "../include/catch.hpp"
+#include "../../../include/base.h"
+
+#include <cstdio>       // std::fopen, std::remove
+
+
+
+
+namespace algebra {
+
+#define TEXT_TEST_FILE "/tmp/LinearAlgebra_text_io.txt"
+
+// It writes text to the file path.
+inline void text_test_write(const char* path, const std::string& text)
+{
+	FILE* f = std::fopen(path, "wb");
+	std::fwrite(text.data(), 1, text.size(), f);
+	std::fclose(f);
+}
+
+// It returns the message of the exception thrown by f.
+template <class F>
+std::string text_test_error(const F& f)
+{
+	try {
+		f();
+	}
+	catch (const std::exception& e) {
+		return e.what();
+	}
+	return "";
+}
+
+TEST_CASE( " Test 'read_csv(path)' and 'write_csv(path, m)' " ){
+	// Small chunks, so that the files below are split among the threads.
+	set_text_chunk_size(256);
+	SECTION("Test a round trip through a file."){
+		mat a = rand(1000, 7);
+		a(3, 4) = -1e-300;
+		a(5, 6) = 0.1;
+		write_csv(TEXT_TEST_FILE, a);
+		mat b = read_csv<double>(TEXT_TEST_FILE);
+		REQUIRE( b.rows() == 1000 );
+		REQUIRE( b.cols() == 7 );
+		REQUIRE( std::equal(a.data(), a.data() + a.size(), b.data()) );
+
+		imat k = rand_i(500, 3) - 5;
+		write_csv(TEXT_TEST_FILE, k, ';');
+		imat k2 = read_csv<int>(TEXT_TEST_FILE, ';');
+		REQUIRE( std::equal(k.data(), k.data() + k.size(), k2.data()) );
+	}
+	SECTION("Test headers, blank lines, blanks and empty fields."){
+		text_test_write(TEXT_TEST_FILE, "x,y,z\r\n1, 2 ,3\r\n\r\n 4,5,6e1\r\n7,,9");
+		mat a = read_csv<double>(TEXT_TEST_FILE, ',', 1);
+		REQUIRE( a.rows() == 3 );
+		REQUIRE( a.cols() == 3 );
+		REQUIRE( a(1, 2) == 60 );
+		REQUIRE( std::isnan(a(2, 1)) );
+		REQUIRE( a(2, 2) == 9 );
+
+		text_test_write(TEXT_TEST_FILE, "1  2\t3\n4 5 6\n");
+		a = read_csv<double>(TEXT_TEST_FILE, ' ');
+		REQUIRE( a.rows() == 2 );
+		REQUIRE( a(1, 0) == 4 );
+
+		text_test_write(TEXT_TEST_FILE, "");
+		REQUIRE( read_csv<double>(TEXT_TEST_FILE).size() == 0 );
+	}
+	SECTION("Test that the errors name their line."){
+		std::string text;
+		for (size_t i = 0; i < 200; i++)
+		{
+			text += "1,2,3\n";
+		}
+		text_test_write(TEXT_TEST_FILE, text + "1,2\n");
+		REQUIRE( text_test_error([]{ read_csv<double>(TEXT_TEST_FILE); }).find(":201: expected 3 fields") != std::string::npos );
+		text_test_write(TEXT_TEST_FILE, text + "\n1,2,3x\n");
+		REQUIRE( text_test_error([]{ read_csv<double>(TEXT_TEST_FILE); }).find(":202: invalid number '3x'") != std::string::npos );
+		text_test_write(TEXT_TEST_FILE, "1,2\n3,4.5\n");
+		REQUIRE_THROWS_AS( read_csv<int>(TEXT_TEST_FILE), const std::invalid_argument& );
+		REQUIRE_THROWS_AS( read_csv<double>("/tmp/LinearAlgebra_no_such_file.csv"), const std::runtime_error& );
+	}
+	set_text_chunk_size(0);
+	std::remove(TEXT_TEST_FILE);
+}
+
+TEST_CASE( " Test 'read_mtx(path)' and 'write_mtx(path, m)' " ){
+	set_text_chunk_size(256);
+	SECTION("Test the array format."){
+		mat a = rand(61, 17);
+		write_mtx(TEXT_TEST_FILE, a);
+		mat b = read_mtx<double>(TEXT_TEST_FILE);
+		REQUIRE( b.rows() == 61 );
+		REQUIRE( b.cols() == 17 );
+		REQUIRE( std::equal(a.data(), a.data() + a.size(), b.data()) );
+
+		cmat c(3, 2);
+		c(2, 1) = std::complex<double>(0.5, -4);
+		write_mtx(TEXT_TEST_FILE, c);
+		REQUIRE( read_mtx< std::complex<double> >(TEXT_TEST_FILE)(2, 1) == std::complex<double>(0.5, -4) );
+		REQUIRE_THROWS_AS( read_mtx<double>(TEXT_TEST_FILE), const std::invalid_argument& );
+	}
+	SECTION("Test symmetric arrays."){
+		// Lower triangles, down the columns.
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix array real symmetric\n% comment\n3 3\n1\n2\n3\n4\n5\n6\n");
+		mat s = read_mtx<double>(TEXT_TEST_FILE);
+		mat ref; ref = "[1 2 3;2 4 5;3 5 6]";
+		REQUIRE( std::equal(s.data(), s.data() + 9, ref.data()) );
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix array integer skew-symmetric\n3 3\n1\n2\n3\n");
+		imat k = read_mtx<int>(TEXT_TEST_FILE);
+		imat kref; kref = "[0 -1 -2;1 0 -3;2 3 0]";
+		REQUIRE( std::equal(k.data(), k.data() + 9, kref.data()) );
+	}
+	SECTION("Test the coordinate format."){
+		CooMat<double> a(500, 300);
+		for (size_t k = 0; k < 400; k++)
+		{
+			a.row.push_back((k*37) % 500);
+			a.col.push_back((k*11) % 300);
+			a.value.push_back(k*0.25 - 3);
+		}
+		write_mtx(TEXT_TEST_FILE, a);
+		CooMat<double> b = read_mtx_coordinate<double>(TEXT_TEST_FILE);
+		REQUIRE( b.rows == 500 );
+		REQUIRE( b.cols == 300 );
+		REQUIRE( b.nnz() == 400 );
+		REQUIRE( b.row == a.row );
+		REQUIRE( b.col == a.col );
+		REQUIRE( b.value == a.value );
+		mat d = read_mtx<double>(TEXT_TEST_FILE), ref = a.to_mat();
+		REQUIRE( std::equal(d.data(), d.data() + d.size(), ref.data()) );
+	}
+	SECTION("Test symmetric, hermitian and pattern coordinates."){
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix coordinate real symmetric\n3 3 3\n1 1 2\n3 1 -1\n3 2 4.5\n");
+		CooMat<double> s = read_mtx_coordinate<double>(TEXT_TEST_FILE);
+		REQUIRE( s.nnz() == 5 );
+		mat m = s.to_mat();
+		REQUIRE( m(0, 2) == -1 );
+		REQUIRE( m(2, 0) == -1 );
+		REQUIRE( m(1, 2) == 4.5 );
+
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix coordinate complex hermitian\n2 2 1\n2 1 1 2\n");
+		cmat h = read_mtx< std::complex<double> >(TEXT_TEST_FILE);
+		REQUIRE( h(1, 0) == std::complex<double>(1, 2) );
+		REQUIRE( h(0, 1) == std::complex<double>(1, -2) );
+
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix coordinate pattern general\n2 3 2\n1 3\n2 1\n");
+		imat p = read_mtx<int>(TEXT_TEST_FILE);
+		REQUIRE( p(0, 2) == 1 );
+		REQUIRE( p(1, 0) == 1 );
+		REQUIRE( p(1, 1) == 0 );
+	}
+	SECTION("Test invalid files."){
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix coordinate real general\n2 2 3\n1 1 1\n2 2 1\n");
+		REQUIRE( text_test_error([]{ read_mtx<double>(TEXT_TEST_FILE); }).find("expected 3 entries, found 2") != std::string::npos );
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n3 2 1\n");
+		REQUIRE( text_test_error([]{ read_mtx<double>(TEXT_TEST_FILE); }).find(":4: entry out of range") != std::string::npos );
+		text_test_write(TEXT_TEST_FILE, "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1 0.5\n");
+		REQUIRE_THROWS_AS( read_mtx<int>(TEXT_TEST_FILE), const std::invalid_argument& );
+		text_test_write(TEXT_TEST_FILE, "1 2 3\n");
+		REQUIRE_THROWS_AS( read_mtx<double>(TEXT_TEST_FILE), const std::invalid_argument& );
+	}
+	set_text_chunk_size(0);
+	std::remove(TEXT_TEST_FILE);
+}
+
+} /* namespace algebra */
@@ -55,7 +55,42 @@ TEST_CASE( " Test vec constructor." ){
 		log_error(" ");
 
 		INFO("Unit test failed in algebra::vec(size_t n)");  // Only appears on a FAIL
-		REQUIRE_THROWS(vec(MAX_ACCEPTABLE_VECTOR_SIZE + 1));
+		REQUIRE_THROWS(vec(physical_memory()));
+	}
+	SECTION(" Test large vectors and the memory budget."){
+		// Far above the former limit of 16000 elements
+		vec big = ones(5000000);
+		REQUIRE( big.size() == 5000000 );
+		REQUIRE( sum(big) == 5000000 );
+		REQUIRE( memory_in_use() >= big.size()*sizeof(double) );
+
+		// A budget below what is in use refuses any new buffer
+		mat m(10, 10), m2;
+		set_memory_budget(memory_in_use() + 1024);
+		REQUIRE_THROWS_AS( vec(1000), const std::length_error& );
+		REQUIRE_THROWS_AS( mat(100, 100), const std::length_error& );
+		REQUIRE_THROWS_AS( eval(big*2.0), const std::length_error& );
+		vec small(100);
+		REQUIRE( small.size() == 100 );
+		// The expressions are checked as well, wherever they allocate
+		REQUIRE_THROWS_AS( mat(transpose(m)*2.0), const std::length_error& );
+		REQUIRE_THROWS_AS( m2 = m*2.0, const std::length_error& );
+		REQUIRE_THROWS_AS( m2 = transpose(m), const std::length_error& );
+		REQUIRE_THROWS_AS( m2 = m, const std::length_error& );
+		REQUIRE( m2.size() == 0 );
+		m = transpose(m);
+		REQUIRE( m.size() == 100 );
+		REQUIRE_THROWS_AS( small = big + big, const std::length_error& );
+		REQUIRE_THROWS_AS( small = big, const std::length_error& );
+		REQUIRE( small.size() == 100 );
+		small = small*2.0;
+		REQUIRE( small.size() == 100 );
+		set_memory_budget(0);
+		REQUIRE( get_memory_budget() == physical_memory() );
+
+		// The size in Bytes of the request must not overflow
+		REQUIRE_THROWS_AS( vec(MAX(size_t)/2), const std::length_error& );
+		REQUIRE_THROWS_AS( mat(MAX(size_t)/2, 4), const std::length_error& );
 	}
 	SECTION(" Test user-defined constructor."){
 		vec v(2);
@@ -132,7 +167,7 @@ TEST_CASE( " Test 'vec::resize(size_t size)' ." ) {
 		REQUIRE(v.size() == 5);
 	}
 	SECTION(" Test for boundary conditions."){
-		REQUIRE_THROWS(v.set_size(MAX_ACCEPTABLE_VECTOR_SIZE + 1));
+		REQUIRE_THROWS(v.set_size(physical_memory()));
 		REQUIRE_THROWS(v.set_size(-1));
 	}
 }
@@ -395,6 +430,37 @@ TEST_CASE( " Test vec::overload=(const char* a) function" ){
 		// It should throw exception if a letter occurs
 		REQUIRE_THROWS(a = "[2 3.9 -1k]");
 	}
+	SECTION(" Test separators, exponents and errors. "){
+		a = "  [ 1,  -2.5\t3e2 ,4E-1 ]  ";
+		REQUIRE(a.size() == 4);
+		REQUIRE(a.get(1) == Approx(-2.5));
+		REQUIRE(a.get(2) == Approx(300));
+		REQUIRE(a.get(3) == Approx(0.4));
+		a = "1 2 3";
+		REQUIRE(a.size() == 3);
+		// An invalid input leaves the vector unchanged.
+		REQUIRE_THROWS_AS(a = "[1 2 3", const std::invalid_argument&);
+		REQUIRE_THROWS_AS(a = "[1 2;3 4]", const std::invalid_argument&);
+		REQUIRE_THROWS_AS(a = "[1 --2]", const std::invalid_argument&);
+		REQUIRE_THROWS_AS(a = "[1 e5]", const std::invalid_argument&);
+		REQUIRE(a.size() == 3);
+		try {
+			a = "[1 2 3 4x]";
+			FAIL("no exception was thrown");
+		}
+		catch (const std::invalid_argument& e) {
+			REQUIRE(std::string(e.what()).find("'x' at position 8") != std::string::npos);
+		}
+		// A long input is parsed in one pass.
+		std::string text;
+		for (size_t i = 0; i < 100000; i++)
+		{
+			text += std::to_string(i % 10) + " ";
+		}
+		a = text.c_str();
+		REQUIRE(a.size() == 100000);
+		REQUIRE(a.get(99999) == 9);
+	}
 }
 
 TEST_CASE( " Test vec::overload+(const vec& a) function" ){
@@ -421,6 +487,19 @@ TEST_CASE( " Test vec::overload+(const vec& a) function" ){
 		REQUIRE(v3.get(0).real() == 9); REQUIRE(v3.get(0).imag() == 1);
 		REQUIRE(v3.get(1).real() == 0); REQUIRE(v3.get(1).imag() == -3);
 	}
+	SECTION(" Test chained expressions. "){
+		// c = (a + b - a*2)/2 = [0.5 4 -0.5], evaluated in one pass
+		a = "[3 -5 9]", b = "[4 3 8]";
+		vec c = (a + b - a*2.0)/2.0;
+		REQUIRE(c.get(0) == 0.5);
+		REQUIRE(c.get(1) == 4);
+		REQUIRE(c.get(2) == -0.5);
+		// the left-hand side may appear on the right-hand side
+		a = a + b + a;
+		REQUIRE(a.get(0) == 10);
+		REQUIRE(a.get(1) == -7);
+		REQUIRE(a.get(2) == 26);
+	}
 	SECTION(" Test boundary conditions. "){
 		REQUIRE((a + b).size() == 0);
 		// a = [3 -5 9], b = [4 3]
@@ -633,6 +712,47 @@ TEST_CASE( " Test vec::overload/(double t) function" ){
 }
 
 
+TEST_CASE( " Test vec::overload+=, -=, *=, /= functions" ){
+	vec a, b;
+	SECTION(" Test normal conditions. "){
+		// a = [3 -5 9], b = [4 3 8]
+		a = "[3 -5 9]", b = "[4 3 8]";
+		const double* buffer = &a[0];
+		a += b;
+		REQUIRE(a.get(0) == 7); REQUIRE(a.get(1) == -2); REQUIRE(a.get(2) == 17);
+		a -= b*2.0;
+		REQUIRE(a.get(0) == -1); REQUIRE(a.get(1) == -8); REQUIRE(a.get(2) == 1);
+		a += 1.0; a *= 2.0; a -= 4.0; a /= 2.0;
+		REQUIRE(a.get(0) == -2); REQUIRE(a.get(1) == -9); REQUIRE(a.get(2) == 0);
+		REQUIRE(&a[0] == buffer);
+	}
+	SECTION(" Test boundary conditions. "){
+		REQUIRE_THROWS(a += 1.0);
+		a = "[3 -5 9]", b = "[4 3]";
+		REQUIRE_THROWS(a += b);
+		REQUIRE_THROWS(a -= b);
+		REQUIRE_THROWS(a /= 0.0);
+	}
+}
+
+TEST_CASE( " Test vec move semantics" ){
+	SECTION(" Test normal conditions. "){
+		vec a; a = "[1 2 3]";
+		const double* buffer = &a[0];
+		vec b = std::move(a);
+		REQUIRE(&b[0] == buffer);
+		REQUIRE(b.size() == 3);
+		REQUIRE(a.size() == 0);
+		a = std::move(b);
+		REQUIRE(&a[0] == buffer);
+		REQUIRE(b.size() == 0);
+		// a temporary operand lends its buffer to the result
+		vec c = std::move(a) + 1.0;
+		REQUIRE(&c[0] == buffer);
+		REQUIRE(c.get(0) == 2); REQUIRE(c.get(1) == 3); REQUIRE(c.get(2) == 4);
+	}
+}
+
 TEST_CASE( " Test vec::overload()(const size_t) function" ){
 	vec a;
 	double p;
@@ -698,7 +818,7 @@ TEST_CASE( " Test algebra::zeros(size_t n) function" ){
 		REQUIRE(a[1] == 0);
 	}
 	SECTION(" Test boundary conditions. "){
-		REQUIRE_THROWS(zeros(MAX_ACCEPTABLE_VECTOR_SIZE + 1));
+		REQUIRE_THROWS(zeros(physical_memory()));
 		REQUIRE_THROWS(zeros(-1));
 	}
 }
@@ -711,7 +831,7 @@ TEST_CASE( " Test algebra::ones(size_t n) function" ){
 		REQUIRE(a[1] == 1);
 	}
 	SECTION(" Test boundary conditions. "){
-		REQUIRE_THROWS(ones(MAX_ACCEPTABLE_VECTOR_SIZE + 1));
+		REQUIRE_THROWS(ones(physical_memory()));
 		REQUIRE_THROWS(ones(-1));
 	}
 }
@@ -1022,8 +1142,11 @@ TEST_CASE( " Test algebra::concat(const Vec<T>& v1, T t) function" ){
 		a = concat(a,t); // From null vector to vector of size 1
 		REQUIRE(a.size() == 1);
 		REQUIRE(a(0) == t);
-		a.set_size(MAX_ACCEPTABLE_VECTOR_SIZE);
+		// No room in the memory budget for one more element
+		a.set_size(1000);
+		set_memory_budget(memory_in_use() + 1000*sizeof(double));
 		REQUIRE_THROWS( a = concat(a,t) );
+		set_memory_budget(0);
 	}
 }
 
@@ -1056,8 +1179,11 @@ TEST_CASE( " Test algebra::concat(double t, const vec& v) function" ){
 		a = concat(t, a);
 		REQUIRE(a.size() == 1);
 		REQUIRE(a(0) == t);
-		a.set_size(MAX_ACCEPTABLE_VECTOR_SIZE);
+		// No room in the memory budget for one more element
+		a.set_size(1000);
+		set_memory_budget(memory_in_use() + 1000*sizeof(double));
 		REQUIRE_THROWS( a = concat(t, a) );
+		set_memory_budget(0);
 	}
 }
 
@@ -1094,9 +1220,11 @@ TEST_CASE( " Test algebra::concat(const vec& v1, const vec& v2) function" ){
 	SECTION(" Test boundary conditions. "){
 		c = concat(a,b);
 		REQUIRE(a.size() == 0);
-		a.set_size(floor(MAX_ACCEPTABLE_VECTOR_SIZE/2.0) + 2);
-		b.set_size(floor(MAX_ACCEPTABLE_VECTOR_SIZE/2.0) + 2);
+		a.set_size(1000);
+		b.set_size(1000);
+		set_memory_budget(memory_in_use() + 1500*sizeof(double));
 		REQUIRE_THROWS( c = concat(a, b) );
+		set_memory_budget(0);
 	}
 }
 
@@ -1116,7 +1244,7 @@ TEST_CASE( " Test algebra::linspace(T from, T to, size_t step) function" ){
 	SECTION(" Test boundary conditions. "){
 		REQUIRE_THROWS(linspace(3, 2, 1));
 		REQUIRE_THROWS(linspace(-5, -10, 1));
-		REQUIRE_THROWS(linspace(1, MAX_ACCEPTABLE_VECTOR_SIZE + 10, 1));
+		REQUIRE_THROWS(linspace(0.0, 1e18, 1));
 	}
 }
 
@@ -1231,6 +1359,45 @@ TEST_CASE(" Test algebra::conj(const cvec& v) function" ){
 	REQUIRE( a2(1).real() == a(1).real() ); REQUIRE( a2(1).imag() == -a(1).imag() );
 }
 
+TEST_CASE( " Test 'vec::view(size_t i, size_t j)' " ){
+	vec a, b;
+	SECTION(" Test normal conditions. "){
+		// a = [1 2 3 4 5], a.view(1, 3) = [2 3 4]
+		a = "[1 2 3 4 5]";
+		b = a.view(1, 3);
+		REQUIRE( b.size() == 3 );
+		REQUIRE( b(0) == 2 ); REQUIRE( b(1) == 3 ); REQUIRE( b(2) == 4 );
+		REQUIRE( a.view(0, 1)*a.view(3, 4) == 1*4 + 2*5 );
+		b = a.view(0, 2) + a.view(2, 4);
+		REQUIRE( b(0) == 4 ); REQUIRE( b(1) == 6 ); REQUIRE( b(2) == 8 );
+
+		// Writing through the view writes the vector
+		a.view(3, 4) = 0.0;
+		REQUIRE( a(2) == 3 ); REQUIRE( a(3) == 0 ); REQUIRE( a(4) == 0 );
+		a.view(0, 1) += b.view(1, 2);
+		REQUIRE( a(0) == 7 ); REQUIRE( a(1) == 10 );
+
+		// Overlapping source and destination
+		a = "[1 2 3 4 5]";
+		a.view(1, 4) = a.view(0, 3);
+		REQUIRE( a(0) == 1 ); REQUIRE( a(1) == 1 ); REQUIRE( a(2) == 2 ); REQUIRE( a(4) == 4 );
+		a = "[1 2 3 4 5]";
+		a = a.view(2, 4);
+		REQUIRE( a.size() == 3 ); REQUIRE( a(0) == 3 ); REQUIRE( a(2) == 5 );
+		a = "[1 2 3 4 5]";
+		a += a.view(0, 4)*2.0;
+		REQUIRE( a(0) == 3 ); REQUIRE( a(4) == 15 );
+	}
+	SECTION(" Test boundary conditions. "){
+		REQUIRE_THROWS( a.view(0, 0) ); // NULL VECTOR
+		a = "[1 2 3]";
+		REQUIRE_THROWS( a.view(0, 3) );
+		REQUIRE_THROWS( a.view(2, 1) ); // j < i
+		REQUIRE_THROWS( a.view(0, 1)(2) );
+		REQUIRE_THROWS( a.view(0, 1) = a.view(0, 2) ); // dimension mismatch
+	}
+}
+
 TEST_CASE( " Test algebra::abs(const vec& v) function" ){
 	vec a, b;
 	SECTION(" Test normal conditions. "){